@@ -0,0 +1,326 @@
+/*****************************************************************************
+* File Name: ProfileBackend.c
+*
+* Version 1.0
+*
+* Description: Startup selection of the stdout backend. While the burst
+* is sent the CPU spins in an idle loop until the UART is idle; every spin
+* stands for the cycles of one calibrated loop iteration that the
+* application would have had. The cycles of the burst not covered by spins
+* are its cost: the blocking writes of polling, the UART ISR of interrupt
+* mode, the ring copy and DataWire ISR of the DMA backend.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileBackend.h"
+#include "ProfileSession.h"
+#include "ProfileCycles.h"
+#include "my_stdio_user.h"
+#include "my_stdout_ring.h"
+
+/* Bits of one character, 8N1 */
+#define PROFILE_BACKEND_CHAR_BITS       (10u)
+
+static bool ProfileBackend_Busy(void);
+static uint32_t ProfileBackend_Spin(uint32_t spins, bool untilIdle);
+
+static const char * const backendName[PROFILE_BACKEND_NR] = { "Polling", "Interrupt", "DMA" };
+
+/* Burst, printed with every backend */
+static const char backendBurst[PROFILE_BACKEND_BURST_MAX + 1u] =
+    "0123456789012345678901234567890123456789012345678901234567890123";
+
+/* Counters of a burst */
+static const profile_monitor_t backendMonitors[] =
+{
+    { "SCB5 (UART)", SCB5_MONITOR_AHB,      CY_PROFILE_EVENT, CY_PROFILE_CLK_HF, 1u },
+    { "DataWire 1",  CPUSS_MONITOR_DW1_AHB, CY_PROFILE_EVENT, CY_PROFILE_CLK_HF, 1u }
+};
+#define PROFILE_BACKEND_MONITORS        (sizeof(backendMonitors) / sizeof(backendMonitors[0]))
+
+static profile_backend_result_t backendResults[PROFILE_BACKEND_NR];
+static profile_backend_t backendSelected = PROFILE_BACKEND_POLLING;
+static uint32_t backendBurstSize;
+static uint32_t backendSpinCycles;      /* Cycles of one idle loop iteration, 1/16 */
+static uint32_t backendTimeout;         /* Longest burst, one second of cycles */
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Select
+********************************************************************************
+*
+*  Measures every backend of the available mask (PROFILE_BACKEND_MASK bits)
+*  with a burst of burstSize characters and selects the one with the fewest
+*  busy cycles. The DMA backend needs StdoutRing_Init() before.
+*  Needs the profile counters of a session and ProfileCycles_Init().
+*  Returns the selected backend, polling when nothing could be measured
+*******************************************************************************/
+profile_backend_t ProfileBackend_Select(uint32_t available, uint32_t burstSize)
+{
+    profile_session_t session;
+    profile_result_t results[PROFILE_BACKEND_MONITORS];
+    uint64_t weightedSum;
+    uint32_t backend;
+    uint32_t run;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t spins;
+    uint32_t idle;
+    bool found = false;
+
+    backendBurstSize = (burstSize < PROFILE_BACKEND_BURST_MAX) ? burstSize : PROFILE_BACKEND_BURST_MAX;
+    backendTimeout = cy_Hfclk0FreqHz;
+    for (backend = 0u; backend < PROFILE_BACKEND_NR; backend++)
+    {
+        backendResults[backend].measured = false;
+    }
+
+    /* Cost of one idle spin, the fastest of a few runs */
+    ProfileBackend_Set(PROFILE_BACKEND_POLLING);
+    (void) ProfileBackend_Spin(UINT32_MAX, true);
+    backendSpinCycles = UINT32_MAX;
+    for (run = 0u; run < 4u; run++)
+    {
+        start = ProfileCycles_Read();
+        (void) ProfileBackend_Spin(PROFILE_BACKEND_CALIBRATION, false);
+        cycles = (ProfileCycles_Elapsed(start) * 16u) / PROFILE_BACKEND_CALIBRATION;
+        if (cycles < backendSpinCycles)
+        {
+            backendSpinCycles = cycles;
+        }
+    }
+
+    if (PROFILE_SESSION_SUCCESS != ProfileSession_Open(&session, backendMonitors, PROFILE_BACKEND_MONITORS))
+    {
+        return backendSelected;
+    }
+    for (backend = 0u; backend < PROFILE_BACKEND_NR; backend++)
+    {
+        if (0u == (available & PROFILE_BACKEND_MASK(backend)))
+        {
+            continue;
+        }
+
+        /* The label leaves the UART before the burst starts */
+        printf ("    %-9s ", backendName[backend]);
+        (void) ProfileBackend_Spin(UINT32_MAX, true);
+        ProfileBackend_Set((profile_backend_t) backend);
+
+        ProfileSession_Start(&session);
+        printf ("%.*s", (int) backendBurstSize, backendBurst);
+        spins = ProfileBackend_Spin(UINT32_MAX, true);
+        ProfileSession_Stop(&session);
+
+        (void) ProfileSession_GetResults(&session, results, &weightedSum);
+        idle = (uint32_t)(((uint64_t) spins * backendSpinCycles) / 16u);
+        backendResults[backend].measured = true;
+        backendResults[backend].wallCycles = ProfileSession_GetCycles(&session);
+        backendResults[backend].busyCycles = (backendResults[backend].wallCycles > idle) ?
+                                             (backendResults[backend].wallCycles - idle) : 0u;
+        backendResults[backend].scbEvents = results[0].rawCount;
+        backendResults[backend].dmaEvents = results[1].rawCount;
+
+        ProfileBackend_Set(PROFILE_BACKEND_POLLING);
+        printf ("\n\r");
+
+        if ((!found) || (backendResults[backend].busyCycles < backendResults[backendSelected].busyCycles))
+        {
+            backendSelected = (profile_backend_t) backend;
+            found = true;
+        }
+    }
+    ProfileSession_Close(&session);
+
+    ProfileBackend_Set(backendSelected);
+    return backendSelected;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Set
+********************************************************************************
+*
+*  Switches stdout to a backend. Leaving the DMA backend waits until the
+*  ring is sent.
+*******************************************************************************/
+void ProfileBackend_Set(profile_backend_t backend)
+{
+    if ((true == UartUsesDma) && (PROFILE_BACKEND_DMA != backend))
+    {
+        StdoutRing_Flush();
+    }
+    UartUsesIRQ = (PROFILE_BACKEND_IRQ == backend);
+    UartUsesDma = (PROFILE_BACKEND_DMA == backend);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Get
+********************************************************************************
+*
+*  Returns the backend selected by ProfileBackend_Select
+*******************************************************************************/
+profile_backend_t ProfileBackend_Get(void)
+{
+    return backendSelected;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Drain
+********************************************************************************
+*
+*  Waits until every backend has sent its data and the UART is idle. Runs
+*  before a measurement starts, so that it does not count the output of
+*  earlier printf calls.
+*******************************************************************************/
+void ProfileBackend_Drain(void)
+{
+    while (ProfileBackend_Busy())
+    {
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_GetResult
+********************************************************************************
+*
+*  Returns the measurement of a backend, measured is false when it was not
+*  available
+*******************************************************************************/
+const profile_backend_result_t * ProfileBackend_GetResult(profile_backend_t backend)
+{
+    return &backendResults[backend];
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_GetBaud
+********************************************************************************
+*
+*  Returns the baud rate seen by the selected backend, 0 before a selection
+*******************************************************************************/
+uint32_t ProfileBackend_GetBaud(void)
+{
+    const profile_backend_result_t *result = &backendResults[backendSelected];
+
+    if ((!result->measured) || (0u == result->wallCycles))
+    {
+        return 0u;
+    }
+    return (uint32_t)(((uint64_t) backendBurstSize * PROFILE_BACKEND_CHAR_BITS * cy_Hfclk0FreqHz) /
+                      result->wallCycles);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Print
+********************************************************************************
+*
+*  Prints the measurement of every backend and the selection
+*******************************************************************************/
+void ProfileBackend_Print(void)
+{
+    uint32_t backend;
+    const profile_backend_result_t *result;
+
+    printf ("    %-9s %12s %12s %12s %12s %12s\n\r", "Backend", "Burst us", "CPU cycles",
+            "Cycles/char", "SCB5 events", "DW1 events");
+    for (backend = 0u; backend < PROFILE_BACKEND_NR; backend++)
+    {
+        result = &backendResults[backend];
+        if (!result->measured)
+        {
+            printf ("    %-9s %12s\n\r", backendName[backend], "n/a");
+            continue;
+        }
+        printf ("    %-9s %12lu %12lu %12lu %12lu %12lu\n\r", backendName[backend],
+                (unsigned long)(result->wallCycles / (cy_Hfclk0FreqHz / 1000000ul)),
+                (unsigned long)result->busyCycles, (unsigned long)(result->busyCycles / backendBurstSize),
+                (unsigned long)result->scbEvents, (unsigned long)result->dmaEvents);
+    }
+    printf ("    Selected: %s, %lu MHz CPU, ~%lu baud\n\r", backendName[backendSelected],
+            (unsigned long)(cy_Hfclk0FreqHz / 1000000ul), (unsigned long)ProfileBackend_GetBaud());
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Busy
+********************************************************************************
+*
+*  Returns true while any backend still has data to send. All three
+*  conditions are read on every call, so that a spin costs the same during
+*  the calibration and the measurement.
+*******************************************************************************/
+static bool ProfileBackend_Busy(void)
+{
+    bool ringBusy = (false == StdoutRing_IsEmpty());
+    bool transmitBusy = (0u != (UART_GetTransmitStatus() & CY_SCB_UART_TRANSMIT_ACTIVE));
+    bool fifoBusy = (false == Cy_SCB_UART_IsTxComplete(UART_HW));
+
+    return (ringBusy | transmitBusy | fifoBusy);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBackend_Spin
+********************************************************************************
+*
+*  The idle loop. Runs spins iterations, or less when untilIdle and the
+*  UART gets idle, or when a burst takes longer than a second.
+*  Returns the iterations run
+*******************************************************************************/
+static uint32_t ProfileBackend_Spin(uint32_t spins, bool untilIdle)
+{
+    uint32_t start = ProfileCycles_Read();
+    uint32_t count;
+    bool busy;
+
+    for (count = 0u; count < spins; count++)
+    {
+        busy = ProfileBackend_Busy();
+        if (((true == untilIdle) && (false == busy)) || (ProfileCycles_Elapsed(start) > backendTimeout))
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*****************************************************************************
+* File Name: ProfileBackend.h
+*
+* Version 1.0
+*
+* Description: Definitions of the startup selection of the stdout backend.
+* ProfileBackend_Select() prints the same short burst with every available
+* backend (polling, UART interrupt, DMA ring), times it with the cycle
+* counter and profiles the SCB5 and DataWire 1 bus events, then keeps the
+* backend that leaves the most CPU cycles to the application at the baud
+* rate and clock of this build. The measurements stay readable afterwards.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEBACKEND_H
+#define PROFILEBACKEND_H
+
+#include <project.h>
+
+/* Longest burst, in characters */
+#define PROFILE_BACKEND_BURST_MAX       (64u)
+
+/* Spins of the idle loop calibration */
+#define PROFILE_BACKEND_CALIBRATION     (64u)
+
+/* Stdout backends, as selected by UartUsesIRQ and UartUsesDma */
+typedef enum
+{
+    PROFILE_BACKEND_POLLING = 0u,
+    PROFILE_BACKEND_IRQ     = 1u,
+    PROFILE_BACKEND_DMA     = 2u,
+    PROFILE_BACKEND_NR      = 3u
+} profile_backend_t;
+
+/* Bit of a backend in the available mask of ProfileBackend_Select */
+#define PROFILE_BACKEND_MASK(backend)   (1uL << (uint32_t)(backend))
+
+/* Measurement of one backend */
+typedef struct
+{
+    bool measured;
+    uint32_t wallCycles;    /* From the first byte written until the UART is idle */
+    uint32_t busyCycles;    /* Cycles of wallCycles not left to the application */
+    uint64_t scbEvents;     /* SCB5 bus events */
+    uint64_t dmaEvents;     /* DataWire 1 bus events */
+} profile_backend_result_t;
+
+profile_backend_t ProfileBackend_Select(uint32_t available, uint32_t burstSize);
+void ProfileBackend_Set(profile_backend_t backend);
+profile_backend_t ProfileBackend_Get(void);
+void ProfileBackend_Drain(void);
+const profile_backend_result_t * ProfileBackend_GetResult(profile_backend_t backend);
+uint32_t ProfileBackend_GetBaud(void);
+void ProfileBackend_Print(void);
+
+#endif /* PROFILEBACKEND_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,309 @@
+/*****************************************************************************
+* File Name: ProfileBaseline.c
+*
+* Version 1.0
+*
+* Description: Performance baselines with regression comparison.
+* The row holds a header (magic, record count, CRC-16 of the records) and
+* up to PROFILE_BASELINE_MAX records. A row with a bad magic or CRC, e.g.
+* erased, loads as empty. Checks are kept in RAM; the row is only written
+* by ProfileBaseline_Commit(), once per run, when new records were added or
+* a rebaseline was requested, to spare the flash.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "ProfileBaseline.h"
+#include "ProfileSample.h"
+
+#define PROFILE_BASELINE_MAGIC      (0x314C4250ul)  /* "PBL1" */
+
+/* Layout of the row */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t count;
+    uint32_t crc;
+    uint32_t reserved;
+    profile_baseline_record_t records[PROFILE_BASELINE_MAX];
+} profile_baseline_row_t;
+
+/* Check of one benchmark in this run */
+typedef struct
+{
+    uint32_t record;                /* Index of the record */
+    uint64_t value;
+    uint64_t baseline;
+    profile_baseline_verdict_t verdict;
+} profile_baseline_check_t;
+
+typedef union
+{
+    profile_baseline_row_t row;
+    uint32_t words[PROFILE_BASELINE_ROW_WORDS];
+} profile_baseline_image_t;
+
+static const profile_baseline_port_t *baselinePort;
+static profile_baseline_image_t baselineImage;
+static profile_baseline_check_t baselineChecks[PROFILE_BASELINE_MAX];
+static uint32_t baselineCheckCount;
+static profile_baseline_summary_t baselineSummary;
+static bool baselineDirty;
+
+static uint32_t ProfileBaseline_Crc(void);
+static uint32_t ProfileBaseline_Find(const char *name);
+
+/**
+********************************************************************************
+* Function Name: ProfileBaseline_Load
+********************************************************************************
+*
+*  Reads the records from the store and clears the checks of the run
+*  Returns false when the row holds no valid records, the run then starts
+*  with an empty baseline
+*******************************************************************************/
+bool ProfileBaseline_Load(const profile_baseline_port_t *port)
+{
+    bool valid;
+
+    baselinePort = port;
+    baselinePort->readRow(baselineImage.words);
+    valid = (PROFILE_BASELINE_MAGIC == baselineImage.row.magic) &&
+            (baselineImage.row.count <= PROFILE_BASELINE_MAX) &&
+            (ProfileBaseline_Crc() == baselineImage.row.crc);
+    if (!valid)
+    {
+        (void) memset(&baselineImage, 0, sizeof(baselineImage));
+        baselineImage.row.magic = PROFILE_BASELINE_MAGIC;
+    }
+    baselineCheckCount = 0u;
+    (void) memset(&baselineSummary, 0, sizeof(baselineSummary));
+    baselineDirty = false;
+    return valid;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaseline_Check
+********************************************************************************
+*
+*  Compares the value of a benchmark with its record
+*  tolerancePercent is the deviation allowed in either direction. Lower
+*  values are better: counts, cycles or energy
+*  A benchmark without record gets one, stored by ProfileBaseline_Commit()
+*******************************************************************************/
+profile_baseline_verdict_t ProfileBaseline_Check(const char *name, uint64_t value, uint32_t tolerancePercent)
+{
+    uint32_t index = ProfileBaseline_Find(name);
+    uint64_t baseline = value;
+    uint64_t margin;
+    profile_baseline_verdict_t verdict;
+    profile_baseline_record_t *record;
+
+    if (index < baselineImage.row.count)
+    {
+        baseline = baselineImage.row.records[index].value;
+        margin = (baseline * tolerancePercent) / 100u;
+        if (value > (baseline + margin))
+        {
+            verdict = PROFILE_BASELINE_REGRESSED;
+        }
+        else if ((value + margin) < baseline)
+        {
+            verdict = PROFILE_BASELINE_IMPROVED;
+        }
+        else
+        {
+            verdict = PROFILE_BASELINE_PASS;
+        }
+    }
+    else if (baselineImage.row.count < PROFILE_BASELINE_MAX)
+    {
+        index = baselineImage.row.count++;
+        record = &baselineImage.row.records[index];
+        (void) memset(record->name, 0, PROFILE_BASELINE_NAME_SIZE);
+        (void) strncpy(record->name, name, PROFILE_BASELINE_NAME_SIZE - 1u);
+        record->value = value;
+        baselineDirty = true;
+        verdict = PROFILE_BASELINE_NEW;
+    }
+    else
+    {
+        verdict = PROFILE_BASELINE_FULL;
+    }
+
+    if (baselineCheckCount < PROFILE_BASELINE_MAX)
+    {
+        baselineChecks[baselineCheckCount].record = index;
+        baselineChecks[baselineCheckCount].value = value;
+        baselineChecks[baselineCheckCount].baseline = baseline;
+        baselineChecks[baselineCheckCount].verdict = verdict;
+        baselineCheckCount++;
+    }
+    baselineSummary.checks++;
+    baselineSummary.count[verdict]++;
+    return verdict;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaseline_Commit
+********************************************************************************
+*
+*  Writes the row when records were added, or with rebaseline set, after
+*  replacing every checked record by the value of this run
+*  Returns 0 when the row is up to date, else the error of the port
+*******************************************************************************/
+int32_t ProfileBaseline_Commit(bool rebaseline)
+{
+    uint32_t index;
+    profile_baseline_check_t *check;
+
+    if (rebaseline)
+    {
+        for (index = 0u; index < baselineCheckCount; index++)
+        {
+            check = &baselineChecks[index];
+            if ((PROFILE_BASELINE_FULL != check->verdict) &&
+                (baselineImage.row.records[check->record].value != check->value))
+            {
+                baselineImage.row.records[check->record].value = check->value;
+                baselineDirty = true;
+            }
+        }
+    }
+    if (!baselineDirty)
+    {
+        return 0;
+    }
+    baselineImage.row.crc = ProfileBaseline_Crc();
+    baselineDirty = false;
+    return baselinePort->writeRow(baselineImage.words);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaseline_GetSummary
+********************************************************************************
+*
+*  Returns the number of checks of the run per verdict
+*******************************************************************************/
+void ProfileBaseline_GetSummary(profile_baseline_summary_t *summary)
+{
+    *summary = baselineSummary;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaseline_Passed
+********************************************************************************
+*
+*  Returns true when no check of the run regressed or found the row full
+*******************************************************************************/
+bool ProfileBaseline_Passed(void)
+{
+    return (0u == baselineSummary.count[PROFILE_BASELINE_REGRESSED]) &&
+           (0u == baselineSummary.count[PROFILE_BASELINE_FULL]);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaseline_Print
+********************************************************************************
+*
+*  Prints every check of the run with its deviation in 1/10 % and the
+*  pass/fail summary on stdout
+*******************************************************************************/
+void ProfileBaseline_Print(void)
+{
+    static const char * const verdictName[PROFILE_BASELINE_FULL + 1u] =
+    {
+        "new", "pass", "improved", "REGRESSED", "FULL"
+    };
+    uint32_t index;
+    int32_t deviation;
+    uint32_t magnitude;
+    char delta[16];
+    const profile_baseline_check_t *check;
+
+    printf ("    %-24s %18s %18s %9s %10s\n\r", "Benchmark", "Baseline", "This run", "Delta %", "Verdict");
+    for (index = 0u; index < baselineCheckCount; index++)
+    {
+        check = &baselineChecks[index];
+        deviation = 0;
+        if (0u != check->baseline)
+        {
+            deviation = (int32_t)((((int64_t)check->value - (int64_t)check->baseline) * 1000) /
+                                  (int64_t)check->baseline);
+        }
+        magnitude = (uint32_t)((deviation < 0) ? -deviation : deviation);
+        (void) snprintf(delta, sizeof(delta), "%c%lu.%01lu", (deviation < 0) ? '-' : '+',
+                        (unsigned long)(magnitude / 10u), (unsigned long)(magnitude % 10u));
+        printf ("    %-24.24s %018lld %018lld %9s %10s\n\r",
+                (PROFILE_BASELINE_FULL == check->verdict) ? "(no room)" : baselineImage.row.records[check->record].name,
+                check->baseline, check->value, delta, verdictName[check->verdict]);
+    }
+    printf ("    Baseline: %lu checks, %lu new, %lu pass, %lu improved, %lu regressed - %s\n\r",
+            baselineSummary.checks, baselineSummary.count[PROFILE_BASELINE_NEW],
+            baselineSummary.count[PROFILE_BASELINE_PASS], baselineSummary.count[PROFILE_BASELINE_IMPROVED],
+            baselineSummary.count[PROFILE_BASELINE_REGRESSED], ProfileBaseline_Passed() ? "PASS" : "FAIL");
+}
+
+/* CRC-16 of the records in use */
+static uint32_t ProfileBaseline_Crc(void)
+{
+    return ProfileSample_Crc((const uint8_t *) baselineImage.row.records,
+                             baselineImage.row.count * (uint32_t)sizeof(profile_baseline_record_t));
+}
+
+/* Index of the record of a name, count of the records when there is none */
+static uint32_t ProfileBaseline_Find(const char *name)
+{
+    uint32_t index;
+
+    for (index = 0u; index < baselineImage.row.count; index++)
+    {
+        if (0 == strncmp(baselineImage.row.records[index].name, name, PROFILE_BASELINE_NAME_SIZE - 1u))
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,108 @@
+/*****************************************************************************
+* File Name: ProfileBaseline.h
+*
+* Version 1.0
+*
+* Description: Definitions of the performance baselines. One
+* record per named benchmark holds the value of a reference run. Every run
+* checks its values against the records with a tolerance: higher than the
+* tolerance allows is a regression, lower is an improvement, an unknown name
+* becomes a new record. All records fit in one row of a store given as a
+* port, a flash row on the device (ProfileBaselinePort.c) or a file on a
+* host (Host/ProfileBaselineFile.c).
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEBASELINE_H
+#define PROFILEBASELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Size of the store, equal to a flash row (CY_FLASH_SIZEOF_ROW) */
+#define PROFILE_BASELINE_ROW_SIZE       (512u)
+#define PROFILE_BASELINE_ROW_WORDS      (PROFILE_BASELINE_ROW_SIZE / 4u)
+
+/* Longest benchmark name, terminating zero included */
+#define PROFILE_BASELINE_NAME_SIZE      (24u)
+
+/* Records in the row, after a 16 byte header */
+#define PROFILE_BASELINE_MAX            (15u)
+
+/* Store of the row */
+typedef struct
+{
+    /* Erases and programs the row, returns 0 on success */
+    int32_t (*writeRow)(const uint32_t data[PROFILE_BASELINE_ROW_WORDS]);
+    /* Copies the row */
+    void (*readRow)(uint32_t data[PROFILE_BASELINE_ROW_WORDS]);
+} profile_baseline_port_t;
+
+/* One benchmark, as stored */
+typedef struct
+{
+    char name[PROFILE_BASELINE_NAME_SIZE];
+    uint64_t value;
+} profile_baseline_record_t;
+
+/* Result of one check */
+typedef enum
+{
+    PROFILE_BASELINE_NEW        = 0u,   /* No record yet, the value becomes the baseline */
+    PROFILE_BASELINE_PASS       = 1u,   /* Within the tolerance */
+    PROFILE_BASELINE_IMPROVED   = 2u,   /* Lower than the tolerance allows */
+    PROFILE_BASELINE_REGRESSED  = 3u,   /* Higher than the tolerance allows */
+    PROFILE_BASELINE_FULL       = 4u    /* No record and no room for one */
+} profile_baseline_verdict_t;
+
+/* Checks of the run so far */
+typedef struct
+{
+    uint32_t checks;
+    uint32_t count[PROFILE_BASELINE_FULL + 1u];     /* Per verdict */
+} profile_baseline_summary_t;
+
+bool ProfileBaseline_Load(const profile_baseline_port_t *port);
+profile_baseline_verdict_t ProfileBaseline_Check(const char *name, uint64_t value, uint32_t tolerancePercent);
+int32_t ProfileBaseline_Commit(bool rebaseline);
+void ProfileBaseline_GetSummary(profile_baseline_summary_t *summary);
+bool ProfileBaseline_Passed(void);
+void ProfileBaseline_Print(void);
+
+#endif /* PROFILEBASELINE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/*****************************************************************************
+* File Name: ProfileBaselinePort.c
+*
+* Version 1.0
+*
+* Description: Flash store of the performance baselines. An
+* erased or never written row reads as zero, ProfileBaseline_Load() then
+* starts with no records.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ProfileBaselinePort.h"
+
+/* Row of the baselines at the start of the emulated EEPROM flash. The
+* region is not part of the image, so the baselines survive a reflash. It
+* is read through a volatile pointer: the compiler must not assume the row
+* keeps the content it had at reset.
+*/
+#define PROFILE_BASELINE_ADDR       (CY_EM_EEPROM_BASE)
+
+#if (PROFILE_BASELINE_ROW_SIZE != CY_FLASH_SIZEOF_ROW)
+    #error "The baselines must take exactly one flash row"
+#endif
+
+static int32_t ProfileBaselinePort_WriteRow(const uint32_t data[PROFILE_BASELINE_ROW_WORDS]);
+static void ProfileBaselinePort_ReadRow(uint32_t data[PROFILE_BASELINE_ROW_WORDS]);
+
+static const profile_baseline_port_t baselinePort =
+{
+    .writeRow = &ProfileBaselinePort_WriteRow,
+    .readRow  = &ProfileBaselinePort_ReadRow
+};
+
+/**
+********************************************************************************
+* Function Name: ProfileBaselinePort_Get
+********************************************************************************
+*
+*  Returns the port to pass to ProfileBaseline_Load
+*******************************************************************************/
+const profile_baseline_port_t * ProfileBaselinePort_Get(void)
+{
+    return &baselinePort;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaselinePort_WriteRow
+********************************************************************************
+*
+*  Erases and programs the row, then invalidates the flash cache so that
+*  the row is read back from the array
+*******************************************************************************/
+static int32_t ProfileBaselinePort_WriteRow(const uint32_t data[PROFILE_BASELINE_ROW_WORDS])
+{
+    cy_en_flashdrv_status_t status;
+
+    status = Cy_Flash_WriteRow(PROFILE_BASELINE_ADDR, data);
+    FLASHC->FLASH_CMD = FLASHC_FLASH_CMD_INV_Msk;
+    return (CY_FLASH_DRV_SUCCESS == status) ? 0 : -1;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaselinePort_ReadRow
+********************************************************************************
+*
+*  Copies the row
+*******************************************************************************/
+static void ProfileBaselinePort_ReadRow(uint32_t data[PROFILE_BASELINE_ROW_WORDS])
+{
+    const volatile uint32_t *rowWords = (const volatile uint32_t *) PROFILE_BASELINE_ADDR;
+    uint32_t index;
+
+    for (index = 0u; index < PROFILE_BASELINE_ROW_WORDS; index++)
+    {
+        data[index] = rowWords[index];
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,319 @@
+/*****************************************************************************
+* File Name: ProfileEnergy.c
+*
+* Version 1.0
+*
+* Description: Energy weight table of the profiler. Coefficients
+* are given by the application or calibrated: a workload runs on one
+* counter while the supply current is measured on the kit, and the energy
+* of the measured current delta over the run is divided by the events. The
+* current then comes from outside, the profiler only counts; a calibration
+* with a delta of 0 just reports the events and the time of the workload.
+* Results are ranked by energy and shown with the average current of each
+* monitor over the session.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileEnergy.h"
+#include "ProfileOverflow.h"
+#include "ProfileCycles.h"
+
+static profile_energy_coeff_t energyTable[PROFILE_ENERGY_TABLE_MAX];
+static uint32_t energyCount;
+static uint32_t energySupplyMv;
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_Init
+********************************************************************************
+*
+*  Loads the coefficients of the table, e.g. from an earlier calibration
+*  supplyMilliVolts is the supply of the measured current
+*******************************************************************************/
+void ProfileEnergy_Init(const profile_energy_coeff_t coeffs[], uint32_t count, uint32_t supplyMilliVolts)
+{
+    uint32_t index;
+
+    energyCount = 0u;
+    energySupplyMv = supplyMilliVolts;
+    for (index = 0u; index < count; index++)
+    {
+        (void) ProfileEnergy_SetWeight(coeffs[index].monitor, coeffs[index].picoJoules);
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_SetWeight
+********************************************************************************
+*
+*  Sets the coefficient of a monitor, adds it to the table if needed
+*  Returns false when the table is full
+*******************************************************************************/
+bool ProfileEnergy_SetWeight(en_ep_mon_sel_t monitor, uint32_t picoJoules)
+{
+    uint32_t index;
+
+    for (index = 0u; index < energyCount; index++)
+    {
+        if (monitor == energyTable[index].monitor)
+        {
+            energyTable[index].picoJoules = picoJoules;
+            return true;
+        }
+    }
+    if (energyCount >= PROFILE_ENERGY_TABLE_MAX)
+    {
+        return false;
+    }
+    energyTable[energyCount].monitor = monitor;
+    energyTable[energyCount].picoJoules = picoJoules;
+    energyCount++;
+    return true;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_GetWeight
+********************************************************************************
+*
+*  Returns the coefficient of a monitor in pJ, 0 when it has none
+*******************************************************************************/
+uint32_t ProfileEnergy_GetWeight(en_ep_mon_sel_t monitor)
+{
+    uint32_t index;
+
+    for (index = 0u; index < energyCount; index++)
+    {
+        if (monitor == energyTable[index].monitor)
+        {
+            return energyTable[index].picoJoules;
+        }
+    }
+    return 0u;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_Weigh
+********************************************************************************
+*
+*  Copies a monitor table and replaces the weights by the coefficients
+*  Sessions opened with the copy return weighted counts in pJ
+*******************************************************************************/
+void ProfileEnergy_Weigh(const profile_monitor_t monitors[], profile_monitor_t weighted[], uint32_t count)
+{
+    uint32_t index;
+
+    for (index = 0u; index < count; index++)
+    {
+        weighted[index] = monitors[index];
+        weighted[index].weight = ProfileEnergy_GetWeight(monitors[index].monitor);
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_Calibrate
+********************************************************************************
+*
+*  Runs workload repeat times while one counter counts the monitor
+*  deltaMicroAmps is the supply current measured during the run minus the
+*  current of the idle device. The coefficient is the energy of this delta
+*  over the run divided by the events, it is stored in the table
+*  The CPU runs the workload of every other monitor, so the energy of its
+*  cycles at the CPUSS_MONITOR_CM4 coefficient is subtracted first; calibrate
+*  the CPU before the other monitors
+*  Needs one free counter. Returns the coefficient in pJ, 0 when the
+*  monitor did not count or no current was given
+*******************************************************************************/
+uint32_t ProfileEnergy_Calibrate(en_ep_mon_sel_t monitor, cy_en_profile_duration_t duration,
+                                 profile_energy_workload_t workload, uint32_t repeat, uint32_t deltaMicroAmps)
+{
+    cy_stc_profile_ctr_ptr_t counter;
+    uint32_t startCycles;
+    uint32_t cycles;
+    uint32_t index;
+    uint64_t events = 0u;
+    uint64_t nanoWatts;
+    uint64_t runPicoJoules;
+    uint64_t cpuPicoJoules = 0u;
+    uint32_t picoJoules = 0u;
+
+    counter = Cy_Profile_ConfigureCounter(monitor, duration, CY_PROFILE_CLK_HF, 1u);
+    if (NULL == counter)
+    {
+        printf ("    Energy calibration - no free counter\n\r");
+        return 0u;
+    }
+    ProfileOverflow_Attach(counter);
+    (void) Cy_Profile_EnableCounter(counter);
+
+    Cy_Profile_ClearCounters();
+    ProfileOverflow_Clear();
+    Cy_Profile_StartProfiling();
+    startCycles = ProfileCycles_Read();
+    for (index = 0u; index < repeat; index++)
+    {
+        workload();
+    }
+    cycles = ProfileCycles_Elapsed(startCycles);
+    Cy_Profile_StopProfiling();
+
+    (void) Cy_Profile_GetRawCount(counter, &events);
+    (void) Cy_Profile_DisableCounter(counter);
+    (void) Cy_Profile_FreeCounter(counter);
+
+    /* uA x mV = nW, and nW x cycles / (HF / 1000) = pJ */
+    nanoWatts = (uint64_t)deltaMicroAmps * energySupplyMv;
+    if ((0u != events) && (0u != nanoWatts))
+    {
+        runPicoJoules = (nanoWatts * cycles) / (cy_Hfclk0FreqHz / 1000u);
+        if (CPUSS_MONITOR_CM4 != monitor)
+        {
+            cpuPicoJoules = (uint64_t)ProfileEnergy_GetWeight(CPUSS_MONITOR_CM4) * cycles;
+        }
+        if (runPicoJoules > cpuPicoJoules)
+        {
+            picoJoules = (uint32_t)((runPicoJoules - cpuPicoJoules) / events);
+        }
+        (void) ProfileEnergy_SetWeight(monitor, picoJoules);
+    }
+    printf ("    Energy calibration - monitor %u: %lld events in %lu cycles, %lu pJ each (%lu pJ of CPU removed)\n\r",
+            (uint32_t)monitor, events, cycles, picoJoules, (uint32_t)cpuPicoJoules);
+    return picoJoules;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_GetCurrent
+********************************************************************************
+*
+*  Returns the average supply current of an energy spent over a number of
+*  HF cycles, in 1/100 uA
+*******************************************************************************/
+uint32_t ProfileEnergy_GetCurrent(uint64_t picoJoules, uint32_t cycles)
+{
+    uint64_t nanoWatts;
+
+    if ((0u == cycles) || (0u == energySupplyMv))
+    {
+        return 0u;
+    }
+    nanoWatts = (picoJoules * (cy_Hfclk0FreqHz / 1000u)) / cycles;
+    return (uint32_t)((nanoWatts * 100u) / energySupplyMv);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_PrintResults
+********************************************************************************
+*
+*  Prints the results of a session opened with weighed monitors, ranked by
+*  energy, with the share of the total and the average current over the
+*  session. Monitors without a coefficient are shown last with n/c
+*******************************************************************************/
+void ProfileEnergy_PrintResults(const profile_result_t results[], uint32_t count, uint32_t cycles)
+{
+    uint32_t order[PROFILE_PRFL_CNT_NR];
+    uint32_t index;
+    uint32_t rank;
+    uint32_t swap;
+    uint32_t share;
+    uint32_t current;
+    uint64_t total = 0u;
+    const profile_result_t *result;
+
+    count = (count < PROFILE_PRFL_CNT_NR) ? count : PROFILE_PRFL_CNT_NR;
+    for (index = 0u; index < count; index++)
+    {
+        order[index] = index;
+        total += results[index].weightedCount;
+    }
+    /* Insertion sort, highest energy first */
+    for (index = 1u; index < count; index++)
+    {
+        for (rank = index; (rank > 0u) &&
+             (results[order[rank]].weightedCount > results[order[rank - 1u]].weightedCount); rank--)
+        {
+            swap = order[rank];
+            order[rank] = order[rank - 1u];
+            order[rank - 1u] = swap;
+        }
+    }
+
+    printf ("    %-16s %16s %8s %14s\n\r", "Monitor", "Energy nJ", "Share %", "Average uA");
+    for (index = 0u; index < count; index++)
+    {
+        result = &results[order[index]];
+        if (0u == ProfileEnergy_GetWeight(result->monitor))
+        {
+            printf ("    %-16s %16s %8s %14s\n\r", result->label, "n/c", "", "");
+            continue;
+        }
+        share = (0u != total) ? (uint32_t)((result->weightedCount * 100u) / total) : 0u;
+        current = ProfileEnergy_GetCurrent(result->weightedCount, cycles);
+        printf ("    %-16s %12lu.%03lu %8lu %11lu.%02lu\n\r", result->label,
+                (uint32_t)(result->weightedCount / 1000u), (uint32_t)(result->weightedCount % 1000u),
+                share, current / 100u, current % 100u);
+    }
+    current = ProfileEnergy_GetCurrent(total, cycles);
+    printf ("    %-16s %12lu.%03lu %8s %11lu.%02lu\n\r", "Total",
+            (uint32_t)(total / 1000u), (uint32_t)(total % 1000u), "", current / 100u, current % 100u);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileEnergy_PrintTable
+********************************************************************************
+*
+*  Prints the table as C initializer, ready to be pasted into the
+*  coefficients given to ProfileEnergy_Init
+*******************************************************************************/
+void ProfileEnergy_PrintTable(void)
+{
+    uint32_t index;
+
+    for (index = 0u; index < energyCount; index++)
+    {
+        printf ("    { (en_ep_mon_sel_t)%u, %luu },\n\r",
+                (uint32_t)energyTable[index].monitor, energyTable[index].picoJoules);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/*****************************************************************************
+* File Name: ProfileEnergy.h
+*
+* Version 1.0
+*
+* Description: Definitions of the energy weight table. It holds one
+* coefficient per monitor: picojoules per event for event monitors and per
+* HF clock cycle for duration monitors. ProfileEnergy_Weigh() puts them
+* into the weights of a monitor table, so the weighted counts of a session
+* are energies in pJ. ProfileEnergy_Calibrate() derives a coefficient from
+* a workload and the supply current measured while it runs.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEENERGY_H
+#define PROFILEENERGY_H
+
+#include <project.h>
+#include "ProfileSession.h"
+
+/* Monitors with a coefficient */
+#define PROFILE_ENERGY_TABLE_MAX    (24u)
+
+/* Energy cost of one monitor */
+typedef struct
+{
+    en_ep_mon_sel_t monitor;
+    uint32_t picoJoules;            /* Per event, or per HF cycle for duration monitors */
+} profile_energy_coeff_t;
+
+/* Workload of a calibration, runs once per repetition */
+typedef void (*profile_energy_workload_t)(void);
+
+void ProfileEnergy_Init(const profile_energy_coeff_t coeffs[], uint32_t count, uint32_t supplyMilliVolts);
+bool ProfileEnergy_SetWeight(en_ep_mon_sel_t monitor, uint32_t picoJoules);
+uint32_t ProfileEnergy_GetWeight(en_ep_mon_sel_t monitor);
+void ProfileEnergy_Weigh(const profile_monitor_t monitors[], profile_monitor_t weighted[], uint32_t count);
+uint32_t ProfileEnergy_Calibrate(en_ep_mon_sel_t monitor, cy_en_profile_duration_t duration,
+                                 profile_energy_workload_t workload, uint32_t repeat, uint32_t deltaMicroAmps);
+uint32_t ProfileEnergy_GetCurrent(uint64_t picoJoules, uint32_t cycles);
+void ProfileEnergy_PrintResults(const profile_result_t results[], uint32_t count, uint32_t cycles);
+void ProfileEnergy_PrintTable(void);
+
+#endif /* PROFILEENERGY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,360 @@
+/*****************************************************************************
+* File Name: ProfileOverflow.c
+*
+* Version 1.0
+*
+* Description: Profile overflow ISR with 64-bit software counters,
+* overflow statistics and per-window budgets. The overflow ISR and the
+* window ISR run at the same priority, so they never preempt each other.
+* Cy_Profile_ClearCounters() clears the hardware counts only, call
+* ProfileOverflow_Clear() with it.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ProfileOverflow.h"
+
+static void ProfileOverflow_Window(void);
+static uint64_t ProfileOverflow_Now(void);
+
+static cy_stc_profile_ctr_ptr_t overflowHandle[PROFILE_PRFL_CNT_NR];
+static volatile uint32_t overflowHigh[PROFILE_PRFL_CNT_NR];   /* Upper 32 bits of each count */
+static profile_overflow_stats_t overflowStats[PROFILE_PRFL_CNT_NR];
+static uint64_t overflowBudget[PROFILE_PRFL_CNT_NR];
+static profile_budget_callback_t overflowCallback[PROFILE_PRFL_CNT_NR];
+static uint64_t overflowWindowStart[PROFILE_PRFL_CNT_NR];
+static volatile uint32_t overflowWindows;
+static uint32_t overflowWindowUs;
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_Init
+********************************************************************************
+*
+*  Starts the time base with a window of windowUs microseconds
+*  Enables the window interrupt at intrPriority, use the same priority for
+*  the profile interrupt that calls ProfileOverflow_ISR
+*  Clears the statistics and the budgets
+*******************************************************************************/
+void ProfileOverflow_Init(uint32_t windowUs, uint32_t intrPriority)
+{
+    uint32_t index;
+
+    const cy_stc_tcpwm_counter_config_t windowConfig =
+    {
+        .period             = windowUs - 1uL,
+        .clockPrescaler     = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode            = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection     = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture   = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0           = 0uL,
+        .compare1           = 0uL,
+        .enableCompareSwap  = false,
+        .interruptSources   = CY_TCPWM_INT_ON_TC,
+        .captureInputMode   = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput       = CY_TCPWM_INPUT_0,
+        .reloadInputMode    = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput        = CY_TCPWM_INPUT_0,
+        .startInputMode     = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput         = CY_TCPWM_INPUT_0,
+        .stopInputMode      = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput          = CY_TCPWM_INPUT_0,
+        .countInputMode     = CY_TCPWM_INPUT_LEVEL,
+        .countInput         = CY_TCPWM_INPUT_1,
+    };
+
+    const cy_stc_sysint_t windowIntrConfig =
+    {
+        .intrSrc      = PROFILE_OVERFLOW_INTR_SRC,
+        .intrPriority = intrPriority
+    };
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        overflowHandle[index] = NULL;
+        overflowBudget[index] = 0u;
+        overflowCallback[index] = NULL;
+        overflowStats[index].overflows = 0u;
+        overflowStats[index].lastOverflowUs = 0u;
+        overflowStats[index].longestIntervalUs = 0u;
+        overflowStats[index].budgetExceeded = 0u;
+    }
+    overflowWindowUs = windowUs;
+    overflowWindows = 0u;
+    ProfileOverflow_Clear();
+
+    Cy_SysClk_PeriphSetDivider(PROFILE_OVERFLOW_DIV_TYPE, PROFILE_OVERFLOW_DIV_NUM,
+        (cy_PeriClkFreqHz / PROFILE_OVERFLOW_TICK_HZ) - 1uL);
+    Cy_SysClk_PeriphEnableDivider(PROFILE_OVERFLOW_DIV_TYPE, PROFILE_OVERFLOW_DIV_NUM);
+    Cy_SysClk_PeriphAssignDivider(PROFILE_OVERFLOW_CLK_DST, PROFILE_OVERFLOW_DIV_TYPE, PROFILE_OVERFLOW_DIV_NUM);
+
+    (void) Cy_TCPWM_Counter_Init(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_NUM, &windowConfig);
+    Cy_TCPWM_Enable_Multiple(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_MASK);
+
+    (void) Cy_SysInt_Init(&windowIntrConfig, &ProfileOverflow_Window);
+    NVIC_EnableIRQ(windowIntrConfig.intrSrc);
+    Cy_TCPWM_TriggerStart(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_MASK);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_Attach
+********************************************************************************
+*
+*  Lets the ISR count the overflows of a handle of Cy_Profile_ConfigureCounter
+*  Needed for every counter read with Cy_Profile_GetRawCount
+*******************************************************************************/
+void ProfileOverflow_Attach(cy_stc_profile_ctr_ptr_t counter)
+{
+    if (NULL != counter)
+    {
+        overflowHandle[ProfileOverflow_GetIndex(counter)] = counter;
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_GetIndex
+********************************************************************************
+*
+*  Returns the hardware counter number of a handle
+*******************************************************************************/
+uint32_t ProfileOverflow_GetIndex(cy_stc_profile_ctr_ptr_t counter)
+{
+    return (uint32_t)(counter->cntAddr - &PROFILE->CNT_STRUCT[0]);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_SetBudget
+********************************************************************************
+*
+*  Calls callback from the window interrupt for every window in which the
+*  hardware counter counted more than budget
+*  A budget of 0 disables the check
+*******************************************************************************/
+void ProfileOverflow_SetBudget(uint32_t counter, uint64_t budget, profile_budget_callback_t callback)
+{
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+
+    overflowBudget[counter] = budget;
+    overflowCallback[counter] = callback;
+    overflowWindowStart[counter] = ProfileOverflow_GetCount(counter);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_Clear
+********************************************************************************
+*
+*  Clears the upper count bits of all counters, call it together with
+*  Cy_Profile_ClearCounters()
+*  The statistics are kept
+*******************************************************************************/
+void ProfileOverflow_Clear(void)
+{
+    uint32_t index;
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        overflowHigh[index] = 0u;
+        overflowWindowStart[index] = 0u;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_GetCount
+********************************************************************************
+*
+*  Returns the 64-bit count of a hardware counter
+*  An overflow that is still pending is added, so the count never goes back
+*******************************************************************************/
+uint64_t ProfileOverflow_GetCount(uint32_t counter)
+{
+    uint32_t mask = 1uL << counter;
+    uint32_t pending;
+    uint32_t low;
+    uint32_t high;
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+
+    do
+    {
+        pending = PROFILE->INTR & mask;
+        low = PROFILE->CNT_STRUCT[counter].CNT;
+    } while (pending != (PROFILE->INTR & mask));
+    high = overflowHigh[counter] + ((0u != pending) ? 1u : 0u);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    return ((uint64_t)high << 32u) | low;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_GetTimeUs
+********************************************************************************
+*
+*  Returns the microseconds since ProfileOverflow_Init
+*******************************************************************************/
+uint64_t ProfileOverflow_GetTimeUs(void)
+{
+    uint64_t now;
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+
+    now = ProfileOverflow_Now();
+    Cy_SysLib_ExitCriticalSection(interruptState);
+    return now;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_GetStats
+********************************************************************************
+*
+*  Copies the overflow statistics of a hardware counter
+*******************************************************************************/
+void ProfileOverflow_GetStats(uint32_t counter, profile_overflow_stats_t *stats)
+{
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+
+    *stats = overflowStats[counter];
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_ISR
+********************************************************************************
+*
+*  Profile interrupt, replaces Cy_Profile_ISR
+*  Extends the overflowed counters and updates their statistics
+*  Counts the overflow in the attached PDL handle like Cy_Profile_ISR
+*******************************************************************************/
+void ProfileOverflow_ISR(void)
+{
+    uint32_t overflowed = PROFILE->INTR_MASKED;
+    uint32_t index;
+    uint64_t now = ProfileOverflow_Now();
+    uint64_t interval;
+
+    PROFILE->INTR = overflowed;
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        if (0u != (overflowed & (1uL << index)))
+        {
+            overflowHigh[index]++;
+            overflowStats[index].overflows++;
+            /* The first interval would start at the timer start, not at an overflow */
+            interval = now - overflowStats[index].lastOverflowUs;
+            if ((overflowStats[index].overflows > 1u) &&
+                (interval > overflowStats[index].longestIntervalUs))
+            {
+                overflowStats[index].longestIntervalUs = interval;
+            }
+            overflowStats[index].lastOverflowUs = now;
+
+            if ((NULL != overflowHandle[index]) && (0u != overflowHandle[index]->used))
+            {
+                overflowHandle[index]->overflow++;
+            }
+        }
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_Window
+********************************************************************************
+*
+*  Window interrupt, compares the count of every window with its budget
+*******************************************************************************/
+static void ProfileOverflow_Window(void)
+{
+    uint32_t index;
+    uint64_t count;
+    uint64_t delta;
+
+    Cy_TCPWM_ClearInterrupt(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_NUM, CY_TCPWM_INT_ON_TC);
+    overflowWindows++;
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        if (0u != overflowBudget[index])
+        {
+            count = ProfileOverflow_GetCount(index);
+            /* Cleared counters start a new window */
+            delta = (count >= overflowWindowStart[index]) ? (count - overflowWindowStart[index]) : count;
+            overflowWindowStart[index] = count;
+            if (delta > overflowBudget[index])
+            {
+                overflowStats[index].budgetExceeded++;
+                if (NULL != overflowCallback[index])
+                {
+                    overflowCallback[index](index, delta);
+                }
+            }
+        }
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileOverflow_Now
+********************************************************************************
+*
+*  Returns the time base in microseconds, call with interrupts masked
+*  A window end that is still pending is added
+*******************************************************************************/
+static uint64_t ProfileOverflow_Now(void)
+{
+    uint32_t windows;
+    uint32_t ticks;
+    uint32_t pending;
+
+    do
+    {
+        pending = Cy_TCPWM_GetInterruptStatus(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_NUM);
+        ticks = Cy_TCPWM_Counter_GetCounter(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_NUM);
+    } while (pending != Cy_TCPWM_GetInterruptStatus(PROFILE_OVERFLOW_HW, PROFILE_OVERFLOW_CNT_NUM));
+    windows = overflowWindows + ((0u != pending) ? 1u : 0u);
+
+    return ((uint64_t)windows * overflowWindowUs) + ticks;
+}
+
+/* [] END OF FILE */
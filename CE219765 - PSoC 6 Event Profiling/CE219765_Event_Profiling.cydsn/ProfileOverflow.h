@@ -0,0 +1,91 @@
+/*****************************************************************************
+* File Name: ProfileOverflow.h
+*
+* Version 1.0
+*
+* Description: Definitions of the profile overflow ISR. ProfileOverflow_ISR
+* replaces Cy_Profile_ISR. It extends every hardware counter to 64 bits in
+* software, keeps the overflow statistics of each counter and keeps the
+* overflow counts of the attached PDL counter handles up to date, so
+* Cy_Profile_GetRawCount() stays correct. A TCPWM counter provides the time
+* base of the statistics and a window interrupt that compares the counts of
+* every window with the budgets set by ProfileOverflow_SetBudget().
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEOVERFLOW_H
+#define PROFILEOVERFLOW_H
+
+#include <project.h>
+
+/* TCPWM counter of the time base and the budget window, 1 MHz from PERI.
+*  It shares the clock divider of the ProfileSampler timer.
+*/
+#define PROFILE_OVERFLOW_HW             (TCPWM0)
+#define PROFILE_OVERFLOW_CNT_NUM        (6u)
+#define PROFILE_OVERFLOW_CNT_MASK       (1uL << PROFILE_OVERFLOW_CNT_NUM)
+#define PROFILE_OVERFLOW_CLK_DST        ((en_clk_dst_t)((uint32_t)PCLK_TCPWM0_CLOCKS0 + PROFILE_OVERFLOW_CNT_NUM))
+#define PROFILE_OVERFLOW_DIV_TYPE       (CY_SYSCLK_DIV_16_BIT)
+#define PROFILE_OVERFLOW_DIV_NUM        (7u)
+#define PROFILE_OVERFLOW_TICK_HZ        (1000000ul)
+#define PROFILE_OVERFLOW_INTR_SRC       (tcpwm_0_interrupts_6_IRQn)
+
+/* Called in the window interrupt when a counter counted more than its budget */
+typedef void (*profile_budget_callback_t)(uint32_t counter, uint64_t count);
+
+/* Overflow statistics of one hardware counter */
+typedef struct
+{
+    uint32_t overflows;             /* Overflows since ProfileOverflow_Init */
+    uint64_t lastOverflowUs;        /* Time of the last overflow */
+    uint64_t longestIntervalUs;     /* Longest time between two overflows */
+    uint32_t budgetExceeded;        /* Windows over the budget */
+} profile_overflow_stats_t;
+
+void ProfileOverflow_Init(uint32_t windowUs, uint32_t intrPriority);
+void ProfileOverflow_Attach(cy_stc_profile_ctr_ptr_t counter);
+uint32_t ProfileOverflow_GetIndex(cy_stc_profile_ctr_ptr_t counter);
+void ProfileOverflow_SetBudget(uint32_t counter, uint64_t budget, profile_budget_callback_t callback);
+void ProfileOverflow_Clear(void);
+uint64_t ProfileOverflow_GetCount(uint32_t counter);
+uint64_t ProfileOverflow_GetTimeUs(void);
+void ProfileOverflow_GetStats(uint32_t counter, profile_overflow_stats_t *stats);
+void ProfileOverflow_ISR(void);
+
+#endif /* PROFILEOVERFLOW_H */
+
+/* [] END OF FILE */
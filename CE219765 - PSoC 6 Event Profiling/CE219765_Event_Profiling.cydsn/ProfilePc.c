@@ -0,0 +1,306 @@
+/*****************************************************************************
+* File Name: ProfilePc.c
+*
+* Version 1.0
+*
+* Description: Statistical PC-sampling profiler. The sample ISR finds the
+* exception frame of the interrupted code on the main or process stack and
+* counts its stacked PC and LR in an open addressing hash table. The table is
+* cleared by ProfilePc_Start() and filled until ProfilePc_Stop(); pairs that
+* find no free slot within PROFILE_PC_PROBES are counted as dropped.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "ProfilePc.h"
+#include "ProfileTrace.h"
+
+/* Word offsets of the stacked registers in the exception frame */
+#define PROFILE_PC_FRAME_LR     (5u)
+#define PROFILE_PC_FRAME_PC     (6u)
+
+PROFILE_TRACE_EXCLUDE static void ProfilePc_Tick(void);
+PROFILE_TRACE_EXCLUDE static void ProfilePc_Record(uint32_t pc, uint32_t lr);
+
+/* Called by ProfilePc_Tick with the exception frame, external for its branch */
+PROFILE_TRACE_EXCLUDE void ProfilePc_Take(const uint32_t frame[]);
+
+static profile_pc_entry_t *pcTable;
+static uint32_t pcMask;
+static volatile uint32_t pcSamples;
+static volatile uint32_t pcDropped;
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_Init
+********************************************************************************
+*
+*  Attaches the histogram of size slots, size is a power of two
+*  Configures the sample timer for periodUs microseconds and its interrupt
+*  The timer is not started
+*******************************************************************************/
+void ProfilePc_Init(profile_pc_entry_t table[], uint32_t size, uint32_t periodUs)
+{
+    const cy_stc_tcpwm_counter_config_t timerConfig =
+    {
+        .period             = periodUs - 1uL,
+        .clockPrescaler     = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode            = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection     = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture   = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0           = 0uL,
+        .compare1           = 0uL,
+        .enableCompareSwap  = false,
+        .interruptSources   = CY_TCPWM_INT_ON_TC,
+        .captureInputMode   = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput       = CY_TCPWM_INPUT_0,
+        .reloadInputMode    = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput        = CY_TCPWM_INPUT_0,
+        .startInputMode     = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput         = CY_TCPWM_INPUT_0,
+        .stopInputMode      = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput          = CY_TCPWM_INPUT_0,
+        .countInputMode     = CY_TCPWM_INPUT_LEVEL,
+        .countInput         = CY_TCPWM_INPUT_1,
+    };
+
+    const cy_stc_sysint_t timerIntrConfig =
+    {
+        .intrSrc      = PROFILE_PC_INTR_SRC,
+        .intrPriority = PROFILE_PC_INTR_PRIORITY
+    };
+
+    pcTable = table;
+    pcMask = size - 1u;
+    pcSamples = 0u;
+    pcDropped = 0u;
+    (void) memset(table, 0, size * sizeof(profile_pc_entry_t));
+
+    Cy_SysClk_PeriphSetDivider(PROFILE_PC_DIV_TYPE, PROFILE_PC_DIV_NUM,
+        (cy_PeriClkFreqHz / PROFILE_PC_TICK_HZ) - 1uL);
+    Cy_SysClk_PeriphEnableDivider(PROFILE_PC_DIV_TYPE, PROFILE_PC_DIV_NUM);
+    Cy_SysClk_PeriphAssignDivider(PROFILE_PC_CLK_DST, PROFILE_PC_DIV_TYPE, PROFILE_PC_DIV_NUM);
+
+    (void) Cy_TCPWM_Counter_Init(PROFILE_PC_HW, PROFILE_PC_CNT_NUM, &timerConfig);
+    Cy_TCPWM_Enable_Multiple(PROFILE_PC_HW, PROFILE_PC_CNT_MASK);
+
+    (void) Cy_SysInt_Init(&timerIntrConfig, &ProfilePc_Tick);
+    NVIC_EnableIRQ(timerIntrConfig.intrSrc);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_Start
+********************************************************************************
+*
+*  Clears the histogram and starts the sample timer
+*******************************************************************************/
+void ProfilePc_Start(void)
+{
+    (void) memset(pcTable, 0, (pcMask + 1u) * sizeof(profile_pc_entry_t));
+    pcSamples = 0u;
+    pcDropped = 0u;
+
+    Cy_TCPWM_Counter_SetCounter(PROFILE_PC_HW, PROFILE_PC_CNT_NUM, 0uL);
+    Cy_TCPWM_TriggerStart(PROFILE_PC_HW, PROFILE_PC_CNT_MASK);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_Stop
+********************************************************************************
+*
+*  Stops the sample timer, a pending sample is discarded
+*******************************************************************************/
+void ProfilePc_Stop(void)
+{
+    Cy_TCPWM_TriggerStopOrKill(PROFILE_PC_HW, PROFILE_PC_CNT_MASK);
+    if (0u != Cy_TCPWM_GetInterruptStatus(PROFILE_PC_HW, PROFILE_PC_CNT_NUM))
+    {
+        Cy_TCPWM_ClearInterrupt(PROFILE_PC_HW, PROFILE_PC_CNT_NUM, CY_TCPWM_INT_ON_TC);
+        NVIC_ClearPendingIRQ(PROFILE_PC_INTR_SRC);
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_GetSamples
+********************************************************************************
+*
+*  Returns the number of samples taken since ProfilePc_Start, dropped included
+*******************************************************************************/
+uint32_t ProfilePc_GetSamples(void)
+{
+    return pcSamples;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_GetDropped
+********************************************************************************
+*
+*  Returns the number of samples that found no free slot
+*******************************************************************************/
+uint32_t ProfilePc_GetDropped(void)
+{
+    return pcDropped;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_Print
+********************************************************************************
+*
+*  Prints one "PCS <pc> <lr> <count>" line per used slot, hexadecimal
+*  addresses, for Host/ProfileSymbolize. The hottest pair is shown too.
+*******************************************************************************/
+void ProfilePc_Print(void)
+{
+    uint32_t index;
+    uint32_t used = 0u;
+    uint32_t hottest = 0u;
+
+    for (index = 0u; index <= pcMask; index++)
+    {
+        if (0u != pcTable[index].count)
+        {
+            printf ("PCS %08lx %08lx %lu\n\r", (unsigned long)pcTable[index].pc,
+                    (unsigned long)pcTable[index].lr, (unsigned long)pcTable[index].count);
+            if (pcTable[index].count > pcTable[hottest].count)
+            {
+                hottest = index;
+            }
+            used++;
+        }
+    }
+    printf ("    %lu samples, %lu dropped, %lu of %lu slots used\n\r", (unsigned long)pcSamples,
+            (unsigned long)pcDropped, (unsigned long)used, (unsigned long)(pcMask + 1u));
+    if (0u != used)
+    {
+        printf ("    Hottest PC 0x%08lx (LR 0x%08lx): %lu samples\n\r", (unsigned long)pcTable[hottest].pc,
+                (unsigned long)pcTable[hottest].lr, (unsigned long)pcTable[hottest].count);
+    }
+}
+
+#if defined(__GNUC__) && defined(__arm__)
+/**
+********************************************************************************
+* Function Name: ProfilePc_Tick
+********************************************************************************
+*
+*  Sample timer ISR. Bit 2 of EXC_RETURN selects the stack the interrupted
+*  code pushed its frame to; the frame is passed to ProfilePc_Take. A C
+*  prologue would move the stack pointer first, so the handler is naked.
+*  It must not be instrumented, see ProfileTrace.h.
+*******************************************************************************/
+PROFILE_TRACE_EXCLUDE __attribute__((naked)) static void ProfilePc_Tick(void)
+{
+    __asm volatile
+    (
+        "    tst   lr, #4           \n"
+        "    ite   eq               \n"
+        "    mrseq r0, msp          \n"
+        "    mrsne r0, psp          \n"
+        "    b     ProfilePc_Take   \n"
+    );
+}
+#else
+/**
+********************************************************************************
+* Function Name: ProfilePc_Tick
+********************************************************************************
+*
+*  Sample timer ISR of host builds, which have no exception frame. The
+*  return address of the handler stands in for the PC.
+*******************************************************************************/
+PROFILE_TRACE_EXCLUDE static void ProfilePc_Tick(void)
+{
+    uint32_t frame[PROFILE_PC_FRAME_PC + 1u] = { 0u };
+
+    frame[PROFILE_PC_FRAME_PC] = (uint32_t)(uintptr_t)__builtin_return_address(0);
+    ProfilePc_Take(frame);
+}
+#endif /* (__GNUC__) && (__arm__) */
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_Take
+********************************************************************************
+*
+*  Acknowledges the sample timer and records the stacked PC and LR
+*******************************************************************************/
+PROFILE_TRACE_EXCLUDE void ProfilePc_Take(const uint32_t frame[])
+{
+    Cy_TCPWM_ClearInterrupt(PROFILE_PC_HW, PROFILE_PC_CNT_NUM, CY_TCPWM_INT_ON_TC);
+    ProfilePc_Record(frame[PROFILE_PC_FRAME_PC], frame[PROFILE_PC_FRAME_LR]);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfilePc_Record
+********************************************************************************
+*
+*  Counts the pair in its slot, or claims the first free slot of its probe
+*  sequence. Only the sample ISR writes the table.
+*******************************************************************************/
+PROFILE_TRACE_EXCLUDE static void ProfilePc_Record(uint32_t pc, uint32_t lr)
+{
+    uint32_t slot = (((pc ^ (lr << 7)) * 2654435761uL) >> 16) & pcMask;
+    uint32_t probe;
+
+    pcSamples++;
+    for (probe = 0u; probe < PROFILE_PC_PROBES; probe++)
+    {
+        if (0u == pcTable[slot].count)
+        {
+            pcTable[slot].pc = pc;
+            pcTable[slot].lr = lr;
+            pcTable[slot].count = 1u;
+            return;
+        }
+        if ((pc == pcTable[slot].pc) && (lr == pcTable[slot].lr))
+        {
+            pcTable[slot].count++;
+            return;
+        }
+        slot = (slot + 1u) & pcMask;
+    }
+    pcDropped++;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/*****************************************************************************
+* File Name: ProfilePc.h
+*
+* Version 1.0
+*
+* Description: Definitions of the statistical PC-sampling profiler. A TCPWM
+* counter interrupts every periodUs microseconds and its ISR reads the PC and
+* LR stacked by the interrupted code into a RAM histogram of (PC, LR) pairs.
+* ProfilePc_Print() writes the histogram as "PCS" lines; Host/ProfileSymbolize
+* maps them to the functions of the ELF or map file of the build.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEPC_H
+#define PROFILEPC_H
+
+#include <project.h>
+
+/* TCPWM counter of the sample timer, 1 MHz from PERI.
+*  It shares the clock divider of the ProfileSampler timer.
+*  The priority is above every other interrupt of the example so that
+*  their handlers are sampled too.
+*/
+#define PROFILE_PC_HW               (TCPWM0)
+#define PROFILE_PC_CNT_NUM          (5u)
+#define PROFILE_PC_CNT_MASK         (1uL << PROFILE_PC_CNT_NUM)
+#define PROFILE_PC_CLK_DST          ((en_clk_dst_t)((uint32_t)PCLK_TCPWM0_CLOCKS0 + PROFILE_PC_CNT_NUM))
+#define PROFILE_PC_DIV_TYPE         (CY_SYSCLK_DIV_16_BIT)
+#define PROFILE_PC_DIV_NUM          (7u)
+#define PROFILE_PC_TICK_HZ          (1000000ul)
+#define PROFILE_PC_INTR_SRC         (tcpwm_0_interrupts_5_IRQn)
+#define PROFILE_PC_INTR_PRIORITY    (2u)
+
+/* Slots tried before a new (PC, LR) pair is dropped */
+#define PROFILE_PC_PROBES           (8u)
+
+/* One histogram slot, free while count is 0 */
+typedef struct
+{
+    uint32_t pc;        /* Stacked PC, the interrupted instruction */
+    uint32_t lr;        /* Stacked LR, the caller when the PC is in a leaf function */
+    uint32_t count;     /* Samples of this pair */
+} profile_pc_entry_t;
+
+void ProfilePc_Init(profile_pc_entry_t table[], uint32_t size, uint32_t periodUs);
+void ProfilePc_Start(void);
+void ProfilePc_Stop(void);
+uint32_t ProfilePc_GetSamples(void);
+uint32_t ProfilePc_GetDropped(void);
+void ProfilePc_Print(void);
+
+#endif /* PROFILEPC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/*****************************************************************************
+* File Name: ProfileRegion.h
+*
+* Version 1.0
+*
+* Description: Scoped profiling of named code regions.
+*   PROFILE_REGION_BEGIN("AES block");
+*   ...
+*   PROFILE_REGION_END();
+* The pair opens a block, so regions nest like braces. In C++ builds
+* PROFILE_SCOPE("name") does the same with a guard object that ends the
+* region at the end of the enclosing scope. Every region has an entry in a
+* static table with its calls, the min/max/sum of its cycles, the cycles
+* spent outside nested regions, and the sum of the count deltas of the
+* counters set with ProfileRegion_SetCounters(). The counters only count
+* between Cy_Profile_StartProfiling() and Cy_Profile_StopProfiling().
+* Regions are meant for thread mode; an ISR region inside a thread region
+* is counted in both.
+* To use it in another example, copy ProfileRegion.h/.c into the project.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEREGION_H
+#define PROFILEREGION_H
+
+#include <project.h>
+
+/* Entries of the region table */
+#define PROFILE_REGION_MAX          (16u)
+
+/* Profile counters attributed to the regions */
+#define PROFILE_REGION_COUNTERS     (4u)
+
+/* One entry of the region table */
+typedef struct
+{
+    const char *name;
+    uint32_t calls;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t sumCycles;                         /* Including nested regions */
+    uint64_t selfCycles;                        /* Excluding nested regions */
+    uint64_t events[PROFILE_REGION_COUNTERS];   /* Count deltas, including nested regions */
+} profile_region_t;
+
+/* State of one active region, lives on the stack of the caller */
+typedef struct profile_region_scope
+{
+    profile_region_t *region;
+    struct profile_region_scope *parent;
+    uint32_t startCycles;
+    uint32_t childCycles;
+    uint32_t startCount[PROFILE_REGION_COUNTERS];
+} profile_region_scope_t;
+
+#define PROFILE_REGION_BEGIN(name) \
+    { \
+        static profile_region_t *profileRegion_ = NULL; \
+        profile_region_scope_t profileScope_; \
+        ProfileRegion_Enter(&profileRegion_, (name), &profileScope_)
+
+#define PROFILE_REGION_END() \
+        ProfileRegion_Exit(&profileScope_); \
+    }
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void ProfileRegion_Init(void);
+void ProfileRegion_SetCounters(const cy_stc_profile_ctr_ptr_t counters[], uint32_t count);
+void ProfileRegion_Enter(profile_region_t **region, const char *name, profile_region_scope_t *scope);
+void ProfileRegion_Exit(profile_region_scope_t *scope);
+const profile_region_t * ProfileRegion_GetTable(uint32_t *count);
+void ProfileRegion_Reset(void);
+void ProfileRegion_Print(void);
+
+#if defined(__cplusplus)
+}
+
+/* Ends the region when it goes out of scope */
+class ProfileRegionGuard
+{
+public:
+    ProfileRegionGuard(profile_region_t **region, const char *name)
+    {
+        ProfileRegion_Enter(region, name, &scope);
+    }
+    ~ProfileRegionGuard()
+    {
+        ProfileRegion_Exit(&scope);
+    }
+private:
+    ProfileRegionGuard(const ProfileRegionGuard &);
+    ProfileRegionGuard & operator=(const ProfileRegionGuard &);
+    profile_region_scope_t scope;
+};
+
+#define PROFILE_REGION_CONCAT_(a, b)    a##b
+#define PROFILE_REGION_CONCAT(a, b)     PROFILE_REGION_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) \
+    static profile_region_t *PROFILE_REGION_CONCAT(profileRegion_, __LINE__) = NULL; \
+    ProfileRegionGuard PROFILE_REGION_CONCAT(profileGuard_, __LINE__)(&PROFILE_REGION_CONCAT(profileRegion_, __LINE__), (name))
+#endif /* (__cplusplus) */
+
+#endif /* PROFILEREGION_H */
+
+/* [] END OF FILE */
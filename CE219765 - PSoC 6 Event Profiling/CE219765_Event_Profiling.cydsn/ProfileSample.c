@@ -0,0 +1,197 @@
+/*****************************************************************************
+* File Name: ProfileSample.c
+*
+* Version 1.0
+*
+* Description: Binary profile samples. Recording only encodes 16 bytes
+* into RAM; ProfileSample_Stream() writes the buffer to stdout with one
+* fwrite() after the measurements.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileSample.h"
+
+#define PROFILE_SAMPLE_CRC_POLY (0x1021u)
+#define PROFILE_SAMPLE_CRC_INIT (0xFFFFu)
+
+/**
+********************************************************************************
+* Function Name: ProfileSample_Init
+********************************************************************************
+*
+*  Attaches a buffer of capacity samples (PROFILE_SAMPLE_SIZE bytes each)
+*  Starts the sequence numbers at 0
+*******************************************************************************/
+void ProfileSample_Init(profile_sample_buffer_t *samples, uint8_t buffer[], uint32_t capacity)
+{
+    samples->buffer = buffer;
+    samples->capacity = capacity;
+    samples->count = 0u;
+    samples->dropped = 0u;
+    samples->sequence = 0u;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSample_Record
+********************************************************************************
+*
+*  Encodes one sample at the end of the buffer
+*  Returns false and counts it as dropped when the buffer is full
+*  The sequence number advances for dropped samples too, so the decoder
+*  sees the gap
+*******************************************************************************/
+bool ProfileSample_Record(profile_sample_buffer_t *samples, uint8_t counter, uint8_t monitor,
+                          profile_sample_kind_t kind, uint64_t value)
+{
+    profile_sample_t sample;
+
+    sample.counter = counter;
+    sample.monitor = monitor;
+    sample.kind = (uint8_t)kind;
+    sample.sequence = samples->sequence++;
+    sample.value = value;
+
+    if (samples->count >= samples->capacity)
+    {
+        samples->dropped++;
+        return false;
+    }
+    ProfileSample_Encode(&sample, &samples->buffer[samples->count * PROFILE_SAMPLE_SIZE]);
+    samples->count++;
+    return true;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSample_Stream
+********************************************************************************
+*
+*  Writes the recorded samples to stdout and empties the buffer
+*  Returns the number of samples written
+*******************************************************************************/
+uint32_t ProfileSample_Stream(profile_sample_buffer_t *samples)
+{
+    uint32_t written = (uint32_t)fwrite(samples->buffer, PROFILE_SAMPLE_SIZE, samples->count, stdout);
+
+    (void) fflush(stdout);
+    samples->count = 0u;
+    return written;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSample_Encode
+********************************************************************************
+*
+*  Packs a sample into PROFILE_SAMPLE_SIZE bytes and appends the CRC
+*******************************************************************************/
+void ProfileSample_Encode(const profile_sample_t *sample, uint8_t data[PROFILE_SAMPLE_SIZE])
+{
+    uint32_t index;
+    uint16_t crc;
+
+    data[0] = PROFILE_SAMPLE_SYNC;
+    data[1] = sample->counter;
+    data[2] = sample->monitor;
+    data[3] = sample->kind;
+    data[4] = (uint8_t)(sample->sequence);
+    data[5] = (uint8_t)(sample->sequence >> 8u);
+    for (index = 0u; index < 8u; index++)
+    {
+        data[6u + index] = (uint8_t)(sample->value >> (8u * index));
+    }
+    crc = ProfileSample_Crc(data, PROFILE_SAMPLE_CRC_SIZE);
+    data[14] = (uint8_t)(crc);
+    data[15] = (uint8_t)(crc >> 8u);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSample_Decode
+********************************************************************************
+*
+*  Unpacks PROFILE_SAMPLE_SIZE bytes
+*  Returns false when the sync byte or the CRC does not match
+*******************************************************************************/
+bool ProfileSample_Decode(const uint8_t data[PROFILE_SAMPLE_SIZE], profile_sample_t *sample)
+{
+    uint32_t index;
+    uint16_t crc = (uint16_t)(data[14] | ((uint16_t)data[15] << 8u));
+
+    if ((PROFILE_SAMPLE_SYNC != data[0]) || (crc != ProfileSample_Crc(data, PROFILE_SAMPLE_CRC_SIZE)))
+    {
+        return false;
+    }
+    sample->counter = data[1];
+    sample->monitor = data[2];
+    sample->kind = data[3];
+    sample->sequence = (uint16_t)(data[4] | ((uint16_t)data[5] << 8u));
+    sample->value = 0u;
+    for (index = 0u; index < 8u; index++)
+    {
+        sample->value |= (uint64_t)data[6u + index] << (8u * index);
+    }
+    return true;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSample_Crc
+********************************************************************************
+*
+*  Returns the CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+*******************************************************************************/
+uint16_t ProfileSample_Crc(const uint8_t data[], uint32_t size)
+{
+    uint16_t crc = PROFILE_SAMPLE_CRC_INIT;
+    uint32_t index;
+    uint32_t bit;
+
+    for (index = 0u; index < size; index++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[index] << 8u);
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? (uint16_t)((crc << 1u) ^ PROFILE_SAMPLE_CRC_POLY) : (uint16_t)(crc << 1u);
+        }
+    }
+    return crc;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,103 @@
+/*****************************************************************************
+* File Name: ProfileSample.h
+*
+* Version 1.0
+*
+* Description: Definitions for binary profile samples. Every sample is
+* PROFILE_SAMPLE_SIZE bytes, little endian:
+*   [0]      PROFILE_SAMPLE_SYNC
+*   [1]      counter index (0 to PROFILE_PRFL_CNT_NR - 1)
+*   [2]      monitor (en_ep_mon_sel_t)
+*   [3]      kind (profile_sample_kind_t)
+*   [4..5]   sequence number
+*   [6..13]  64-bit count
+*   [14..15] CRC-16/CCITT-FALSE of bytes 0 to 13
+* Samples are recorded into a RAM buffer during the run and streamed on
+* stdout afterwards, so no formatting happens while the profiler counts.
+* Host/ProfileDecode.cpp decodes a captured stream to CSV. This file only
+* depends on <stdint.h> and <stdbool.h> so that it builds on a host too.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILESAMPLE_H
+#define PROFILESAMPLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PROFILE_SAMPLE_SYNC     (0xA5u)
+#define PROFILE_SAMPLE_SIZE     (16u)
+#define PROFILE_SAMPLE_CRC_SIZE (14u)   /* Bytes covered by the CRC */
+
+/* What the count of a sample is */
+typedef enum
+{
+    PROFILE_SAMPLE_RAW      = 0u,   /* Cy_Profile_GetRawCount */
+    PROFILE_SAMPLE_WEIGHTED = 1u    /* Cy_Profile_GetWeightedCount */
+} profile_sample_kind_t;
+
+/* Decoded sample */
+typedef struct
+{
+    uint8_t counter;
+    uint8_t monitor;
+    uint8_t kind;
+    uint16_t sequence;
+    uint64_t value;
+} profile_sample_t;
+
+/* RAM buffer of encoded samples */
+typedef struct
+{
+    uint8_t *buffer;
+    uint32_t capacity;          /* Samples that fit into the buffer */
+    uint32_t count;             /* Samples recorded */
+    uint32_t dropped;           /* Samples lost because the buffer was full */
+    uint16_t sequence;          /* Sequence number of the next sample */
+} profile_sample_buffer_t;
+
+void ProfileSample_Init(profile_sample_buffer_t *samples, uint8_t buffer[], uint32_t capacity);
+bool ProfileSample_Record(profile_sample_buffer_t *samples, uint8_t counter, uint8_t monitor,
+                          profile_sample_kind_t kind, uint64_t value);
+uint32_t ProfileSample_Stream(profile_sample_buffer_t *samples);
+void ProfileSample_Encode(const profile_sample_t *sample, uint8_t data[PROFILE_SAMPLE_SIZE]);
+bool ProfileSample_Decode(const uint8_t data[PROFILE_SAMPLE_SIZE], profile_sample_t *sample);
+uint16_t ProfileSample_Crc(const uint8_t data[], uint32_t size);
+
+#endif /* PROFILESAMPLE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,252 @@
+/*****************************************************************************
+* File Name: ProfileSampler.c
+*
+* Version 1.0
+*
+* Description: Periodic profile sampler. The ISR reads the 32-bit
+* hardware count registers directly and keeps the difference to the previous
+* read, so it does not depend on the overflow handling of Cy_Profile_ISR as
+* long as no counter counts 2^32 events within one period. The ring is a
+* single producer (ISR) single consumer (main) queue. When it is full, new
+* periods are dropped and counted as overruns; the tick numbers show the gap.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ProfileSampler.h"
+
+static void ProfileSampler_Tick(void);
+static void ProfileSampler_Take(void);
+
+static profile_session_t *samplerSession;
+static profile_sampler_entry_t *samplerRing;
+static uint32_t samplerDepth;
+static volatile uint32_t samplerHead;       /* Next entry written by the ISR */
+static volatile uint32_t samplerTail;       /* Next entry read by the main loop */
+static volatile uint32_t samplerOverruns;
+static uint32_t samplerTick;
+static uint32_t samplerLast[PROFILE_PRFL_CNT_NR];
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_Init
+********************************************************************************
+*
+*  Attaches the ring of depth entries
+*  Configures the sample timer for periodUs microseconds and its interrupt
+*  The timer is not started
+*******************************************************************************/
+void ProfileSampler_Init(profile_sampler_entry_t ring[], uint32_t depth, uint32_t periodUs)
+{
+    const cy_stc_tcpwm_counter_config_t timerConfig =
+    {
+        .period             = periodUs - 1uL,
+        .clockPrescaler     = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode            = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection     = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture   = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0           = 0uL,
+        .compare1           = 0uL,
+        .enableCompareSwap  = false,
+        .interruptSources   = CY_TCPWM_INT_ON_TC,
+        .captureInputMode   = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput       = CY_TCPWM_INPUT_0,
+        .reloadInputMode    = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput        = CY_TCPWM_INPUT_0,
+        .startInputMode     = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput         = CY_TCPWM_INPUT_0,
+        .stopInputMode      = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput          = CY_TCPWM_INPUT_0,
+        .countInputMode     = CY_TCPWM_INPUT_LEVEL,
+        .countInput         = CY_TCPWM_INPUT_1,
+    };
+
+    const cy_stc_sysint_t timerIntrConfig =
+    {
+        .intrSrc      = PROFILE_SAMPLER_INTR_SRC,
+        .intrPriority = PROFILE_SAMPLER_INTR_PRIORITY
+    };
+
+    samplerRing = ring;
+    samplerDepth = depth;
+    samplerHead = 0u;
+    samplerTail = 0u;
+    samplerOverruns = 0u;
+
+    Cy_SysClk_PeriphSetDivider(PROFILE_SAMPLER_DIV_TYPE, PROFILE_SAMPLER_DIV_NUM,
+        (cy_PeriClkFreqHz / PROFILE_SAMPLER_TICK_HZ) - 1uL);
+    Cy_SysClk_PeriphEnableDivider(PROFILE_SAMPLER_DIV_TYPE, PROFILE_SAMPLER_DIV_NUM);
+    Cy_SysClk_PeriphAssignDivider(PROFILE_SAMPLER_CLK_DST, PROFILE_SAMPLER_DIV_TYPE, PROFILE_SAMPLER_DIV_NUM);
+
+    (void) Cy_TCPWM_Counter_Init(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_NUM, &timerConfig);
+    Cy_TCPWM_Enable_Multiple(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_MASK);
+
+    (void) Cy_SysInt_Init(&timerIntrConfig, &ProfileSampler_Tick);
+    NVIC_EnableIRQ(timerIntrConfig.intrSrc);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_Start
+********************************************************************************
+*
+*  Starts the counters of an open session together with the sample timer
+*  Entries read before are discarded
+*******************************************************************************/
+void ProfileSampler_Start(profile_session_t *session)
+{
+    uint32_t index;
+
+    samplerSession = session;
+    samplerHead = 0u;
+    samplerTail = 0u;
+    samplerOverruns = 0u;
+    samplerTick = 0u;
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        samplerLast[index] = 0u;
+    }
+
+    Cy_TCPWM_Counter_SetCounter(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_NUM, 0uL);
+    ProfileSession_Start(session);
+    Cy_TCPWM_TriggerStart(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_MASK);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_Stop
+********************************************************************************
+*
+*  Stops the sample timer and the counters
+*  Stores the last, partial period as a final entry
+*******************************************************************************/
+void ProfileSampler_Stop(void)
+{
+    Cy_TCPWM_TriggerStopOrKill(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_MASK);
+    NVIC_DisableIRQ(PROFILE_SAMPLER_INTR_SRC);
+    ProfileSession_Stop(samplerSession);
+
+    /* A pending period end is taken here instead of in the ISR */
+    if (0u != Cy_TCPWM_GetInterruptStatus(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_NUM))
+    {
+        Cy_TCPWM_ClearInterrupt(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_NUM, CY_TCPWM_INT_ON_TC);
+        NVIC_ClearPendingIRQ(PROFILE_SAMPLER_INTR_SRC);
+    }
+    ProfileSampler_Take();
+    NVIC_EnableIRQ(PROFILE_SAMPLER_INTR_SRC);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_Read
+********************************************************************************
+*
+*  Copies the oldest entry of the ring and removes it
+*  Returns false when the ring is empty
+*******************************************************************************/
+bool ProfileSampler_Read(profile_sampler_entry_t *entry)
+{
+    uint32_t tail = samplerTail;
+
+    if (tail == samplerHead)
+    {
+        return false;
+    }
+    *entry = samplerRing[tail];
+    samplerTail = ((tail + 1u) < samplerDepth) ? (tail + 1u) : 0u;
+    return true;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_GetOverruns
+********************************************************************************
+*
+*  Returns the number of periods dropped because the ring was full
+*******************************************************************************/
+uint32_t ProfileSampler_GetOverruns(void)
+{
+    return samplerOverruns;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_Tick
+********************************************************************************
+*
+*  Sample timer ISR, stores the counts of the period that just ended
+*******************************************************************************/
+static void ProfileSampler_Tick(void)
+{
+    Cy_TCPWM_ClearInterrupt(PROFILE_SAMPLER_HW, PROFILE_SAMPLER_CNT_NUM, CY_TCPWM_INT_ON_TC);
+    ProfileSampler_Take();
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSampler_Take
+********************************************************************************
+*
+*  Reads every counter of the session and stores the differences to the
+*  previous read at the head of the ring
+*******************************************************************************/
+static void ProfileSampler_Take(void)
+{
+    uint32_t head = samplerHead;
+    uint32_t next = ((head + 1u) < samplerDepth) ? (head + 1u) : 0u;
+    uint32_t index;
+    uint32_t count;
+
+    for (index = 0u; index < samplerSession->count; index++)
+    {
+        count = samplerSession->counters[index]->cntAddr->CNT;
+        samplerRing[head].count[index] = count - samplerLast[index];
+        samplerLast[index] = count;
+    }
+    samplerRing[head].tick = samplerTick++;
+
+    if (next == samplerTail)
+    {
+        /* Ring full, the period is lost */
+        samplerOverruns++;
+    }
+    else
+    {
+        samplerHead = next;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/*****************************************************************************
+* File Name: ProfileSampler.h
+*
+* Version 1.0
+*
+* Description: Definitions of the periodic profile sampler. A TCPWM
+* counter interrupts every periodUs microseconds and its ISR stores the
+* counts of every counter of a profile session since the previous interrupt
+* in a RAM ring. The main loop reads the ring with ProfileSampler_Read().
+* The counts are raw, the counter weights are not applied.
+* The TCPWM counter and the clock divider are configured here in firmware
+* and must not be used by the design.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILESAMPLER_H
+#define PROFILESAMPLER_H
+
+#include <project.h>
+#include "ProfileSession.h"
+
+/* TCPWM counter of the sample timer, clocked with 1 MHz from PERI */
+#define PROFILE_SAMPLER_HW            (TCPWM0)
+#define PROFILE_SAMPLER_CNT_NUM       (7u)
+#define PROFILE_SAMPLER_CNT_MASK      (1uL << PROFILE_SAMPLER_CNT_NUM)
+#define PROFILE_SAMPLER_CLK_DST       ((en_clk_dst_t)((uint32_t)PCLK_TCPWM0_CLOCKS0 + PROFILE_SAMPLER_CNT_NUM))
+#define PROFILE_SAMPLER_DIV_TYPE      (CY_SYSCLK_DIV_16_BIT)
+#define PROFILE_SAMPLER_DIV_NUM       (7u)
+#define PROFILE_SAMPLER_TICK_HZ       (1000000ul)
+#define PROFILE_SAMPLER_INTR_SRC      (tcpwm_0_interrupts_7_IRQn)
+#define PROFILE_SAMPLER_INTR_PRIORITY (6u)
+
+/* One sample period */
+typedef struct
+{
+    uint32_t tick;                          /* Period number since ProfileSampler_Start */
+    uint32_t count[PROFILE_PRFL_CNT_NR];    /* Counts in the period, in session order */
+} profile_sampler_entry_t;
+
+void ProfileSampler_Init(profile_sampler_entry_t ring[], uint32_t depth, uint32_t periodUs);
+void ProfileSampler_Start(profile_session_t *session);
+void ProfileSampler_Stop(void);
+bool ProfileSampler_Read(profile_sampler_entry_t *entry);
+uint32_t ProfileSampler_GetOverruns(void);
+
+#endif /* PROFILESAMPLER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+/*****************************************************************************
+* File Name: ProfileSession.c
+*
+* Version 1.0
+*
+* Description: Profiling sessions on top of the PDL profile driver.
+* The counters are read after Cy_Profile_StopProfiling(), so the bracket
+* itself only costs two register writes.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileSession.h"
+#include "ProfileOverflow.h"
+#include "ProfileCycles.h"
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_Open
+********************************************************************************
+*
+*  Assigns one hardware counter to every monitor and enables it
+*  Frees the counters already assigned if one of them fails
+*  Returns PROFILE_SESSION_SUCCESS when all monitors have a counter
+*******************************************************************************/
+profile_session_status_t ProfileSession_Open(profile_session_t *session,
+                                             const profile_monitor_t monitors[], uint32_t count)
+{
+    uint32_t index;
+    profile_session_status_t status = PROFILE_SESSION_SUCCESS;
+
+    if ((0u == count) || (count > PROFILE_PRFL_CNT_NR))
+    {
+        return PROFILE_SESSION_BAD_PARAM;
+    }
+    session->monitors = monitors;
+    session->count = 0u;
+
+    for (index = 0u; (index < count) && (PROFILE_SESSION_SUCCESS == status); index++)
+    {
+        session->counters[index] = Cy_Profile_ConfigureCounter(monitors[index].monitor,
+                                                               monitors[index].duration,
+                                                               monitors[index].refClk,
+                                                               monitors[index].weight);
+        if (NULL == session->counters[index])
+        {
+            status = PROFILE_SESSION_NO_COUNTER;
+        }
+        else
+        {
+            session->count++;
+            ProfileOverflow_Attach(session->counters[index]);
+            if (CY_PROFILE_SUCCESS != Cy_Profile_EnableCounter(session->counters[index]))
+            {
+                status = PROFILE_SESSION_ERROR;
+            }
+        }
+    }
+
+    if (PROFILE_SESSION_SUCCESS != status)
+    {
+        ProfileSession_Close(session);
+    }
+    return status;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_Start
+********************************************************************************
+*
+*  Clears all counters and starts them together with the cycle count
+*******************************************************************************/
+void ProfileSession_Start(profile_session_t *session)
+{
+    Cy_Profile_ClearCounters();
+    ProfileOverflow_Clear();
+    Cy_Profile_StartProfiling();
+    session->startCycles = ProfileCycles_Read();
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_Stop
+********************************************************************************
+*
+*  Stops all counters together and keeps the cycles of the session
+*******************************************************************************/
+void ProfileSession_Stop(profile_session_t *session)
+{
+    session->cycles = ProfileCycles_Elapsed(session->startCycles);
+    Cy_Profile_StopProfiling();
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_GetCycles
+********************************************************************************
+*
+*  Returns the CPU cycles between Start and Stop, without the overhead of
+*  the measurement
+*******************************************************************************/
+uint32_t ProfileSession_GetCycles(const profile_session_t *session)
+{
+    return session->cycles;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_GetResults
+********************************************************************************
+*
+*  Fills one result line per monitor, in the order of the monitor table
+*  Returns the sum of the weighted counts in weightedSum
+*******************************************************************************/
+profile_session_status_t ProfileSession_GetResults(const profile_session_t *session,
+                                                   profile_result_t results[], uint64_t *weightedSum)
+{
+    uint32_t index;
+    profile_session_status_t status = PROFILE_SESSION_SUCCESS;
+
+    for (index = 0u; index < session->count; index++)
+    {
+        results[index].label = session->monitors[index].label;
+        results[index].monitor = session->monitors[index].monitor;
+        if ((CY_PROFILE_SUCCESS != Cy_Profile_GetRawCount(session->counters[index], &results[index].rawCount)) ||
+            (CY_PROFILE_SUCCESS != Cy_Profile_GetWeightedCount(session->counters[index], &results[index].weightedCount)))
+        {
+            status = PROFILE_SESSION_ERROR;
+        }
+    }
+    *weightedSum = Cy_Profile_GetSumWeightedCounts((cy_stc_profile_ctr_ptr_t *) session->counters, session->count);
+    return status;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_PrintResults
+********************************************************************************
+*
+*  Prints the result table on stdout
+*  Adds the CPU cycles per event of every monitor, with two decimals
+*******************************************************************************/
+void ProfileSession_PrintResults(const profile_result_t results[], uint32_t count, uint64_t weightedSum,
+                                 uint32_t cycles)
+{
+    uint32_t index;
+    uint64_t perEvent;
+
+    printf ("    CPU cycles: %lu (%s, overhead of %lu cycles removed)\n\r",
+            cycles, ProfileCycles_GetSource(), ProfileCycles_GetOverhead());
+    printf ("    %-16s %18s %18s %14s\n\r", "Monitor", "Raw count", "Weighted count", "Cycles/event");
+    for (index = 0u; index < count; index++)
+    {
+        perEvent = (0u != results[index].rawCount) ? (((uint64_t)cycles * 100u) / results[index].rawCount) : 0u;
+        printf ("    %-16s %018lld %018lld %11lu.%02lu\n\r", results[index].label,
+                results[index].rawCount, results[index].weightedCount,
+                (uint32_t)(perEvent / 100u), (uint32_t)(perEvent % 100u));
+    }
+    printf ("    %-16s %18s %018lld\n\r", "Total", "", weightedSum);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileSession_Close
+********************************************************************************
+*
+*  Disables and frees the counters of the session
+*******************************************************************************/
+void ProfileSession_Close(profile_session_t *session)
+{
+    uint32_t index;
+
+    for (index = 0u; index < session->count; index++)
+    {
+        (void) Cy_Profile_DisableCounter(session->counters[index]);
+        (void) Cy_Profile_FreeCounter(session->counters[index]);
+    }
+    session->count = 0u;
+}
+
+/* [] END OF FILE */
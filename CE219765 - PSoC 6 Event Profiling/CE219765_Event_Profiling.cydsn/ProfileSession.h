@@ -0,0 +1,103 @@
+/*****************************************************************************
+* File Name: ProfileSession.h
+*
+* Version 1.0
+*
+* Description: Definitions for profiling sessions. A session configures
+* several monitors at once across the PROFILE_PRFL_CNT_NR hardware counters,
+* runs them between one start/stop bracket and returns a labelled table of
+* the raw and weighted counts.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILESESSION_H
+#define PROFILESESSION_H
+
+#include <project.h>
+
+/* One monitor of a session */
+typedef struct
+{
+    const char *label;                  /* Name printed in the result table */
+    en_ep_mon_sel_t monitor;            /* Monitor signal, e.g. SCB5_MONITOR_AHB */
+    cy_en_profile_duration_t duration;  /* CY_PROFILE_EVENT or CY_PROFILE_DURATION */
+    cy_en_profile_ref_clk_t refClk;     /* Reference clock of duration counts */
+    uint32_t weight;                    /* Coefficient of the weighted count */
+} profile_monitor_t;
+
+/* One line of the result table */
+typedef struct
+{
+    const char *label;
+    en_ep_mon_sel_t monitor;
+    uint64_t rawCount;
+    uint64_t weightedCount;
+} profile_result_t;
+
+/* Session handle */
+typedef struct
+{
+    const profile_monitor_t *monitors;
+    uint32_t count;
+    cy_stc_profile_ctr_ptr_t counters[PROFILE_PRFL_CNT_NR];
+    uint32_t startCycles;
+    uint32_t cycles;                    /* CPU cycles from Start to Stop */
+} profile_session_t;
+
+/* Result of the session functions */
+typedef enum
+{
+    PROFILE_SESSION_SUCCESS     = 0u,
+    PROFILE_SESSION_BAD_PARAM   = 1u,   /* No monitor or more than the counters */
+    PROFILE_SESSION_NO_COUNTER  = 2u,   /* A counter is already used elsewhere */
+    PROFILE_SESSION_ERROR       = 3u    /* The profile driver returned an error */
+} profile_session_status_t;
+
+profile_session_status_t ProfileSession_Open(profile_session_t *session,
+                                             const profile_monitor_t monitors[], uint32_t count);
+void ProfileSession_Start(profile_session_t *session);
+void ProfileSession_Stop(profile_session_t *session);
+uint32_t ProfileSession_GetCycles(const profile_session_t *session);
+profile_session_status_t ProfileSession_GetResults(const profile_session_t *session,
+                                                   profile_result_t results[], uint64_t *weightedSum);
+void ProfileSession_PrintResults(const profile_result_t results[], uint32_t count, uint64_t weightedSum,
+                                 uint32_t cycles);
+void ProfileSession_Close(profile_session_t *session);
+
+#endif /* PROFILESESSION_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,188 @@
+/*****************************************************************************
+* File Name: ProfileTrace.c
+*
+* Version 1.0
+*
+* Description: Function entry/exit trace of the -finstrument-functions
+* build variant. The hooks reserve a slot of the ring with one atomic
+* increment (LDREX/STREX on the CM4), so interrupts that preempt a hook record
+* their own events without a lock. The ring wraps; the oldest events are
+* overwritten and ProfileTrace_Print() starts at the oldest one left.
+* Nothing in this file may be instrumented, see PROFILE_TRACE_EXCLUDE.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileTrace.h"
+
+PROFILE_TRACE_EXCLUDE static inline void ProfileTrace_Record(uint32_t address);
+
+static profile_trace_event_t *traceRing;
+static uint32_t traceDepth;
+static volatile uint32_t traceCount;    /* Events recorded, the next slot is traceCount % traceDepth */
+static volatile bool traceEnabled;
+
+/**
+********************************************************************************
+* Function Name: ProfileTrace_Init
+********************************************************************************
+*
+*  Attaches the ring of depth events and starts the DWT cycle counter
+*  Recording is off until ProfileTrace_Start
+*******************************************************************************/
+void ProfileTrace_Init(profile_trace_event_t ring[], uint32_t depth)
+{
+    traceEnabled = false;
+    traceRing = ring;
+    traceDepth = depth;
+    traceCount = 0u;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileTrace_Start
+********************************************************************************
+*
+*  Discards the recorded events and starts recording
+*******************************************************************************/
+void ProfileTrace_Start(void)
+{
+    traceCount = 0u;
+    traceEnabled = true;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileTrace_Stop
+********************************************************************************
+*
+*  Stops recording, the events are kept for ProfileTrace_Print
+*******************************************************************************/
+void ProfileTrace_Stop(void)
+{
+    traceEnabled = false;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileTrace_GetCount
+********************************************************************************
+*
+*  Returns the number of events recorded since ProfileTrace_Start,
+*  overwritten ones included
+*******************************************************************************/
+uint32_t ProfileTrace_GetCount(void)
+{
+    return traceCount;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileTrace_Print
+********************************************************************************
+*
+*  Prints one "PFT <address> <cycles>" line per event in the ring, oldest
+*  first, hexadecimal, for Host/ProfileCallTree. Call it after ProfileTrace_Stop,
+*  printf is not traced while the trace is stopped.
+*******************************************************************************/
+void ProfileTrace_Print(void)
+{
+    uint32_t count = traceCount;
+    uint32_t first = (count > traceDepth) ? (count - traceDepth) : 0u;
+    uint32_t index;
+
+    for (index = first; index < count; index++)
+    {
+        printf ("PFT %08lx %08lx\n\r", (unsigned long)traceRing[index % traceDepth].address,
+                (unsigned long)traceRing[index % traceDepth].cycles);
+    }
+    printf ("    %lu events recorded, %lu overwritten\n\r", (unsigned long)count, (unsigned long)first);
+}
+
+/**
+********************************************************************************
+* Function Name: __cyg_profile_func_enter
+********************************************************************************
+*
+*  Called by instrumented code at the entry of every function
+*******************************************************************************/
+void __cyg_profile_func_enter(void *function, void *callSite)
+{
+    (void) callSite;
+    ProfileTrace_Record((uint32_t)(uintptr_t)function);
+}
+
+/**
+********************************************************************************
+* Function Name: __cyg_profile_func_exit
+********************************************************************************
+*
+*  Called by instrumented code at the exit of every function
+*******************************************************************************/
+void __cyg_profile_func_exit(void *function, void *callSite)
+{
+    (void) callSite;
+    ProfileTrace_Record((uint32_t)(uintptr_t)function | PROFILE_TRACE_EXIT);
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileTrace_Record
+********************************************************************************
+*
+*  Reserves the next slot and stores the event in it
+*  An interrupt between the cycle read and the reservation stores its events
+*  first; Host/ProfileCallTree takes the resulting backward step as 0 cycles.
+*******************************************************************************/
+static inline void ProfileTrace_Record(uint32_t address)
+{
+    uint32_t cycles;
+    uint32_t slot;
+
+    if (traceEnabled)
+    {
+        cycles = DWT->CYCCNT;
+        slot = __atomic_fetch_add(&traceCount, 1u, __ATOMIC_RELAXED) % traceDepth;
+        traceRing[slot].address = address;
+        traceRing[slot].cycles = cycles;
+    }
+}
+
+/* [] END OF FILE */
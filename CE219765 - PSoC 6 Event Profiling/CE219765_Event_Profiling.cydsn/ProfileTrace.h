@@ -0,0 +1,87 @@
+/*****************************************************************************
+* File Name: ProfileTrace.h
+*
+* Version 1.0
+*
+* Description: Definitions of the function entry/exit trace of the
+* -finstrument-functions build variant. GCC calls __cyg_profile_func_enter and
+* __cyg_profile_func_exit around every function of an instrumented file; the
+* hooks store the function address and the DWT cycle count in a RAM ring.
+* ProfileTrace_Print() writes the ring as "PFT" lines; Host/ProfileCallTree
+* rebuilds the call tree with inclusive and exclusive cycles. CM4 only.
+*
+* To build the variant add to Build Settings > ARM GCC > Compiler >
+* Command Line of the CM4:
+*  -finstrument-functions -DPROFILE_TRACE
+*  -finstrument-functions-exclude-file-list=Generated_Source,ProfileTrace.c,ProfilePc.c
+* Files or paths of the list are not instrumented. Single functions are
+* excluded with PROFILE_TRACE_EXCLUDE. No naked handler may be instrumented:
+* GCC still calls the hooks in a naked function, the call overwrites the
+* EXC_RETURN value in LR before the handler reads it.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: See CE219765.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILETRACE_H
+#define PROFILETRACE_H
+
+#include <project.h>
+
+/* Keeps a function out of the trace, the hooks and their callees need it */
+#define PROFILE_TRACE_EXCLUDE       __attribute__((no_instrument_function))
+
+/* Set in the address of an exit, code addresses are below 0x80000000 */
+#define PROFILE_TRACE_EXIT          (0x80000000uL)
+
+/* One function entry or exit */
+typedef struct
+{
+    uint32_t address;       /* Function address, PROFILE_TRACE_EXIT for an exit */
+    uint32_t cycles;        /* DWT CYCCNT, wraps at 2^32 */
+} profile_trace_event_t;
+
+PROFILE_TRACE_EXCLUDE void ProfileTrace_Init(profile_trace_event_t ring[], uint32_t depth);
+PROFILE_TRACE_EXCLUDE void ProfileTrace_Start(void);
+PROFILE_TRACE_EXCLUDE void ProfileTrace_Stop(void);
+PROFILE_TRACE_EXCLUDE uint32_t ProfileTrace_GetCount(void);
+PROFILE_TRACE_EXCLUDE void ProfileTrace_Print(void);
+
+PROFILE_TRACE_EXCLUDE void __cyg_profile_func_enter(void *function, void *callSite);
+PROFILE_TRACE_EXCLUDE void __cyg_profile_func_exit(void *function, void *callSite);
+
+#endif /* PROFILETRACE_H */
+
+/* [] END OF FILE */
@@ -45,6 +45,19 @@
 #include <project.h>
 #include <stdio.h>
 #include "my_stdio_user.h"
+#include "my_stdout_ring.h"
+#include "ProfileSession.h"
+#include "ProfileSample.h"
+#include "ProfileSampler.h"
+#include "ProfileOverflow.h"
+#include "ProfileRegion.h"
+#include "ProfileCycles.h"
+#include "ProfileEnergy.h"
+#include "ProfileBaseline.h"
+#include "ProfileBaselinePort.h"
+#include "ProfilePc.h"
+#include "ProfileTrace.h"
+#include "ProfileBackend.h"
 
 /**
 ********************************************************************************
@@ -53,6 +66,27 @@
 
 #define PROFILE_USE_IRQ               /* < handle counter overflows in profiler            */
 #define PROFILE_IRQ_INTR_PRIORITY 7   /* < Int priority number (Refer to __NVIC_PRIO_BITS) */
+#define PROFILE_WINDOW_US  (100000ul) /* < Window of the event budgets                       */
+#define SCB5_EVENT_BUDGET  (2000u)    /* < SCB5 events per window before an alert             */
+
+/*  At startup every available stdout backend prints a burst of STDOUT_BURST
+ *  characters; the one that costs the fewest CPU cycles at this baud rate
+ *  and clock prints all output that is not measured.
+ */
+/*  The measured sections after the three legs use the interrupt backend when
+ *  it is compiled in and the polling backend when it is not.
+ */
+#define STDOUT_BURST       (32u)
+#if defined(UART_SCB_IRQ__INTC_ASSIGNED)
+    #define STDOUT_BACKENDS (PROFILE_BACKEND_MASK(PROFILE_BACKEND_POLLING) | \
+                             PROFILE_BACKEND_MASK(PROFILE_BACKEND_IRQ) | PROFILE_BACKEND_MASK(PROFILE_BACKEND_DMA))
+    #define SESSION_BACKEND (PROFILE_BACKEND_IRQ)
+    #define SESSION_BACKEND_NAME "Interrupt"
+#else
+    #define STDOUT_BACKENDS (PROFILE_BACKEND_MASK(PROFILE_BACKEND_POLLING) | PROFILE_BACKEND_MASK(PROFILE_BACKEND_DMA))
+    #define SESSION_BACKEND (PROFILE_BACKEND_POLLING)
+    #define SESSION_BACKEND_NAME "Polling"
+#endif /* (UART_SCB_IRQ__INTC_ASSIGNED) */
 
 /*  The Energy Profiler implements the concept of a coefficient. This allows
  *  you to adjust the raw count by a factor so you can tune the results to
@@ -63,6 +97,62 @@
 //#define WEIGHT_NORM  1000000ul  /* Scaling coefficients can be any value */
 #define WEIGHT_NORM  1ul          /* Value of 1 returns actual count */
 
+/*  The activity breakdown weighs every monitor with its energy instead:
+ *  pJ per event, or per HF cycle for the duration monitors. The values of
+ *  energyCoefficients are examples, not measurements of a kit. Define
+ *  PROFILE_ENERGY_CALIBRATE to derive them on your board: measure the supply
+ *  current during each calibration workload, set the CALIBRATE_*_UA deltas
+ *  to it minus the idle current, run again and paste the printed table.
+ *  The CPU workload runs first: its coefficient takes the CPU energy out of
+ *  the UART coefficient.
+ */
+//#define PROFILE_ENERGY_CALIBRATE
+#define ENERGY_SUPPLY_MV     (3300u)  /* Supply of the measured current */
+#define CALIBRATE_REPEAT     (500u)   /* Workload runs per calibration */
+#define CALIBRATE_CM4_UA     (0u)     /* Current delta of the CPU workload */
+#define CALIBRATE_SCB5_UA    (0u)     /* Current delta of the UART workload */
+
+/*  Define PROFILE_BINARY_SAMPLES to also record every count as a binary sample
+ *  in RAM and stream all of them after the run. The stream is mixed with the
+ *  terminal text; capture it to a file and run Host/ProfileDecode to get CSV.
+ */
+//#define PROFILE_BINARY_SAMPLES
+#define PROFILE_SAMPLE_CAPACITY  (128u)   /* Samples held in RAM until the end of the run */
+
+/*  Activity over time: all counters of the session are sampled every
+ *  SAMPLER_PERIOD_US into a ring of SAMPLER_DEPTH periods.
+ */
+#define SAMPLER_PERIOD_US  (2000ul)
+#define SAMPLER_DEPTH      (64u)
+
+/*  Hot spots: the PC and LR of the interrupted code are sampled every
+ *  PC_SAMPLE_PERIOD_US while the string is printed PC_SAMPLE_REPEAT times.
+ *  A prime period does not beat with periodic code. Capture the PCS lines
+ *  and run Host/ProfileSymbolize with the .elf or .map of this build.
+ */
+#define PC_SAMPLE_PERIOD_US  (97ul)
+#define PC_SAMPLE_SLOTS      (256u)   /* Histogram slots, a power of two */
+#define PC_SAMPLE_REPEAT     (10u)
+
+/*  Build the -finstrument-functions variant described in ProfileTrace.h to
+ *  trace every function entry and exit of one print of the string. Capture
+ *  the PFT lines and run Host/ProfileCallTree with the .elf or .map.
+ */
+#define TRACE_DEPTH          (512u)   /* Events held by the ring */
+
+/*  The mode comparison is checked against the baseline stored in flash by an
+ *  earlier run. A count more than BASELINE_TOLERANCE_PCT above its baseline is
+ *  a regression and leaves the RED LED on. The first run stores the baseline;
+ *  define PROFILE_BASELINE_UPDATE to replace it with the counts of this run.
+ */
+#define BASELINE_TOLERANCE_PCT  (5u)
+//#define PROFILE_BASELINE_UPDATE
+#if defined(PROFILE_BASELINE_UPDATE)
+    #define BASELINE_REBASELINE  (true)
+#else
+    #define BASELINE_REBASELINE  (false)
+#endif /* (PROFILE_BASELINE_UPDATE) */
+
 /* Interrupt configuration structure */
 #if defined (PROFILE_USE_IRQ)
     const cy_stc_sysint_t profileIrqCfg =
@@ -78,10 +168,115 @@
 /* profile counter configuration structure */
 cy_stc_profile_ctr_ptr_t cy_profiler_ctrs[PROFILE_PRFL_CNT_NR];
 
+/* Windows in which SCB5 exceeded SCB5_EVENT_BUDGET, counted by BudgetAlert */
+volatile uint32_t budgetAlerts;
+
+/* Ring of the periodic sampler */
+profile_sampler_entry_t samplerRing[SAMPLER_DEPTH];
+
+/* Histogram of the PC sampler */
+profile_pc_entry_t pcHistogram[PC_SAMPLE_SLOTS];
+
+/* Ring of the function trace */
+#if defined(PROFILE_TRACE)
+    profile_trace_event_t traceRing[TRACE_DEPTH];
+#endif /* (PROFILE_TRACE) */
+
+/* Binary samples, streamed after the run */
+#if defined(PROFILE_BINARY_SAMPLES)
+    profile_sample_buffer_t profileSamples;
+    uint8_t profileSampleData[PROFILE_SAMPLE_CAPACITY * PROFILE_SAMPLE_SIZE];
+    #define RECORD_SAMPLE(counter, monitor, kind, value) \
+        (void) ProfileSample_Record(&profileSamples, (counter), (uint8_t)(monitor), (kind), (value))
+#else
+    #define RECORD_SAMPLE(counter, monitor, kind, value)
+#endif /* (PROFILE_BINARY_SAMPLES) */
+
+/* Monitors of the activity breakdown, one per hardware counter. Clk HF
+* counts every cycle (PROFILE_ONE), the reference for the event counts.
+*/
+const profile_monitor_t activityMonitors[PROFILE_PRFL_CNT_NR] =
+{
+    { "CM4 active",  CPUSS_MONITOR_CM4,     CY_PROFILE_DURATION, CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "CM0+ active", CPUSS_MONITOR_CM0,     CY_PROFILE_DURATION, CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "Flash",       CPUSS_MONITOR_FLASH,   CY_PROFILE_EVENT,    CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "DataWire 0",  CPUSS_MONITOR_DW0_AHB, CY_PROFILE_EVENT,    CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "DataWire 1",  CPUSS_MONITOR_DW1_AHB, CY_PROFILE_EVENT,    CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "Crypto",      CPUSS_MONITOR_CRYPTO,  CY_PROFILE_EVENT,    CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "SCB5 (UART)", SCB5_MONITOR_AHB,      CY_PROFILE_EVENT,    CY_PROFILE_CLK_HF, WEIGHT_NORM },
+    { "Clk HF",      PROFILE_ONE,           CY_PROFILE_EVENT,    CY_PROFILE_CLK_HF, WEIGHT_NORM }
+};
+
+/* Energy coefficients of the activity monitors, examples in pJ */
+const profile_energy_coeff_t energyCoefficients[] =
+{
+    { CPUSS_MONITOR_CM4,     130u },
+    { CPUSS_MONITOR_CM0,     60u },
+    { CPUSS_MONITOR_FLASH,   25u },
+    { CPUSS_MONITOR_DW0_AHB, 40u },
+    { CPUSS_MONITOR_DW1_AHB, 40u },
+    { CPUSS_MONITOR_CRYPTO,  80u },
+    { SCB5_MONITOR_AHB,      15u }
+};
+
+/* activityMonitors weighed with energyCoefficients */
+profile_monitor_t energyMonitors[PROFILE_PRFL_CNT_NR];
+
 /********************************************************************************
 * Externally used parameters
 ********************************************************************************/
 
+/**
+********************************************************************************
+* Function Name: BudgetAlert
+********************************************************************************
+*
+*  Called from the budget window interrupt when SCB5 exceeded its budget
+*******************************************************************************/
+static void BudgetAlert(uint32_t counter, uint64_t count)
+{
+    (void) counter;
+    (void) count;
+    budgetAlerts++;
+}
+
+#if defined(PROFILE_ENERGY_CALIBRATE)
+/**
+********************************************************************************
+* Function Name: CalibrateCpuLoad
+********************************************************************************
+*
+*  Calibration workload of the CM4, busy for some 100000 cycles
+*******************************************************************************/
+static void CalibrateCpuLoad(void)
+{
+    volatile uint32_t loop;
+
+    for (loop = 0u; loop < 25000u; loop++)
+    {
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: CalibrateUartLoad
+********************************************************************************
+*
+*  Calibration workload of SCB5, puts 16 characters into the UART FIFO
+*******************************************************************************/
+static void CalibrateUartLoad(void)
+{
+    uint32_t loop;
+
+    for (loop = 0u; loop < 16u; loop++)
+    {
+        while (0UL == UART_Put('.'))
+        {
+        }
+    }
+}
+#endif /* (PROFILE_ENERGY_CALIBRATE) */
+
 /**
 ********************************************************************************
 * Function Name: main
@@ -91,6 +286,10 @@ cy_stc_profile_ctr_ptr_t cy_profiler_ctrs[PROFILE_PRFL_CNT_NR];
 *  Configures the profiler interrupt
 *  Enables the UART interrupt and profiles UART use (counts # of events)
 *  Disables the UART interrupt and profiles UART use (counts # of events)
+*  Profiles UART use with the DMA stdout backend and compares the CPU cycles
+*  Profiles all monitors of activityMonitors at once in one session and
+*  ranks them by energy
+*  Samples the same monitors periodically to show the activity over time
 *******************************************************************************/
 int main(void)
 {
@@ -103,6 +302,26 @@ int main(void)
        only really need two for example, but defined for max */
     uint64_t my_Profile_current_raw_value[8];
 
+    /* SCB5 events and CM4 cycles of the last test of each stdout mode */
+    static const char *myModeName[3] = { "Interrupt", "Polling", "DMA" };
+    uint64_t myModeEvents[3];
+    uint64_t myModeCycles[3];
+    static const char *myBaselineName[3][2] =
+    {
+        { "Interrupt SCB5 events", "Interrupt CM4 cycles" },
+        { "Polling SCB5 events",   "Polling CM4 cycles"   },
+        { "DMA SCB5 events",       "DMA CM4 cycles"       }
+    };
+    uint64_t myEnergy;
+
+    /* Session over all eight hardware counters and its result table */
+    profile_session_t mySession;
+    profile_result_t myResults[PROFILE_PRFL_CNT_NR];
+    uint64_t myWeightedSum;
+    uint8_t  myCounter;
+    profile_sampler_entry_t myEntry;
+    profile_overflow_stats_t myOverflowStats;
+
     /* Turn fitter define to variable */
     #if defined(UART_SCB_IRQ__INTC_ASSIGNED)
         UartUsesIRQ = true;
@@ -136,17 +355,26 @@ int main(void)
     /******************************************************************************
     * The PDL implementation includes a profiler ISR named Cy_Profile_ISR. This
     * default ISR handles counter overflow.
-    *  If a more a complex interrupt process is needed, write your own function and place
-    *  a pointer to it in the Cy_SysInt_Init() call replacing &Cy_Profile_ISR.
+    *  ProfileOverflow_ISR replaces it. It also keeps overflow statistics and
+    *  checks the event budgets every PROFILE_WINDOW_US.
     *******************************************************************************/
 
     #if defined(PROFILE_USE_IRQ)
-        (void) Cy_SysInt_Init(&profileIrqCfg, &Cy_Profile_ISR); /* ISR provided in API */
+        (void) Cy_SysInt_Init(&profileIrqCfg, &ProfileOverflow_ISR);
         NVIC_EnableIRQ(profileIrqCfg.intrSrc);
+        ProfileOverflow_Init(PROFILE_WINDOW_US, PROFILE_IRQ_INTR_PRIORITY);
     #endif
 
     __enable_irq(); /* Enable global interrupts. */
 
+    /* Banner and setup messages are not measured, they go through the DMA backend */
+    StdoutRing_Init(STDOUT_RING_BLOCK);
+    UartUsesDma = true;
+
+    #if defined(PROFILE_BINARY_SAMPLES)
+        ProfileSample_Init(&profileSamples, profileSampleData, PROFILE_SAMPLE_CAPACITY);
+    #endif
+
     printf("\x1b[2J\x1b[;H");/* <ESC>[2J<ESC>[;H - ANSI ESC sequence for clear screen*/
 
     /* Transmit header to the terminal.*/
@@ -167,23 +395,68 @@ int main(void)
 
     /* Initialize Profile Module. */
     Cy_Profile_Init();
+    ProfileCycles_Init();
+    ProfileRegion_Init();
     printf ("    Profile Module - Initializing - Done\n\r");
+    printf ("    Cycle counter - %s, %lu cycles per measurement\n\r",
+            ProfileCycles_GetSource(), ProfileCycles_GetOverhead());
+
+    /* The rest of the setup messages go through the cheapest backend */
+    printf ("\n\r    Stdout backend - %u character burst with each backend\n\r", STDOUT_BURST);
+    (void) ProfileBackend_Select(STDOUT_BACKENDS, STDOUT_BURST);
+    ProfileBackend_Print();
+    printf ("\n\r");
 
     /* Clear the Profile configuration as good practice. */
     Cy_Profile_ClearConfiguration();
     printf ("    Profile Module - Clear any old configuration data - Done\n\r");
 
+    /* Energy weights of the activity breakdown */
+    ProfileEnergy_Init(energyCoefficients, sizeof(energyCoefficients) / sizeof(energyCoefficients[0]),
+                       ENERGY_SUPPLY_MV);
+    #if defined(PROFILE_ENERGY_CALIBRATE)
+        printf ("    Energy calibration - measure the supply current of each workload\n\r");
+        printf ("    CPU workload running\n\r");
+        StdoutRing_Flush();
+        (void) ProfileEnergy_Calibrate(CPUSS_MONITOR_CM4, CY_PROFILE_DURATION, &CalibrateCpuLoad,
+                                       CALIBRATE_REPEAT, CALIBRATE_CM4_UA);
+        printf ("    UART workload running\n\r");
+        StdoutRing_Flush();
+        (void) ProfileEnergy_Calibrate(SCB5_MONITOR_AHB, CY_PROFILE_EVENT, &CalibrateUartLoad,
+                                       CALIBRATE_REPEAT, CALIBRATE_SCB5_UA);
+        printf ("\n\r    Energy coefficients:\n\r");
+        ProfileEnergy_PrintTable();
+    #endif
+    ProfileEnergy_Weigh(activityMonitors, energyMonitors, PROFILE_PRFL_CNT_NR);
+    printf ("    Profile Module - Energy weights of %u monitors - Done\n\r", PROFILE_PRFL_CNT_NR);
+
     /* Initialize counter handle. */
     cy_profiler_ctrs[0] = Cy_Profile_ConfigureCounter(SCB5_MONITOR_AHB,CY_PROFILE_EVENT,CY_PROFILE_CLK_HF,WEIGHT_NORM); //SCB5
+    ProfileOverflow_Attach(cy_profiler_ctrs[0]);
     printf ("    Profile Module - Assign SCB5 to Counter[0] - Done\n\r");
 
+    /* Alert when the UART causes more than SCB5_EVENT_BUDGET bus events per window */
+    ProfileOverflow_SetBudget(ProfileOverflow_GetIndex(cy_profiler_ctrs[0]), SCB5_EVENT_BUDGET, &BudgetAlert);
+
     myStatusReturn = Cy_Profile_EnableCounter(cy_profiler_ctrs[0]);
        if (false != myStatusReturn)
         {
             /* insert error handling here*/
         }
 
-    printf ("    Profile Module - Set enabled for Profile Counter[0] - Done\n\n\r");
+    printf ("    Profile Module - Set enabled for Profile Counter[0] - Done\n\r");
+
+    /* CPU cost of the same accesses, in CM4 clock cycles */
+    cy_profiler_ctrs[1] = Cy_Profile_ConfigureCounter(CPUSS_MONITOR_CM4,CY_PROFILE_DURATION,CY_PROFILE_CLK_HF,WEIGHT_NORM);
+    ProfileOverflow_Attach(cy_profiler_ctrs[1]);
+    (void) Cy_Profile_EnableCounter(cy_profiler_ctrs[1]);
+    printf ("    Profile Module - Assign CM4 cycles to Counter[1] - Done\n\n\r");
+
+    /* Regions count the SCB5 events of the leg that runs */
+    ProfileRegion_SetCounters(&cy_profiler_ctrs[0], 1u);
+
+    /* Every measured leg switches to its backend and restores the selected one after, interrupt first */
+    ProfileBackend_Set(PROFILE_BACKEND_IRQ);
 
     /* Run a series of tests (30 by default) myTestNumb */
     for(myLoopCount = 1u; myLoopCount < myTestNumb; myLoopCount++)
@@ -194,11 +467,14 @@ int main(void)
         /*******************************************************************************/
         printf ("************  Monitoring UART in Interrupt Mode  *********************\n\r");
         /*******************************************************************************/
-        /* Start the Profiler measuring */
+        /* The header must be sent before the measurement starts */
+        ProfileBackend_Drain();
         Cy_Profile_StartProfiling();
 
         /* We are measuring these accesses to UART */
+        PROFILE_REGION_BEGIN("Interrupt printf");
         printf("%*c", myLoopCount, myString[myLoopCount] );  //prints myLoopCount-1 blanks followed by the character at TestCharBuf[i]
+        PROFILE_REGION_END();
 
         Cy_Profile_StopProfiling();
         /*******************************************************************************/
@@ -208,19 +484,27 @@ int main(void)
             {
                 /* insert error handling here*/
             }
+        (void) Cy_Profile_GetRawCount(cy_profiler_ctrs[1], &my_Profile_current_raw_value[1]);
+        RECORD_SAMPLE(0u, SCB5_MONITOR_AHB, PROFILE_SAMPLE_RAW, my_Profile_current_raw_value[0]);
+        RECORD_SAMPLE(1u, CPUSS_MONITOR_CM4, PROFILE_SAMPLE_RAW, my_Profile_current_raw_value[1]);
         printf ("\r\n\nSCB5 Profile counter[0] total for %02d characters  =  %018lld", myLoopCount+1,my_Profile_current_raw_value[0]);
+        printf ("\n\rCM4 cycles  counter[1] total for %02d characters  =  %018lld", myLoopCount+1,my_Profile_current_raw_value[1]);
         printf ("\033[18;H");  /* <ESC>[23;H - ANSI ESC sequence for Cursor Home + 18 lines down*/
         Cy_Profile_ClearCounters();
+        ProfileOverflow_Clear();
     }
 
+    ProfileBackend_Set(ProfileBackend_Get());
+    myModeEvents[0] = my_Profile_current_raw_value[0];
+    myModeCycles[0] = my_Profile_current_raw_value[1];
+
     /* set up for the next test */
     printf ("\033[23;H");  /* <ESC>[23;H - ANSI ESC sequence for Cursor Home + 23 lines down*/
 
     Cy_GPIO_Set(P0_3_PORT, P0_3_NUM); /* Turn off RED LED pin */
 
-    /* Disable the UART interrupt, this test uses polling */
-    UartUsesIRQ = false;
-    printf ("    UART interrupt - Disabled\n\r");
+    /* The next test uses polling */
+    printf ("    UART interrupt - Disabled for the polling test\n\r");
 
     /* disable the original counter */
     myStatusReturn = Cy_Profile_DisableCounter(cy_profiler_ctrs[0]);
@@ -228,6 +512,8 @@ int main(void)
         {
             /* insert error handling here*/
         }
+    (void) Cy_Profile_DisableCounter(cy_profiler_ctrs[1]);
+    ProfileOverflow_SetBudget(ProfileOverflow_GetIndex(cy_profiler_ctrs[0]), 0u, NULL);
     printf ("    Profile Module - Disable Profile Counter[0] - Done\n\r");
 
     /* Clear the Profile configuration as good practice. */
@@ -236,11 +522,19 @@ int main(void)
 
     /* Configure the counter, use a different counter just for demonstration */
     cy_profiler_ctrs[3] = Cy_Profile_ConfigureCounter(SCB5_MONITOR_AHB,CY_PROFILE_EVENT,CY_PROFILE_CLK_HF,WEIGHT_NORM); //
+    ProfileOverflow_Attach(cy_profiler_ctrs[3]);
     printf ("    Profile Module - Assign SCB5 to Counter[3] - Done\n\r");
 
     /* Enable the new counter */
     Cy_Profile_EnableCounter(cy_profiler_ctrs[3]);
-    printf ("    Profile Module - Set enabled for Profile Counter[3] - Done\n\n\r");
+    printf ("    Profile Module - Set enabled for Profile Counter[3] - Done\n\r");
+
+    cy_profiler_ctrs[4] = Cy_Profile_ConfigureCounter(CPUSS_MONITOR_CM4,CY_PROFILE_DURATION,CY_PROFILE_CLK_HF,WEIGHT_NORM);
+    ProfileOverflow_Attach(cy_profiler_ctrs[4]);
+    (void) Cy_Profile_EnableCounter(cy_profiler_ctrs[4]);
+    printf ("    Profile Module - Assign CM4 cycles to Counter[4] - Done\n\n\r");
+    ProfileRegion_SetCounters(&cy_profiler_ctrs[3], 1u);
+    ProfileBackend_Set(PROFILE_BACKEND_POLLING);
 
     /* Run a series of tests (30 by default) */
     for(myLoopCount = 1u; myLoopCount < myTestNumb; myLoopCount++)
@@ -251,11 +545,14 @@ int main(void)
        /*******************************************************************************/
        printf ("**************  Monitoring UART in Polling Mode  *********************\n\r");
        /*******************************************************************************/
-        /* Start the Profiler measuring */
+        /* The header must be sent before the measurement starts */
+        ProfileBackend_Drain();
         Cy_Profile_StartProfiling();
 
         /* We are measuring these accesses to UART */
+        PROFILE_REGION_BEGIN("Polling printf");
         printf("%*c", myLoopCount, myString[myLoopCount] );  //prints myLoopCount-1 blanks followed by the character at TestCharBuf[i]
+        PROFILE_REGION_END();
 
         Cy_Profile_StopProfiling();
         /*******************************************************************************/
@@ -266,14 +563,239 @@ int main(void)
                 /* insert error handling here*/
             }
 
+        (void) Cy_Profile_GetRawCount(cy_profiler_ctrs[4], &my_Profile_current_raw_value[4]);
+        RECORD_SAMPLE(3u, SCB5_MONITOR_AHB, PROFILE_SAMPLE_RAW, my_Profile_current_raw_value[3]);
+        RECORD_SAMPLE(4u, CPUSS_MONITOR_CM4, PROFILE_SAMPLE_RAW, my_Profile_current_raw_value[4]);
         printf ("\n\r\nSCB5 Profile counter[3] total for %02d characters  =  %018lld", myLoopCount+1,my_Profile_current_raw_value[3]);
+        printf ("\n\rCM4 cycles  counter[4] total for %02d characters  =  %018lld", myLoopCount+1,my_Profile_current_raw_value[4]);
 
         printf ("\033[29;H");  /* <ESC>[23;H - ANSI ESC sequence for Cursor Home + 29 lines down*/
         Cy_Profile_ClearCounters();
+        ProfileOverflow_Clear();
+    }
+
+    ProfileBackend_Set(ProfileBackend_Get());
+    myModeEvents[1] = my_Profile_current_raw_value[3];
+    myModeCycles[1] = my_Profile_current_raw_value[4];
+
+    /* disable the polling counters */
+    (void) Cy_Profile_DisableCounter(cy_profiler_ctrs[3]);
+    (void) Cy_Profile_DisableCounter(cy_profiler_ctrs[4]);
+    Cy_Profile_ClearConfiguration();
+
+    /* Third stdout mode: the DMA backend of my_retarget.c */
+    printf ("\033[35;H");  /* <ESC>[35;H - ANSI ESC sequence for Cursor Home + 35 lines down*/
+    cy_profiler_ctrs[5] = Cy_Profile_ConfigureCounter(SCB5_MONITOR_AHB,CY_PROFILE_EVENT,CY_PROFILE_CLK_HF,WEIGHT_NORM);
+    ProfileOverflow_Attach(cy_profiler_ctrs[5]);
+    cy_profiler_ctrs[6] = Cy_Profile_ConfigureCounter(CPUSS_MONITOR_CM4,CY_PROFILE_DURATION,CY_PROFILE_CLK_HF,WEIGHT_NORM);
+    ProfileOverflow_Attach(cy_profiler_ctrs[6]);
+    (void) Cy_Profile_EnableCounter(cy_profiler_ctrs[5]);
+    (void) Cy_Profile_EnableCounter(cy_profiler_ctrs[6]);
+    ProfileRegion_SetCounters(&cy_profiler_ctrs[5], 1u);
+    ProfileBackend_Set(PROFILE_BACKEND_DMA);
+
+    /* Run a series of tests (30 by default) */
+    for(myLoopCount = 1u; myLoopCount < myTestNumb; myLoopCount++)
+    {
+        /* Start things running. Toggle the GREEN led for this test */
+        Cy_GPIO_Inv(P1_1_PORT, P1_1_NUM);  /* toggle the GREEN LED */
+
+        /*******************************************************************************/
+        printf ("****************  Monitoring UART in DMA Mode  ***********************\n\r");
+        /*******************************************************************************/
+        /* The header must be sent before the measurement starts */
+        ProfileBackend_Drain();
+        Cy_Profile_StartProfiling();
+
+        /* We are measuring these accesses to UART */
+        PROFILE_REGION_BEGIN("DMA total");
+        PROFILE_REGION_BEGIN("DMA printf");
+        printf("%*c", myLoopCount, myString[myLoopCount] );  //prints myLoopCount-1 blanks followed by the character at TestCharBuf[i]
+        PROFILE_REGION_END();
+
+        /* The CPU is done when printf returns, the DMA still moves the data. The
+         * wait reads the ring indexes in RAM only, polling the SCB would add
+         * SCB5 events and cycles to the DMA backend.
+         */
+        (void) Cy_Profile_GetRawCount(cy_profiler_ctrs[6], &my_Profile_current_raw_value[6]);
+        PROFILE_REGION_BEGIN("DMA flush");
+        while (false == StdoutRing_IsEmpty())
+        {
+        }
+        PROFILE_REGION_END();
+        PROFILE_REGION_END();
+
+        Cy_Profile_StopProfiling();
+        /*******************************************************************************/
+
+        (void) Cy_Profile_GetRawCount(cy_profiler_ctrs[5], &my_Profile_current_raw_value[5]);
+        RECORD_SAMPLE(5u, SCB5_MONITOR_AHB, PROFILE_SAMPLE_RAW, my_Profile_current_raw_value[5]);
+        RECORD_SAMPLE(6u, CPUSS_MONITOR_CM4, PROFILE_SAMPLE_RAW, my_Profile_current_raw_value[6]);
+        printf ("\n\r\nSCB5 Profile counter[5] total for %02d characters  =  %018lld", myLoopCount+1,my_Profile_current_raw_value[5]);
+        printf ("\n\rCM4 cycles  counter[6] total for %02d characters  =  %018lld", myLoopCount+1,my_Profile_current_raw_value[6]);
+
+        printf ("\033[35;H");  /* <ESC>[35;H - ANSI ESC sequence for Cursor Home + 35 lines down*/
+        Cy_Profile_ClearCounters();
+        ProfileOverflow_Clear();
+    }
+    myModeEvents[2] = my_Profile_current_raw_value[5];
+    myModeCycles[2] = my_Profile_current_raw_value[6];
+
+    ProfileBackend_Set(ProfileBackend_Get());
+    (void) Cy_Profile_DisableCounter(cy_profiler_ctrs[5]);
+    (void) Cy_Profile_DisableCounter(cy_profiler_ctrs[6]);
+    Cy_Profile_ClearConfiguration();
+
+    /* Compare the three modes for the longest string */
+    printf ("\033[41;H");  /* <ESC>[41;H - ANSI ESC sequence for Cursor Home + 41 lines down*/
+    printf ("    %-10s %18s %18s %14s %14s\n\r", "Mode", "SCB5 events", "CM4 cycles", "Cycles/char", "Energy nJ");
+    for (myCounter = 0u; myCounter < 3u; myCounter++)
+    {
+        myEnergy = (myModeEvents[myCounter] * ProfileEnergy_GetWeight(SCB5_MONITOR_AHB)) +
+                   (myModeCycles[myCounter] * ProfileEnergy_GetWeight(CPUSS_MONITOR_CM4));
+        printf ("    %-10s %018lld %018lld %14lu %14lu\n\r", myModeName[myCounter], myModeEvents[myCounter],
+                myModeCycles[myCounter], (uint32_t)(myModeCycles[myCounter] / (myTestNumb - 1u)),
+                (uint32_t)(myEnergy / 1000u));
+    }
+
+    /* The same legs seen by the scoped regions, Counter0 counts SCB5 events */
+    printf ("\n\r");
+    ProfileRegion_Print();
+
+    /*******************************************************************************/
+    printf ("\n\n\r**********  Activity Breakdown in %s Mode (1 session)  *********\n\r", SESSION_BACKEND_NAME);
+    /*******************************************************************************/
+    if (PROFILE_SESSION_SUCCESS == ProfileSession_Open(&mySession, energyMonitors, PROFILE_PRFL_CNT_NR))
+    {
+        ProfileBackend_Set(SESSION_BACKEND);
+        ProfileBackend_Drain();
+        ProfileSession_Start(&mySession);
+
+        /* We are measuring these accesses, same string as the last test */
+        printf("%*c", myTestNumb - 1, myString[myTestNumb - 1] );
+
+        ProfileSession_Stop(&mySession);
+        ProfileBackend_Set(ProfileBackend_Get());
+
+        (void) ProfileSession_GetResults(&mySession, myResults, &myWeightedSum);
+        for (myCounter = 0u; myCounter < PROFILE_PRFL_CNT_NR; myCounter++)
+        {
+            RECORD_SAMPLE(myCounter, myResults[myCounter].monitor, PROFILE_SAMPLE_WEIGHTED, myResults[myCounter].weightedCount);
+        }
+        printf ("\n\r");
+        ProfileSession_PrintResults(myResults, PROFILE_PRFL_CNT_NR, myWeightedSum,
+                                    ProfileSession_GetCycles(&mySession));
+        printf ("\n\r");
+        ProfileEnergy_PrintResults(myResults, PROFILE_PRFL_CNT_NR, ProfileSession_GetCycles(&mySession));
+        ProfileSession_Close(&mySession);
+    }
+    else
+    {
+        printf ("    Profile Module - Session could not get all counters\n\r");
     }
 
+    /*******************************************************************************/
+    printf ("\n\n\r**********  Activity over Time (%lu us per line)  *****************\n\r", SAMPLER_PERIOD_US);
+    /*******************************************************************************/
+    ProfileSampler_Init(samplerRing, SAMPLER_DEPTH, SAMPLER_PERIOD_US);
+    if (PROFILE_SESSION_SUCCESS == ProfileSession_Open(&mySession, activityMonitors, PROFILE_PRFL_CNT_NR))
+    {
+        ProfileBackend_Set(SESSION_BACKEND);
+        ProfileSampler_Start(&mySession);
+
+        /* Same string again, this time seen period by period */
+        printf("%*c", myTestNumb - 1, myString[myTestNumb - 1] );
+
+        ProfileSampler_Stop();
+        ProfileBackend_Set(ProfileBackend_Get());
+
+        printf ("\n\r    Tick ");
+        for (myCounter = 0u; myCounter < PROFILE_PRFL_CNT_NR; myCounter++)
+        {
+            printf ("%8.8s ", activityMonitors[myCounter].label);
+        }
+        printf ("\n\r");
+        while (ProfileSampler_Read(&myEntry))
+        {
+            printf ("    %4lu ", myEntry.tick);
+            for (myCounter = 0u; myCounter < PROFILE_PRFL_CNT_NR; myCounter++)
+            {
+                printf ("%8lu ", myEntry.count[myCounter]);
+            }
+            printf ("\n\r");
+        }
+        printf ("    Periods lost: %lu\n\r", ProfileSampler_GetOverruns());
+        ProfileSession_Close(&mySession);
+    }
+    else
+    {
+        printf ("    Profile Module - Session could not get all counters\n\r");
+    }
+
+    /*******************************************************************************/
+    printf ("\n\n\r**********  Hot Spots by PC Sampling (%lu us period)  ***************\n\r", PC_SAMPLE_PERIOD_US);
+    /*******************************************************************************/
+    ProfilePc_Init(pcHistogram, PC_SAMPLE_SLOTS, PC_SAMPLE_PERIOD_US);
+    ProfileBackend_Set(SESSION_BACKEND);
+    ProfilePc_Start();
+    for (myCounter = 0u; myCounter < PC_SAMPLE_REPEAT; myCounter++)
+    {
+        printf("%*c", myTestNumb - 1, myString[myTestNumb - 1] );
+    }
+    ProfilePc_Stop();
+    ProfileBackend_Set(ProfileBackend_Get());
+    printf ("\n\r");
+    ProfilePc_Print();
+
+    #if defined(PROFILE_TRACE)
+        /*******************************************************************************/
+        printf ("\n\n\r**********  Function Trace (-finstrument-functions)  ****************\n\r");
+        /*******************************************************************************/
+        ProfileTrace_Init(traceRing, TRACE_DEPTH);
+        ProfileBackend_Set(SESSION_BACKEND);
+        ProfileTrace_Start();
+        printf("%*c", myTestNumb - 1, myString[myTestNumb - 1] );
+        ProfileTrace_Stop();
+        ProfileBackend_Set(ProfileBackend_Get());
+        printf ("\n\r");
+        ProfileTrace_Print();
+    #endif /* (PROFILE_TRACE) */
+
+    #if defined(PROFILE_BINARY_SAMPLES)
+        printf ("\n\n\r    Binary samples follow: %lu recorded, %lu dropped\n\r",
+                (unsigned long)profileSamples.count, (unsigned long)profileSamples.dropped);
+        (void) ProfileSample_Stream(&profileSamples);
+    #endif
+
+    /* Overflow statistics of the hardware counters over the whole run */
+    printf ("\n\r    %-8s %10s %20s %14s\n\r", "Counter", "Overflows", "Longest interval us", "Over budget");
+    for (myCounter = 0u; myCounter < PROFILE_PRFL_CNT_NR; myCounter++)
+    {
+        ProfileOverflow_GetStats(myCounter, &myOverflowStats);
+        printf ("    %-8u %10lu %20lu %14lu\n\r", myCounter, myOverflowStats.overflows,
+                (uint32_t)myOverflowStats.longestIntervalUs, myOverflowStats.budgetExceeded);
+    }
+    printf ("    SCB5 budget alerts: %lu\n\r", budgetAlerts);
+
+    /* Compare the three modes with the baseline of an earlier run */
+    printf ("\n\n\r**********  Regression Check Against the Stored Baseline  *********\n\r");
+    if (false == ProfileBaseline_Load(ProfileBaselinePort_Get()))
+    {
+        printf ("    No valid baseline in flash, this run creates it\n\r");
+    }
+    for (myCounter = 0u; myCounter < 3u; myCounter++)
+    {
+        (void) ProfileBaseline_Check(myBaselineName[myCounter][0], myModeEvents[myCounter], BASELINE_TOLERANCE_PCT);
+        (void) ProfileBaseline_Check(myBaselineName[myCounter][1], myModeCycles[myCounter], BASELINE_TOLERANCE_PCT);
+    }
+    if (0 != ProfileBaseline_Commit(BASELINE_REBASELINE))
+    {
+        printf ("    Flash write of the baseline failed\n\r");
+    }
+    ProfileBaseline_Print();
+
     /* Demonstration completed */
-    printf ("\n\n\n\n\n\n\r******** This run has completed - press Reset to restart ********\n\r");
+    printf ("\n\n\r******** This run has completed - press Reset to restart ********\n\r");
 
     /* disable the NVIC interrupt */
     #if defined(PROFILE_USE_IRQ)
@@ -281,7 +803,14 @@ int main(void)
     #endif
 
     Cy_GPIO_Set(P11_1_PORT, P11_1_NUM);  /* Turn off BLUE LED  */
-    Cy_GPIO_Set(P0_3_PORT, P0_3_NUM);    /* Turn off RED LED   */
+    if (ProfileBaseline_Passed())
+    {
+        Cy_GPIO_Set(P0_3_PORT, P0_3_NUM);    /* Turn off RED LED   */
+    }
+    else
+    {
+        Cy_GPIO_Clr(P0_3_PORT, P0_3_NUM);    /* RED LED on, a count regressed */
+    }
     while (1)  /* all done with example code stick here and blink green LED  */
     {
         Cy_GPIO_Inv(P1_1_PORT, P1_1_NUM); /* Toggle the GREEN LED */
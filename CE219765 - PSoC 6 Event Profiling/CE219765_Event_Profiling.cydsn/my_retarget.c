@@ -16,12 +16,14 @@
 #include <stdio.h>
 #include "my_stdio_user.h"
 #include "UART.h"
+#include "my_stdout_ring.h"
 
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
 bool UartUsesIRQ;
+bool UartUsesDma;
 /******************************************************************************
 * Function Name: stdio write
 *******************************************************************************
@@ -50,6 +52,16 @@ bool UartUsesIRQ;
         file = file; /* Suppress compiler warning about unused variable. */
 
     /******************************************************************************
+    * The DMA backend copies into the TX ring and returns, the DataWire
+    * channel sends the data in the background. Set UartUsesDma only after
+    * StdoutRing_Init() and call StdoutRing_Flush() before clearing it.
+    *******************************************************************************/
+        if (true == UartUsesDma)
+        {
+            StdoutRing_Write((const uint8_t *)data, (uint32_t)len);
+            return (len);
+        }
+    /******************************************************************************
     * Check if interrupt for SBC are enabled in component.
     * myUart_uses_IRQ will be defined globally in main.c
     * if internal interrupt are selected in the PSoC UART component
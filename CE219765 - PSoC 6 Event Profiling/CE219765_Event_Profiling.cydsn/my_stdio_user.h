@@ -89,6 +89,7 @@
 #include <stdbool.h>
 
 extern bool UartUsesIRQ;
+extern bool UartUsesDma;
 
 /* Must remain uncommented to use this utility */
 #define IO_STDOUT_ENABLE
@@ -0,0 +1,302 @@
+/***************************************************************************//**
+* \file my_stdout_ring.c
+* \version 1.0
+*
+* \brief
+* TX ring of the DMA stdout backend.
+*
+* The ring has one writer (_write in thread mode) and one reader (the DMA
+* channel and its completion ISR). ringHead and ringTail run freely and are
+* only written by their owner, so copying into the ring needs no lock. Only
+* handing a chunk to the DMA, and the overwrite policy, run in a short
+* critical section. A chunk is the contiguous part of the ring after
+* ringTail, at most CY_DMA_MAX_XCOUNT bytes; the TX FIFO trigger moves one
+* byte per request and the channel disables itself at the end of the chunk.
+* With STDOUT_RING_BLOCK, do not print from an ISR of higher priority than
+* STDOUT_DMA_INTR_PRIORITY or with interrupts disabled.
+*
+********************************************************************************
+* \copyright
+* Copyright 2016-2017, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "my_stdio_user.h"
+#include "my_stdout_ring.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define STDOUT_RING_MASK    (STDOUT_RING_SIZE - 1u)
+
+static void StdoutRing_Kick(void);
+static void StdoutRing_Complete(void);
+
+static uint8_t ringData[STDOUT_RING_SIZE];
+static volatile uint32_t ringHead;      /* Written by _write */
+static volatile uint32_t ringTail;      /* Written by the DMA ISR */
+static volatile uint32_t ringBusy;      /* Bytes after ringTail handed to the DMA */
+static volatile uint32_t ringDropped;
+static stdout_ring_policy_t ringPolicy;
+static cy_stc_dma_descriptor_t ringDescriptor;
+
+/*******************************************************************************
+* Function Name: StdoutRing_Init
+****************************************************************************//**
+*
+* Connects the UART TX FIFO trigger to the channel, initializes the channel
+* and its completion interrupt. Call after UART_Start().
+*
+* \param policy  What to do when the ring is full
+*
+*******************************************************************************/
+void StdoutRing_Init(stdout_ring_policy_t policy)
+{
+    const cy_stc_dma_descriptor_config_t descriptorConfig =
+    {
+        .retrigger       = CY_DMA_WAIT_FOR_REACT,
+        .interruptType   = CY_DMA_DESCR,
+        .triggerOutType  = CY_DMA_1ELEMENT,
+        .channelState    = CY_DMA_CHANNEL_DISABLED,
+        .triggerInType   = CY_DMA_1ELEMENT,
+        .dataSize        = CY_DMA_BYTE,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .descriptorType  = CY_DMA_1D_TRANSFER,
+        .srcAddress      = (void *) ringData,
+        .dstAddress      = (void *) &IO_STDIO_UART_NUMBER->TX_FIFO_WR,
+        .srcXincrement   = 1,
+        .dstXincrement   = 0,
+        .xCount          = 1uL,
+        .srcYincrement   = 0,
+        .dstYincrement   = 0,
+        .yCount          = 1uL,
+        .nextDescriptor  = NULL
+    };
+
+    const cy_stc_dma_channel_config_t channelConfig =
+    {
+        .descriptor  = &ringDescriptor,
+        .preemptable = false,
+        .priority    = 3u,
+        .enable      = false,
+        .bufferable  = false
+    };
+
+    const cy_stc_sysint_t intrConfig =
+    {
+        .intrSrc      = STDOUT_DMA_INTR_SRC,
+        .intrPriority = STDOUT_DMA_INTR_PRIORITY
+    };
+
+    ringHead = 0u;
+    ringTail = 0u;
+    ringBusy = 0u;
+    ringDropped = 0u;
+    ringPolicy = policy;
+
+    /* Request data while the TX FIFO is less than half full */
+    Cy_SCB_UART_SetTxFifoLevel(IO_STDIO_UART_NUMBER, Cy_SCB_GetFifoSize(IO_STDIO_UART_NUMBER) / 2u);
+    (void) Cy_TrigMux_Connect(STDOUT_DMA_TR_SCB, STDOUT_DMA_TR_GROUP_OUT, false, TRIGGER_TYPE_LEVEL);
+    (void) Cy_TrigMux_Connect(STDOUT_DMA_TR_GROUP_IN, STDOUT_DMA_TR_DW, false, TRIGGER_TYPE_LEVEL);
+
+    (void) Cy_DMA_Descriptor_Init(&ringDescriptor, &descriptorConfig);
+    (void) Cy_DMA_Channel_Init(STDOUT_DMA_HW, STDOUT_DMA_CHANNEL, &channelConfig);
+    Cy_DMA_Channel_SetInterruptMask(STDOUT_DMA_HW, STDOUT_DMA_CHANNEL, CY_DMA_INTR_MASK);
+    Cy_DMA_Enable(STDOUT_DMA_HW);
+
+    (void) Cy_SysInt_Init(&intrConfig, &StdoutRing_Complete);
+    NVIC_EnableIRQ(intrConfig.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_SetPolicy
+****************************************************************************//**
+*
+* Changes what StdoutRing_Write() does when the ring is full.
+*
+*******************************************************************************/
+void StdoutRing_SetPolicy(stdout_ring_policy_t policy)
+{
+    ringPolicy = policy;
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_Write
+****************************************************************************//**
+*
+* Copies data into the ring and starts the DMA if it is idle. Returns as
+* soon as the data is in the ring, except with STDOUT_RING_BLOCK when the
+* ring is full.
+*
+* \param data  Bytes to send
+* \param size  Number of bytes
+*
+*******************************************************************************/
+void StdoutRing_Write(const uint8_t data[], uint32_t size)
+{
+    uint32_t head = ringHead;
+    uint32_t space;
+    uint32_t chunk;
+    uint32_t start;
+    uint32_t index;
+    uint32_t interruptState;
+
+    while (0u != size)
+    {
+        space = STDOUT_RING_SIZE - (head - ringTail);
+        if ((space < size) && (STDOUT_RING_OVERWRITE == ringPolicy))
+        {
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            if (size > (STDOUT_RING_SIZE - ringBusy))
+            {
+                /* Only the end of the data fits next to the chunk in flight */
+                chunk = size - (STDOUT_RING_SIZE - ringBusy);
+                data = &data[chunk];
+                size -= chunk;
+                ringDropped += chunk;
+            }
+            space = STDOUT_RING_SIZE - (head - ringTail);
+            if (space < size)
+            {
+                /* Drop the oldest bytes not handed to the DMA yet */
+                chunk = size - space;
+                for (index = ringTail + ringBusy + chunk; index != head; index++)
+                {
+                    ringData[(index - chunk) & STDOUT_RING_MASK] = ringData[index & STDOUT_RING_MASK];
+                }
+                head -= chunk;
+                ringHead = head;
+                ringDropped += chunk;
+                space += chunk;
+            }
+            Cy_SysLib_ExitCriticalSection(interruptState);
+        }
+
+        chunk = (space < size) ? space : size;
+        start = head & STDOUT_RING_MASK;
+        if (chunk > (STDOUT_RING_SIZE - start))
+        {
+            (void) memcpy(&ringData[start], data, STDOUT_RING_SIZE - start);
+            (void) memcpy(ringData, &data[STDOUT_RING_SIZE - start], chunk - (STDOUT_RING_SIZE - start));
+        }
+        else
+        {
+            (void) memcpy(&ringData[start], data, chunk);
+        }
+        head += chunk;
+        ringHead = head;
+        data = &data[chunk];
+        size -= chunk;
+
+        if (0u == ringBusy)
+        {
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            StdoutRing_Kick();
+            Cy_SysLib_ExitCriticalSection(interruptState);
+        }
+
+        if ((0u != size) && (STDOUT_RING_DROP == ringPolicy))
+        {
+            ringDropped += size;
+            size = 0u;
+        }
+        /* STDOUT_RING_BLOCK loops until the DMA ISR frees space */
+    }
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_Flush
+****************************************************************************//**
+*
+* Waits until the ring is empty and the UART has sent the last bit.
+*
+*******************************************************************************/
+void StdoutRing_Flush(void)
+{
+    while (ringTail != ringHead)
+    {
+    }
+    while (false == Cy_SCB_UART_IsTxComplete(IO_STDIO_UART_NUMBER))
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_IsEmpty
+****************************************************************************//**
+*
+* Returns true when the DMA has taken every byte of the ring. The UART may
+* still be sending the last ones, see Cy_SCB_UART_IsTxComplete().
+*
+*******************************************************************************/
+bool StdoutRing_IsEmpty(void)
+{
+    return (ringTail == ringHead);
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_GetDropped
+****************************************************************************//**
+*
+* Returns the number of bytes dropped because the ring was full.
+*
+*******************************************************************************/
+uint32_t StdoutRing_GetDropped(void)
+{
+    return ringDropped;
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_Kick
+****************************************************************************//**
+*
+* Hands the next chunk to the DMA when it is idle. Runs in the DMA ISR or in
+* a critical section.
+*
+*******************************************************************************/
+static void StdoutRing_Kick(void)
+{
+    uint32_t pending = ringHead - ringTail;
+    uint32_t start = ringTail & STDOUT_RING_MASK;
+    uint32_t chunk;
+
+    if ((0u == ringBusy) && (0u != pending))
+    {
+        chunk = STDOUT_RING_SIZE - start;
+        chunk = (pending < chunk) ? pending : chunk;
+        chunk = (CY_DMA_MAX_XCOUNT < chunk) ? CY_DMA_MAX_XCOUNT : chunk;
+
+        Cy_DMA_Descriptor_SetSrcAddress(&ringDescriptor, &ringData[start]);
+        Cy_DMA_Descriptor_SetXloopDataCount(&ringDescriptor, chunk);
+        ringBusy = chunk;
+        Cy_DMA_Channel_SetDescriptor(STDOUT_DMA_HW, STDOUT_DMA_CHANNEL, &ringDescriptor);
+        Cy_DMA_Channel_Enable(STDOUT_DMA_HW, STDOUT_DMA_CHANNEL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: StdoutRing_Complete
+****************************************************************************//**
+*
+* DMA ISR, releases the chunk that was sent and starts the next one.
+*
+*******************************************************************************/
+static void StdoutRing_Complete(void)
+{
+    Cy_DMA_Channel_ClearInterrupt(STDOUT_DMA_HW, STDOUT_DMA_CHANNEL);
+    ringTail += ringBusy;
+    ringBusy = 0u;
+    StdoutRing_Kick();
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+
+/* [] END OF FILE */
@@ -0,0 +1,68 @@
+/***************************************************************************//**
+* \file my_stdout_ring.h
+* \version 1.0
+*
+* \brief
+* TX ring of the DMA stdout backend. _write() copies into the ring and
+* returns; a DataWire channel triggered by the UART TX FIFO drains it.
+*
+********************************************************************************
+* \copyright
+* Copyright 2016-2017, Cypress Semiconductor Corporation. All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#ifndef _STDOUT_RING_H_
+#define _STDOUT_RING_H_
+
+#include "cy_device_headers.h"
+#include <stdbool.h>
+
+/* Size of the TX ring in bytes, must be a power of 2 */
+#define STDOUT_RING_SIZE            (1024u)
+
+/* DataWire channel of the backend. It is configured in firmware and must
+*  not be used by the design.
+*/
+#define STDOUT_DMA_HW               (DW1)
+#define STDOUT_DMA_CHANNEL          (15u)
+#define STDOUT_DMA_INTR_SRC         (cpuss_interrupts_dw1_15_IRQn)
+#define STDOUT_DMA_INTR_PRIORITY    (4u)
+
+/* Route of the SCB5 TX FIFO trigger to the channel through the trigger
+*  multiplexer, see the trigger tables of the device.
+*/
+#define STDOUT_DMA_TR_SCB           (TRIG13_IN_SCB5_TR_TX_REQ)
+#define STDOUT_DMA_TR_GROUP_OUT     (TRIG13_OUT_TR_GROUP1_INPUT42)
+#define STDOUT_DMA_TR_GROUP_IN      (TRIG1_IN_TR_GROUP13_OUTPUT10)
+#define STDOUT_DMA_TR_DW            (TRIG1_OUT_CPUSS_DW1_TR_IN15)
+
+/* What _write() does when the ring has no room for the data */
+typedef enum
+{
+    STDOUT_RING_DROP      = 0u,  /* The bytes that do not fit are dropped */
+    STDOUT_RING_BLOCK     = 1u,  /* Wait until the DMA made room */
+    STDOUT_RING_OVERWRITE = 2u   /* The oldest bytes not yet sent are dropped */
+} stdout_ring_policy_t;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void StdoutRing_Init(stdout_ring_policy_t policy);
+void StdoutRing_SetPolicy(stdout_ring_policy_t policy);
+void StdoutRing_Write(const uint8_t data[], uint32_t size);
+void StdoutRing_Flush(void);
+bool StdoutRing_IsEmpty(void);
+uint32_t StdoutRing_GetDropped(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _STDOUT_RING_H_ */
+
+
+/* [] END OF FILE */
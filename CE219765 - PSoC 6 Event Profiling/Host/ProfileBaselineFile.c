@@ -0,0 +1,120 @@
+/*****************************************************************************
+* File Name: ProfileBaselineFile.c
+*
+* Version 1.0
+*
+* Description: File store of the performance baselines for runs
+* on a host. The file is opened for every access, so a crash of the run
+* cannot leave it half written more than a row write on the device would.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "ProfileBaselineFile.h"
+
+static const char *baselinePath;
+
+static int32_t ProfileBaselineFile_WriteRow(const uint32_t data[PROFILE_BASELINE_ROW_WORDS]);
+static void ProfileBaselineFile_ReadRow(uint32_t data[PROFILE_BASELINE_ROW_WORDS]);
+
+static const profile_baseline_port_t baselineFilePort =
+{
+    .writeRow = &ProfileBaselineFile_WriteRow,
+    .readRow  = &ProfileBaselineFile_ReadRow
+};
+
+/**
+********************************************************************************
+* Function Name: ProfileBaselineFile_Open
+********************************************************************************
+*
+*  Returns the port to pass to ProfileBaseline_Load, the row is stored in
+*  the file at path. The path must stay valid while the port is used
+*******************************************************************************/
+const profile_baseline_port_t * ProfileBaselineFile_Open(const char *path)
+{
+    baselinePath = path;
+    return &baselineFilePort;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaselineFile_WriteRow
+********************************************************************************
+*
+*  Replaces the file by the row
+*******************************************************************************/
+static int32_t ProfileBaselineFile_WriteRow(const uint32_t data[PROFILE_BASELINE_ROW_WORDS])
+{
+    FILE *file = fopen(baselinePath, "wb");
+    int32_t status = -1;
+
+    if (NULL != file)
+    {
+        if (PROFILE_BASELINE_ROW_SIZE == fwrite(data, 1u, PROFILE_BASELINE_ROW_SIZE, file))
+        {
+            status = 0;
+        }
+        if (0 != fclose(file))
+        {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileBaselineFile_ReadRow
+********************************************************************************
+*
+*  Copies the row from the file, a missing or short file reads as erased
+*******************************************************************************/
+static void ProfileBaselineFile_ReadRow(uint32_t data[PROFILE_BASELINE_ROW_WORDS])
+{
+    FILE *file = fopen(baselinePath, "rb");
+
+    (void) memset(data, 0, PROFILE_BASELINE_ROW_SIZE);
+    if (NULL != file)
+    {
+        (void) fread(data, 1u, PROFILE_BASELINE_ROW_SIZE, file);
+        (void) fclose(file);
+    }
+}
+
+/* [] END OF FILE */
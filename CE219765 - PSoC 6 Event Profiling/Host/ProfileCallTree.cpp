@@ -0,0 +1,319 @@
+/*****************************************************************************
+* File Name: ProfileCallTree.cpp
+*
+* Version 1.0
+*
+* Description: Host decoder of the function trace of ProfileTrace.h. It
+* scans a capture of the UART output for the "PFT" lines of ProfileTrace_Print(),
+* pairs every function exit with its entry and prints the call tree and a flat
+* profile with calls, inclusive and exclusive CM4 cycles per function.
+* Interrupt handlers appear under the function they interrupted; their
+* cycles are inclusive cycles of that function, not exclusive ones.
+* Build:
+*  c++ -std=c++11 ProfileCallTree.cpp ProfileSymbols.cpp -o ProfileCallTree
+* Run "ProfileCallTree CE219765_Event_Profiling.elf capture.txt", a .map file
+* works in place of the .elf. Without a capture stdin is read.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "ProfileSymbols.h"
+
+/* Exit flag of the trace addresses, PROFILE_TRACE_EXIT of ProfileTrace.h */
+#define TRACE_EXIT              (0x80000000uL)
+
+/* One call path of the tree, node 0 is the root */
+struct Node
+{
+    uint32_t function;
+    size_t parent;
+    unsigned long calls;
+    uint64_t inclusive;
+    uint64_t exclusive;
+    std::vector<size_t> children;
+};
+
+/* One function call that has not returned yet */
+struct Frame
+{
+    size_t node;
+    uint64_t start;
+    uint64_t children;      /* Inclusive cycles of the calls made by this one */
+};
+
+/* Totals of one function over all its call paths */
+struct Total
+{
+    unsigned long calls;
+    uint64_t inclusive;     /* Outermost calls only, recursion is not counted twice */
+    uint64_t exclusive;
+};
+
+static std::vector<Node> nodes;
+static std::vector<Frame> stack;
+static std::map<uint32_t, Total> totals;
+
+/**
+********************************************************************************
+* Function Name: Enter
+********************************************************************************
+*
+*  Pushes a call of function, under the call on top of the stack
+*******************************************************************************/
+static void Enter(uint32_t function, uint64_t now)
+{
+    size_t parent = stack.empty() ? 0u : stack.back().node;
+    size_t node = 0u;
+    Frame frame;
+
+    for (size_t child : nodes[parent].children)
+    {
+        if (nodes[child].function == function)
+        {
+            node = child;
+        }
+    }
+    if (0u == node)
+    {
+        Node created = { function, parent, 0u, 0u, 0u, std::vector<size_t>() };
+        node = nodes.size();
+        nodes.push_back(created);
+        nodes[parent].children.push_back(node);
+    }
+    frame.node = node;
+    frame.start = now;
+    frame.children = 0u;
+    stack.push_back(frame);
+}
+
+/**
+********************************************************************************
+* Function Name: Leave
+********************************************************************************
+*
+*  Pops the call on top of the stack and adds its cycles to its node, its
+*  caller and the totals of its function
+*******************************************************************************/
+static void Leave(uint64_t now)
+{
+    Frame frame = stack.back();
+    Node &node = nodes[frame.node];
+    uint64_t inclusive = now - frame.start;
+    Total &total = totals[node.function];
+    bool recursive = false;
+
+    stack.pop_back();
+    for (const Frame &outer : stack)
+    {
+        recursive = recursive || (nodes[outer.node].function == node.function);
+    }
+
+    node.calls++;
+    node.inclusive += inclusive;
+    node.exclusive += inclusive - frame.children;
+    total.calls++;
+    total.exclusive += inclusive - frame.children;
+    if (!recursive)
+    {
+        total.inclusive += inclusive;
+    }
+    if (!stack.empty())
+    {
+        stack.back().children += inclusive;
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: PrintNode
+********************************************************************************
+*
+*  Prints a node and, indented, its children with the most cycles first
+*******************************************************************************/
+static void PrintNode(const std::vector<Symbol> &symbols, size_t index, unsigned depth)
+{
+    std::vector<size_t> children = nodes[index].children;
+
+    if (0u != index)
+    {
+        printf("  %8lu %14llu %14llu  %*s%s\n", nodes[index].calls,
+               (unsigned long long)nodes[index].inclusive, (unsigned long long)nodes[index].exclusive,
+               (int)(2u * (depth - 1u)), "", Symbols_Name(symbols, nodes[index].function, false).c_str());
+    }
+    std::stable_sort(children.begin(), children.end(),
+                     [](size_t a, size_t b) { return nodes[a].inclusive > nodes[b].inclusive; });
+    for (size_t child : children)
+    {
+        PrintNode(symbols, child, depth + 1u);
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: main
+********************************************************************************
+*
+*  Decodes the capture given as second argument (or stdin)
+*  Returns 1 when the image or the capture cannot be read or holds no event
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::vector<Symbol> symbols;
+    std::vector<std::pair<uint32_t, Total> > flat;
+    FILE *capture = stdin;
+    char line[256];
+    unsigned long address;
+    unsigned long cycles;
+    unsigned long events = 0u;
+    unsigned long orphans = 0u;
+    unsigned long unwound = 0u;
+    unsigned long open = 0u;
+    uint32_t last = 0u;
+    uint64_t now = 0u;
+
+    if ((argc < 2) || (argc > 3) || (0 == strcmp(argv[1], "--help")))
+    {
+        fprintf(stderr, "Usage: ProfileCallTree image.elf|image.map [capture]\n");
+        return ((argc == 2) && (0 == strcmp(argv[1], "--help"))) ? 0 : 1;
+    }
+    if (!Symbols_Load(argv[1], symbols))
+    {
+        return 1;
+    }
+    fprintf(stderr, "%lu functions in %s\n", (unsigned long)symbols.size(), argv[1]);
+    if (argc == 3)
+    {
+        capture = fopen(argv[2], "rb");
+        if (NULL == capture)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    nodes.push_back(Node());
+    while (NULL != fgets(line, sizeof(line), capture))
+    {
+        /* Terminal escapes may precede the tag */
+        const char *tag = strstr(line, "PFT ");
+        if ((NULL == tag) || (2 != sscanf(tag, "PFT %lx %lx", &address, &cycles)))
+        {
+            continue;
+        }
+
+        /* CYCCNT wraps at 2^32. An event stored late by a preempted hook
+           steps back in time and counts as 0 cycles. */
+        if (0u == events)
+        {
+            last = (uint32_t)cycles;
+        }
+        if ((int32_t)((uint32_t)cycles - last) > 0)
+        {
+            now += (uint32_t)cycles - last;
+            last = (uint32_t)cycles;
+        }
+        events++;
+
+        if (0u == (address & TRACE_EXIT))
+        {
+            Enter((uint32_t)address, now);
+            continue;
+        }
+
+        /* Exit: unwind calls whose exit was not traced, skip exits of calls
+           entered before the oldest event of the ring */
+        address &= ~TRACE_EXIT;
+        size_t depth = stack.size();
+        while ((depth > 0u) && (nodes[stack[depth - 1u].node].function != address))
+        {
+            depth--;
+        }
+        if (0u == depth)
+        {
+            orphans++;
+            continue;
+        }
+        while (stack.size() > depth)
+        {
+            Leave(now);
+            unwound++;
+        }
+        Leave(now);
+    }
+    if (stdin != capture)
+    {
+        fclose(capture);
+    }
+    if (0u == events)
+    {
+        fprintf(stderr, "no PFT lines found\n");
+        return 1;
+    }
+
+    /* Calls still running at the end of the trace end with its last event */
+    while (!stack.empty())
+    {
+        Leave(now);
+        open++;
+    }
+
+    printf("Call tree of %lu events, %llu cycles\n", events, (unsigned long long)now);
+    printf("  %8s %14s %14s  %s\n", "Calls", "Inclusive", "Exclusive", "Function");
+    PrintNode(symbols, 0u, 0u);
+
+    flat.assign(totals.begin(), totals.end());
+    std::stable_sort(flat.begin(), flat.end(),
+                     [](const std::pair<uint32_t, Total> &a, const std::pair<uint32_t, Total> &b)
+                     { return a.second.exclusive > b.second.exclusive; });
+    printf("\nFlat profile\n  %8s %14s %14s  %s\n", "Calls", "Inclusive", "Exclusive", "Function");
+    for (const std::pair<uint32_t, Total> &entry : flat)
+    {
+        printf("  %8lu %14llu %14llu  %s\n", entry.second.calls, (unsigned long long)entry.second.inclusive,
+               (unsigned long long)entry.second.exclusive, Symbols_Name(symbols, entry.first, false).c_str());
+    }
+
+    fprintf(stderr, "%lu exits without entry, %lu calls without exit, %lu still running\n",
+            orphans, unwound, open);
+    return 0;
+}
+
+/* [] END OF FILE */
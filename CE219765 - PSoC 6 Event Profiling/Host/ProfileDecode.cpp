@@ -0,0 +1,158 @@
+/*****************************************************************************
+* File Name: ProfileDecode.cpp
+*
+* Version 1.0
+*
+* Description: Host decoder of the binary profile samples of
+* ProfileSample.h. It scans a capture of the UART output (terminal text and
+* samples mixed) for the sync byte, keeps every 16-byte window whose CRC
+* matches and writes one CSV line per sample. Sequence gaps and rejected
+* sync bytes are reported on stderr.
+* Build:
+*  cc -c ../CE219765_Event_Profiling.cydsn/ProfileSample.c
+*  c++ -std=c++11 -I../CE219765_Event_Profiling.cydsn ProfileDecode.cpp
+*      ProfileSample.o -o ProfileDecode
+* Run "ProfileDecode capture.bin > samples.csv", or without a file to read
+* stdin. Monitors are printed as en_ep_mon_sel_t numbers of the device.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+#include "ProfileSample.h"
+}
+
+/**
+********************************************************************************
+* Function Name: ReadAll
+********************************************************************************
+*
+*  Reads a whole stream into memory
+*******************************************************************************/
+static std::vector<uint8_t> ReadAll(FILE *file)
+{
+    std::vector<uint8_t> data;
+    uint8_t chunk[4096];
+    size_t size;
+
+    while (0u != (size = fread(chunk, 1u, sizeof(chunk), file)))
+    {
+        data.insert(data.end(), chunk, chunk + size);
+    }
+    return data;
+}
+
+/**
+********************************************************************************
+* Function Name: main
+********************************************************************************
+*
+*  Decodes the capture given as argument (or stdin) and prints CSV on stdout
+*  Returns 1 when the capture cannot be read or holds no sample
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const char *kindName[] = { "raw", "weighted" };
+    FILE *file = stdin;
+    std::vector<uint8_t> data;
+    profile_sample_t sample;
+    size_t offset = 0u;
+    unsigned long samples = 0u;
+    unsigned long rejected = 0u;
+    unsigned long missing = 0u;
+    bool first = true;
+    uint16_t expected = 0u;
+
+    if ((argc > 2) || ((argc == 2) && (0 == strcmp(argv[1], "--help"))))
+    {
+        fprintf(stderr, "Usage: ProfileDecode [capture] > samples.csv\n");
+        return (argc == 2) ? 0 : 1;
+    }
+    if (argc == 2)
+    {
+        file = fopen(argv[1], "rb");
+        if (NULL == file)
+        {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    data = ReadAll(file);
+    if (stdin != file)
+    {
+        fclose(file);
+    }
+
+    printf("sequence,counter,monitor,kind,value\n");
+    while (offset + PROFILE_SAMPLE_SIZE <= data.size())
+    {
+        if (PROFILE_SAMPLE_SYNC != data[offset])
+        {
+            offset++;
+            continue;
+        }
+        if (!ProfileSample_Decode(&data[offset], &sample))
+        {
+            /* Text byte that happens to match, or a corrupted sample */
+            rejected++;
+            offset++;
+            continue;
+        }
+        if (!first && (sample.sequence != expected))
+        {
+            missing += (uint16_t)(sample.sequence - expected);
+            fprintf(stderr, "gap: sequence %u expected, %u received\n", expected, sample.sequence);
+        }
+        first = false;
+        expected = (uint16_t)(sample.sequence + 1u);
+
+        printf("%u,%u,%u,%s,%llu\n", sample.sequence, sample.counter, sample.monitor,
+               (sample.kind <= PROFILE_SAMPLE_WEIGHTED) ? kindName[sample.kind] : "unknown",
+               (unsigned long long)sample.value);
+        samples++;
+        offset += PROFILE_SAMPLE_SIZE;
+    }
+
+    fprintf(stderr, "%lu samples, %lu missing, %lu sync bytes rejected\n", samples, missing, rejected);
+    return (0u != samples) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,783 @@
+/*****************************************************************************
+* File Name: ProfileHost.c
+*
+* Version 1.0
+*
+* Description: Host stand-in for the Cy_Profile API and the few
+* other PDL drivers the profiling modules use. The register layout and
+* the driver semantics follow the PDL closely enough for exact expected
+* values in tests: raw counts are (overflow << 32) | CNT, the overflow
+* interrupt fires on the wrap of a hardware count, StartProfiling resets
+* the overflow counts and ClearCounters zeroes them with the counts.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ProfileHost.h"
+
+/* Bit fields of the PROFILE registers, as on the device */
+#define PROFILE_CTL_ENABLED_Msk             (0x80000000ul)
+#define PROFILE_CMD_START_TR_Msk            (0x00000001ul)
+#define PROFILE_CMD_STOP_TR_Msk             (0x00000002ul)
+#define PROFILE_CNT_STRUCT_CTL_DURATION_Msk (0x00000001ul)
+#define PROFILE_CNT_STRUCT_CTL_REF_CLK_Pos  (4u)
+#define PROFILE_CNT_STRUCT_CTL_MON_SEL_Pos  (16u)
+#define PROFILE_CNT_STRUCT_CTL_MON_SEL_Msk  (0x00FF0000ul)
+#define PROFILE_INTR_ALL_Msk                ((1ul << PROFILE_PRFL_CNT_NR) - 1ul)
+
+#define PROFILE_HOST_IRQ_NR                 (128u)
+#define PROFILE_HOST_DIV_NR                 (16u)
+#define PROFILE_HOST_DIV_TYPES              (4u)
+
+typedef struct
+{
+    cy_israddress handler;
+    uint32_t priority;
+    bool enabled;
+} profile_host_irq_t;
+
+uint32_t cy_Hfclk0FreqHz = PROFILE_HOST_HF_HZ;
+uint32_t cy_PeriClkFreqHz = PROFILE_HOST_PERI_HZ;
+
+static PROFILE_Type hostProfile;
+static TCPWM_Type hostTcpwm;
+static DWT_Type hostDwt;
+static CoreDebug_Type hostCoreDebug;
+static SysTick_Type hostSysTick;
+
+PROFILE_Type * const PROFILE = &hostProfile;
+TCPWM_Type * const TCPWM0 = &hostTcpwm;
+DWT_Type * const DWT = &hostDwt;
+CoreDebug_Type * const CoreDebug = &hostCoreDebug;
+SysTick_Type * const SysTick = &hostSysTick;
+
+/* Counter handles of the Cy_Profile API */
+static cy_stc_profile_ctr_t cy_ep_ctrs[PROFILE_PRFL_CNT_NR];
+
+static profile_host_irq_t hostIrq[PROFILE_HOST_IRQ_NR];
+static uint32_t hostDivider[PROFILE_HOST_DIV_TYPES][PROFILE_HOST_DIV_NR];
+static uint8_t hostTcpwmDivType[PROFILE_HOST_TCPWM_CNT_NR];
+static uint8_t hostTcpwmDivNum[PROFILE_HOST_TCPWM_CNT_NR];
+static bool hostActive[PROFILE_MONITOR_NR];
+static bool hostRunning;
+static bool hostInHandler;
+static uint32_t hostCriticalNesting;
+static uint64_t hostPeriRemainder;      /* HF cycles times peri Hz not yet a peri clock */
+
+static void ProfileHost_UpdateMasked(void);
+static void ProfileHost_Raise(uint32_t counter);
+static void ProfileHost_Add(uint32_t counter, uint32_t amount);
+static bool ProfileHost_IsPending(uint32_t irq);
+static void ProfileHost_Dispatch(void);
+static void ProfileHost_Tick(uint32_t cycles);
+
+
+/*******************************************************************************
+*            Scripting of the simulated hardware
+*******************************************************************************/
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_Reset
+********************************************************************************
+*
+*  Puts the simulated device back into its power-on state. Only the
+*  constant PROFILE_ONE monitor is active afterwards.
+*
+*******************************************************************************/
+void ProfileHost_Reset(void)
+{
+    uint32_t index;
+
+    hostProfile = (PROFILE_Type){0u};
+    hostTcpwm = (TCPWM_Type){0};
+    hostDwt = (DWT_Type){0u};
+    hostCoreDebug = (CoreDebug_Type){0u};
+    hostSysTick = (SysTick_Type){0u};
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        cy_ep_ctrs[index] = (cy_stc_profile_ctr_t){0};
+    }
+    for (index = 0u; index < PROFILE_HOST_IRQ_NR; index++)
+    {
+        hostIrq[index] = (profile_host_irq_t){0};
+    }
+    for (index = 0u; index < PROFILE_HOST_TCPWM_CNT_NR; index++)
+    {
+        hostTcpwmDivType[index] = 0u;
+        hostTcpwmDivNum[index] = 0u;
+    }
+    for (index = 0u; index < (uint32_t)PROFILE_MONITOR_NR; index++)
+    {
+        hostActive[index] = false;
+    }
+    for (index = 0u; index < (PROFILE_HOST_DIV_TYPES * PROFILE_HOST_DIV_NR); index++)
+    {
+        hostDivider[index / PROFILE_HOST_DIV_NR][index % PROFILE_HOST_DIV_NR] = 0u;
+    }
+    hostActive[PROFILE_ONE] = true;
+
+    cy_Hfclk0FreqHz = PROFILE_HOST_HF_HZ;
+    cy_PeriClkFreqHz = PROFILE_HOST_PERI_HZ;
+    hostRunning = false;
+    hostInHandler = false;
+    hostCriticalNesting = 0u;
+    hostPeriRemainder = 0u;
+}
+
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_Access
+********************************************************************************
+*
+*  Simulates a number of accesses on a monitor. Every enabled event
+*  counter on that monitor counts them while profiling runs.
+*
+*******************************************************************************/
+void ProfileHost_Access(en_ep_mon_sel_t monitor, uint32_t events)
+{
+    uint32_t index;
+    uint32_t ctl;
+
+    if (hostRunning)
+    {
+        for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+        {
+            ctl = hostProfile.CNT_STRUCT[index].CTL;
+            if ((0u != (ctl & PROFILE_CNT_STRUCT_CTL_ENABLED_Msk)) &&
+                (0u == (ctl & PROFILE_CNT_STRUCT_CTL_DURATION_Msk)) &&
+                ((uint32_t)monitor == ((ctl & PROFILE_CNT_STRUCT_CTL_MON_SEL_Msk) >> PROFILE_CNT_STRUCT_CTL_MON_SEL_Pos)))
+            {
+                ProfileHost_Add(index, events);
+            }
+        }
+    }
+    ProfileHost_Dispatch();
+}
+
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_SetActive
+********************************************************************************
+*
+*  Sets the level of the duration signal of a monitor, e.g. whether the
+*  CM4 is active or a bus master owns the bus.
+*
+*******************************************************************************/
+void ProfileHost_SetActive(en_ep_mon_sel_t monitor, bool active)
+{
+    if ((uint32_t)monitor < (uint32_t)PROFILE_MONITOR_NR)
+    {
+        hostActive[monitor] = active;
+    }
+}
+
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_Clock
+********************************************************************************
+*
+*  Lets a number of HF clock cycles pass. Duration counters of active
+*  monitors, DWT CYCCNT and the running TCPWM counters advance, in steps
+*  of at most PROFILE_HOST_STEP_CYCLES with interrupts served in between.
+*
+*******************************************************************************/
+void ProfileHost_Clock(uint32_t cycles)
+{
+    uint32_t step;
+
+    while (0u != cycles)
+    {
+        step = (cycles < PROFILE_HOST_STEP_CYCLES) ? cycles : PROFILE_HOST_STEP_CYCLES;
+        ProfileHost_Tick(step);
+        cycles -= step;
+        ProfileHost_Dispatch();
+    }
+}
+
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_SetCount
+********************************************************************************
+*
+*  Presets the hardware count of a counter, e.g. just below the wrap.
+*  The overflow count of the handle is kept.
+*
+*******************************************************************************/
+void ProfileHost_SetCount(uint32_t counter, uint32_t count)
+{
+    if (counter < PROFILE_PRFL_CNT_NR)
+    {
+        hostProfile.CNT_STRUCT[counter].CNT = count;
+    }
+}
+
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_InjectOverflow
+********************************************************************************
+*
+*  Wraps the hardware count of a counter now, whether profiling runs or
+*  not: the count restarts from zero and the overflow interrupt is raised.
+*
+*******************************************************************************/
+void ProfileHost_InjectOverflow(uint32_t counter)
+{
+    if (counter < PROFILE_PRFL_CNT_NR)
+    {
+        hostProfile.CNT_STRUCT[counter].CNT = 0u;
+        ProfileHost_Raise(counter);
+        ProfileHost_Dispatch();
+    }
+}
+
+
+/**
+********************************************************************************
+* Function Name: ProfileHost_IsRunning
+********************************************************************************
+*
+*  Returns whether profiling runs, i.e. started and not stopped.
+*
+*******************************************************************************/
+bool ProfileHost_IsRunning(void)
+{
+    return hostRunning;
+}
+
+
+/*******************************************************************************
+*            Simulation internals
+*******************************************************************************/
+
+static void ProfileHost_UpdateMasked(void)
+{
+    hostProfile.INTR_MASKED = hostProfile.INTR & hostProfile.INTR_MASK;
+}
+
+static void ProfileHost_Raise(uint32_t counter)
+{
+    hostProfile.INTR |= (1ul << counter);
+    ProfileHost_UpdateMasked();
+}
+
+static void ProfileHost_Add(uint32_t counter, uint32_t amount)
+{
+    uint32_t before = hostProfile.CNT_STRUCT[counter].CNT;
+
+    hostProfile.CNT_STRUCT[counter].CNT = before + amount;
+    if (hostProfile.CNT_STRUCT[counter].CNT < before)
+    {
+        ProfileHost_Raise(counter);
+    }
+}
+
+static bool ProfileHost_IsPending(uint32_t irq)
+{
+    uint32_t cntNum;
+
+    if ((uint32_t)profile_interrupt_IRQn == irq)
+    {
+        return (0u != hostProfile.INTR_MASKED);
+    }
+    if ((irq >= (uint32_t)tcpwm_0_interrupts_0_IRQn) &&
+        (irq < ((uint32_t)tcpwm_0_interrupts_0_IRQn + PROFILE_HOST_TCPWM_CNT_NR)))
+    {
+        cntNum = irq - (uint32_t)tcpwm_0_interrupts_0_IRQn;
+        return (0u != (hostTcpwm.CNT[cntNum].intr & hostTcpwm.CNT[cntNum].intrMask));
+    }
+    return false;
+}
+
+/* Serves pending interrupts in priority order, unless masked or nested */
+static void ProfileHost_Dispatch(void)
+{
+    uint32_t irq;
+    uint32_t next;
+    uint32_t acknowledge;
+    bool served;
+
+    while ((!hostInHandler) && (0u == hostCriticalNesting))
+    {
+        next = PROFILE_HOST_IRQ_NR;
+        for (irq = 0u; irq < PROFILE_HOST_IRQ_NR; irq++)
+        {
+            if (hostIrq[irq].enabled && (NULL != hostIrq[irq].handler) && ProfileHost_IsPending(irq) &&
+                ((PROFILE_HOST_IRQ_NR == next) || (hostIrq[irq].priority < hostIrq[next].priority)))
+            {
+                next = irq;
+            }
+        }
+        if (PROFILE_HOST_IRQ_NR == next)
+        {
+            break;
+        }
+
+        acknowledge = hostProfile.INTR_MASKED;
+        hostInHandler = true;
+        hostIrq[next].handler();
+        hostInHandler = false;
+
+        served = true;
+        if ((uint32_t)profile_interrupt_IRQn == next)
+        {
+            /* The ISR wrote the bits back to INTR, which clears them */
+            hostProfile.INTR &= ~acknowledge;
+            ProfileHost_UpdateMasked();
+        }
+        else if (ProfileHost_IsPending(next))
+        {
+            /* The handler left its source pending, stop instead of spinning */
+            served = false;
+        }
+        if (!served)
+        {
+            break;
+        }
+    }
+}
+
+/* Advances everything clocked by a number of HF cycles */
+static void ProfileHost_Tick(uint32_t cycles)
+{
+    uint32_t index;
+    uint32_t ctl;
+    uint32_t monitor;
+    uint32_t periClocks;
+    uint32_t prescale;
+    uint32_t ticks;
+    profile_host_tcpwm_cnt_t *timer;
+
+    if (hostRunning)
+    {
+        for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+        {
+            ctl = hostProfile.CNT_STRUCT[index].CTL;
+            monitor = (ctl & PROFILE_CNT_STRUCT_CTL_MON_SEL_Msk) >> PROFILE_CNT_STRUCT_CTL_MON_SEL_Pos;
+            if ((0u != (ctl & PROFILE_CNT_STRUCT_CTL_ENABLED_Msk)) &&
+                (0u != (ctl & PROFILE_CNT_STRUCT_CTL_DURATION_Msk)) &&
+                (monitor < (uint32_t)PROFILE_MONITOR_NR) && hostActive[monitor])
+            {
+                ProfileHost_Add(index, cycles);
+            }
+        }
+    }
+
+    if (0u != (hostDwt.CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        hostDwt.CYCCNT += cycles;
+    }
+
+    hostPeriRemainder += (uint64_t)cycles * cy_PeriClkFreqHz;
+    periClocks = (uint32_t)(hostPeriRemainder / cy_Hfclk0FreqHz);
+    hostPeriRemainder %= cy_Hfclk0FreqHz;
+
+    for (index = 0u; index < PROFILE_HOST_TCPWM_CNT_NR; index++)
+    {
+        timer = &hostTcpwm.CNT[index];
+        if (timer->enabled && timer->running)
+        {
+            prescale = hostDivider[hostTcpwmDivType[index]][hostTcpwmDivNum[index]] + 1u;
+            timer->remainder += periClocks;
+            ticks = timer->remainder / prescale;
+            timer->remainder %= prescale;
+            for (; 0u != ticks; ticks--)
+            {
+                if (timer->counter >= timer->period)
+                {
+                    timer->counter = 0u;
+                    timer->intr |= CY_TCPWM_INT_ON_TC;
+                }
+                else
+                {
+                    timer->counter++;
+                }
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+*            SysInt, NVIC and critical sections
+*******************************************************************************/
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    if ((NULL == config) || ((uint32_t)config->intrSrc >= PROFILE_HOST_IRQ_NR))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+    hostIrq[config->intrSrc].handler = userIsr;
+    hostIrq[config->intrSrc].priority = config->intrPriority;
+    return CY_SYSINT_SUCCESS;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    hostIrq[irq].enabled = true;
+    ProfileHost_Dispatch();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+    hostIrq[irq].enabled = false;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+    /* Pending state follows the level of the sources on the host */
+    (void) irq;
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return hostCriticalNesting++;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    hostCriticalNesting = savedIntrStatus;
+    ProfileHost_Dispatch();
+}
+
+
+/*******************************************************************************
+*            Clock dividers
+*******************************************************************************/
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphSetDivider(cy_en_divider_types_t dividerType,
+                                                 uint32_t dividerNum, uint32_t dividerValue)
+{
+    if (((uint32_t)dividerType >= PROFILE_HOST_DIV_TYPES) || (dividerNum >= PROFILE_HOST_DIV_NR))
+    {
+        return CY_SYSCLK_BAD_PARAM;
+    }
+    hostDivider[dividerType][dividerNum] = dividerValue;
+    return CY_SYSCLK_SUCCESS;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphEnableDivider(cy_en_divider_types_t dividerType, uint32_t dividerNum)
+{
+    (void) dividerType;
+    (void) dividerNum;
+    return CY_SYSCLK_SUCCESS;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphAssignDivider(en_clk_dst_t ipBlock, cy_en_divider_types_t dividerType,
+                                                    uint32_t dividerNum)
+{
+    uint32_t cntNum = (uint32_t)ipBlock - (uint32_t)PCLK_TCPWM0_CLOCKS0;
+
+    if ((cntNum >= PROFILE_HOST_TCPWM_CNT_NR) || ((uint32_t)dividerType >= PROFILE_HOST_DIV_TYPES) ||
+        (dividerNum >= PROFILE_HOST_DIV_NR))
+    {
+        return CY_SYSCLK_BAD_PARAM;
+    }
+    hostTcpwmDivType[cntNum] = (uint8_t)dividerType;
+    hostTcpwmDivNum[cntNum] = (uint8_t)dividerNum;
+    return CY_SYSCLK_SUCCESS;
+}
+
+
+/*******************************************************************************
+*            TCPWM counters
+*******************************************************************************/
+
+uint32_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum, const cy_stc_tcpwm_counter_config_t *config)
+{
+    if ((NULL == config) || (cntNum >= PROFILE_HOST_TCPWM_CNT_NR))
+    {
+        return 1u;
+    }
+    base->CNT[cntNum].period = config->period;
+    base->CNT[cntNum].intrMask = config->interruptSources;
+    base->CNT[cntNum].counter = 0u;
+    base->CNT[cntNum].intr = 0u;
+    base->CNT[cntNum].remainder = 0u;
+    return 0u;
+}
+
+void Cy_TCPWM_Enable_Multiple(TCPWM_Type *base, uint32_t counters)
+{
+    uint32_t cntNum;
+
+    for (cntNum = 0u; cntNum < PROFILE_HOST_TCPWM_CNT_NR; cntNum++)
+    {
+        if (0u != (counters & (1ul << cntNum)))
+        {
+            base->CNT[cntNum].enabled = true;
+        }
+    }
+}
+
+void Cy_TCPWM_TriggerStart(TCPWM_Type *base, uint32_t counters)
+{
+    uint32_t cntNum;
+
+    for (cntNum = 0u; cntNum < PROFILE_HOST_TCPWM_CNT_NR; cntNum++)
+    {
+        if ((0u != (counters & (1ul << cntNum))) && base->CNT[cntNum].enabled)
+        {
+            base->CNT[cntNum].running = true;
+        }
+    }
+}
+
+void Cy_TCPWM_TriggerStopOrKill(TCPWM_Type *base, uint32_t counters)
+{
+    uint32_t cntNum;
+
+    for (cntNum = 0u; cntNum < PROFILE_HOST_TCPWM_CNT_NR; cntNum++)
+    {
+        if (0u != (counters & (1ul << cntNum)))
+        {
+            base->CNT[cntNum].running = false;
+        }
+    }
+}
+
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type const *base, uint32_t cntNum)
+{
+    return base->CNT[cntNum].counter;
+}
+
+void Cy_TCPWM_Counter_SetCounter(TCPWM_Type *base, uint32_t cntNum, uint32_t count)
+{
+    base->CNT[cntNum].counter = count;
+}
+
+uint32_t Cy_TCPWM_GetInterruptStatus(TCPWM_Type const *base, uint32_t cntNum)
+{
+    return base->CNT[cntNum].intr;
+}
+
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source)
+{
+    base->CNT[cntNum].intr &= ~source;
+}
+
+
+/*******************************************************************************
+*            Energy profiler
+*******************************************************************************/
+
+void Cy_Profile_Init(void)
+{
+    hostProfile.CTL = PROFILE_CTL_ENABLED_Msk;
+    hostProfile.INTR_MASK = PROFILE_INTR_ALL_Msk;
+    ProfileHost_UpdateMasked();
+}
+
+void Cy_Profile_DeInit(void)
+{
+    hostProfile.CTL = 0u;
+    hostProfile.INTR_MASK = 0u;
+    hostRunning = false;
+    ProfileHost_UpdateMasked();
+}
+
+void Cy_Profile_StartProfiling(void)
+{
+    uint32_t index;
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        if (0u != cy_ep_ctrs[index].used)
+        {
+            cy_ep_ctrs[index].overflow = 0u;
+        }
+    }
+    hostProfile.CMD = PROFILE_CMD_START_TR_Msk;
+    hostRunning = (0u != (hostProfile.CTL & PROFILE_CTL_ENABLED_Msk));
+}
+
+void Cy_Profile_StopProfiling(void)
+{
+    hostProfile.CMD = PROFILE_CMD_STOP_TR_Msk;
+    hostRunning = false;
+}
+
+void Cy_Profile_ClearConfiguration(void)
+{
+    uint32_t index;
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        hostProfile.CNT_STRUCT[index].CTL = 0u;
+        cy_ep_ctrs[index] = (cy_stc_profile_ctr_t){0};
+    }
+}
+
+void Cy_Profile_ClearCounters(void)
+{
+    uint32_t index;
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        hostProfile.CNT_STRUCT[index].CNT = 0u;
+        cy_ep_ctrs[index].overflow = 0u;
+    }
+}
+
+void Cy_Profile_ISR(void)
+{
+    uint32_t ctr_int = hostProfile.INTR_MASKED;
+    uint32_t index;
+
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        if ((0u != (ctr_int & (1ul << index))) && (0u != cy_ep_ctrs[index].used))
+        {
+            cy_ep_ctrs[index].overflow++;
+        }
+    }
+    /* Written back to INTR on the device, acknowledged by the dispatcher here */
+}
+
+cy_stc_profile_ctr_ptr_t Cy_Profile_ConfigureCounter(en_ep_mon_sel_t monitor, cy_en_profile_duration_t duration,
+                                                     cy_en_profile_ref_clk_t refClk, uint32_t weight)
+{
+    uint32_t index;
+    cy_stc_profile_ctr_ptr_t ctr;
+
+    if (((uint32_t)monitor >= (uint32_t)PROFILE_MONITOR_NR) || ((uint32_t)duration > (uint32_t)CY_PROFILE_DURATION) ||
+        ((uint32_t)refClk > (uint32_t)CY_PROFILE_CLK_PERI))
+    {
+        return NULL;
+    }
+    for (index = 0u; index < PROFILE_PRFL_CNT_NR; index++)
+    {
+        if (0u == cy_ep_ctrs[index].used)
+        {
+            ctr = &cy_ep_ctrs[index];
+            ctr->ctrNum = (uint8_t)index;
+            ctr->used = 1u;
+            ctr->ctlRegVals.cntDuration = duration;
+            ctr->ctlRegVals.refClkSel = refClk;
+            ctr->ctlRegVals.monSel = monitor;
+            ctr->cntAddr = &hostProfile.CNT_STRUCT[index];
+            ctr->ctlReg = ((uint32_t)duration) |
+                          ((uint32_t)refClk << PROFILE_CNT_STRUCT_CTL_REF_CLK_Pos) |
+                          ((uint32_t)monitor << PROFILE_CNT_STRUCT_CTL_MON_SEL_Pos);
+            ctr->cntReg = 0u;
+            ctr->overflow = 0u;
+            ctr->weight = weight;
+            hostProfile.CNT_STRUCT[index].CTL = ctr->ctlReg;
+            return ctr;
+        }
+    }
+    return NULL;
+}
+
+cy_en_profile_status_t Cy_Profile_FreeCounter(cy_stc_profile_ctr_ptr_t ctrAddr)
+{
+    if (NULL == ctrAddr)
+    {
+        return CY_PROFILE_BAD_PARAM;
+    }
+    ctrAddr->cntAddr->CTL &= ~PROFILE_CNT_STRUCT_CTL_ENABLED_Msk;
+    ctrAddr->used = 0u;
+    return CY_PROFILE_SUCCESS;
+}
+
+cy_en_profile_status_t Cy_Profile_EnableCounter(cy_stc_profile_ctr_ptr_t ctrAddr)
+{
+    if (NULL == ctrAddr)
+    {
+        return CY_PROFILE_BAD_PARAM;
+    }
+    ctrAddr->cntAddr->CTL |= PROFILE_CNT_STRUCT_CTL_ENABLED_Msk;
+    return CY_PROFILE_SUCCESS;
+}
+
+cy_en_profile_status_t Cy_Profile_DisableCounter(cy_stc_profile_ctr_ptr_t ctrAddr)
+{
+    if (NULL == ctrAddr)
+    {
+        return CY_PROFILE_BAD_PARAM;
+    }
+    ctrAddr->cntAddr->CTL &= ~PROFILE_CNT_STRUCT_CTL_ENABLED_Msk;
+    return CY_PROFILE_SUCCESS;
+}
+
+cy_en_profile_status_t Cy_Profile_GetRawCount(cy_stc_profile_ctr_ptr_t ctrAddr, uint64_t *result)
+{
+    if ((NULL == ctrAddr) || (NULL == result))
+    {
+        return CY_PROFILE_BAD_PARAM;
+    }
+    ctrAddr->cntReg = ctrAddr->cntAddr->CNT;
+    *result = ((uint64_t)ctrAddr->overflow << 32u) | ctrAddr->cntReg;
+    return CY_PROFILE_SUCCESS;
+}
+
+cy_en_profile_status_t Cy_Profile_GetWeightedCount(cy_stc_profile_ctr_ptr_t ctrAddr, uint64_t *result)
+{
+    uint64_t raw;
+    cy_en_profile_status_t status = Cy_Profile_GetRawCount(ctrAddr, &raw);
+
+    if (CY_PROFILE_SUCCESS == status)
+    {
+        *result = raw * ctrAddr->weight;
+    }
+    return status;
+}
+
+uint64_t Cy_Profile_GetSumWeightedCounts(cy_stc_profile_ctr_ptr_t ptrsArray[], uint32_t numCounters)
+{
+    uint64_t sum = 0u;
+    uint64_t weighted;
+    uint32_t index;
+
+    for (index = 0u; index < numCounters; index++)
+    {
+        if (CY_PROFILE_SUCCESS == Cy_Profile_GetWeightedCount(ptrsArray[index], &weighted))
+        {
+            sum += weighted;
+        }
+    }
+    return sum;
+}
+
+
+/* [] END OF FILE */
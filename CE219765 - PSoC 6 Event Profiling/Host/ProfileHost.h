@@ -0,0 +1,383 @@
+/*****************************************************************************
+* File Name: ProfileHost.h
+*
+* Version 1.0
+*
+* Description: Host stand-in for the parts of the PDL used by the
+* profiling modules of CE219765: the Cy_Profile API and the PROFILE
+* registers, TCPWM counters, clock dividers, SysInt/NVIC, critical sections
+* and the DWT cycle counter. Host/project.h includes this file, so
+* ProfileSession.c, ProfileOverflow.c, ProfileSampler.c, ProfileRegion.c and
+* ProfileCycles.c build unchanged on a PC.
+* Nothing happens on its own. A test calls ProfileHost_Reset() and then
+* drives the hardware:
+*   ProfileHost_Access(SCB5_MONITOR_AHB, 10u)  10 events on a monitor
+*   ProfileHost_SetActive(CPUSS_MONITOR_CM4, true)  duration signal level
+*   ProfileHost_Clock(1000u)                   1000 HF clock cycles pass
+*   ProfileHost_SetCount(0u, 0xFFFFFFF0u)      preset a hardware count
+*   ProfileHost_InjectOverflow(0u)             wrap a counter now
+* Events and cycles are only counted by enabled counters while profiling
+* runs, like on the device; duration counters count HF cycles whatever
+* their reference clock. Interrupt handlers run synchronously, in priority
+* order, as soon as their source is pending, enabled and no critical
+* section is open. Handlers do not nest. The profile handler acknowledges
+* the overflow bits it was called for, as Cy_Profile_ISR does.
+* Build, e.g. with ProfileSession:
+*  cc -I. -I../CE219765_Event_Profiling.cydsn ProfileHost.c
+*     ../CE219765_Event_Profiling.cydsn/ProfileSession.c
+*     ../CE219765_Event_Profiling.cydsn/ProfileOverflow.c
+*     ../CE219765_Event_Profiling.cydsn/ProfileCycles.c your_test.c
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILEHOST_H
+#define PROFILEHOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Clocks of the simulated device */
+#define PROFILE_HOST_HF_HZ          (100000000ul)
+#define PROFILE_HOST_PERI_HZ        (50000000ul)
+
+/* Largest step of ProfileHost_Clock() between interrupt checks */
+#define PROFILE_HOST_STEP_CYCLES    (100u)
+
+/* Core selection, the host acts as CM4 */
+#define CY_CPU_CORTEX_M4            (1)
+#define CY_CPU_CORTEX_M0P           (0)
+
+extern uint32_t cy_Hfclk0FreqHz;
+extern uint32_t cy_PeriClkFreqHz;
+
+/*******************************************************************************
+* Interrupts
+*******************************************************************************/
+typedef enum
+{
+    profile_interrupt_IRQn      = 30,
+    tcpwm_0_interrupts_0_IRQn   = 90,
+    tcpwm_0_interrupts_1_IRQn   = 91,
+    tcpwm_0_interrupts_2_IRQn   = 92,
+    tcpwm_0_interrupts_3_IRQn   = 93,
+    tcpwm_0_interrupts_4_IRQn   = 94,
+    tcpwm_0_interrupts_5_IRQn   = 95,
+    tcpwm_0_interrupts_6_IRQn   = 96,
+    tcpwm_0_interrupts_7_IRQn   = 97
+} IRQn_Type;
+
+typedef void (*cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS   = 0u,
+    CY_SYSINT_BAD_PARAM = 1u
+} cy_en_sysint_status_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+
+/*******************************************************************************
+* Core cycle counters
+*******************************************************************************/
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+} SysTick_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk          (0x00000001ul)
+#define CoreDebug_DEMCR_TRCENA_Msk      (0x01000000ul)
+#define SysTick_CTRL_ENABLE_Msk         (0x00000001ul)
+#define SysTick_CTRL_CLKSOURCE_Msk      (0x00000004ul)
+#define SysTick_CTRL_COUNTFLAG_Msk      (0x00010000ul)
+#define SysTick_LOAD_RELOAD_Msk         (0x00FFFFFFul)
+
+extern DWT_Type * const DWT;
+extern CoreDebug_Type * const CoreDebug;
+extern SysTick_Type * const SysTick;
+
+/*******************************************************************************
+* Clock dividers
+*******************************************************************************/
+typedef enum
+{
+    CY_SYSCLK_DIV_8_BIT    = 0u,
+    CY_SYSCLK_DIV_16_BIT   = 1u,
+    CY_SYSCLK_DIV_16_5_BIT = 2u,
+    CY_SYSCLK_DIV_24_5_BIT = 3u
+} cy_en_divider_types_t;
+
+typedef enum
+{
+    PCLK_TCPWM0_CLOCKS0 = 0u
+} en_clk_dst_t;
+
+typedef enum
+{
+    CY_SYSCLK_SUCCESS   = 0u,
+    CY_SYSCLK_BAD_PARAM = 1u
+} cy_en_sysclk_status_t;
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphSetDivider(cy_en_divider_types_t dividerType,
+                                                 uint32_t dividerNum, uint32_t dividerValue);
+cy_en_sysclk_status_t Cy_SysClk_PeriphEnableDivider(cy_en_divider_types_t dividerType, uint32_t dividerNum);
+cy_en_sysclk_status_t Cy_SysClk_PeriphAssignDivider(en_clk_dst_t ipBlock, cy_en_divider_types_t dividerType,
+                                                    uint32_t dividerNum);
+
+/*******************************************************************************
+* TCPWM counters, continuous up counting only
+*******************************************************************************/
+#define PROFILE_HOST_TCPWM_CNT_NR   (8u)
+
+typedef struct
+{
+    uint32_t counter;
+    uint32_t period;
+    uint32_t intr;
+    uint32_t intrMask;
+    uint32_t remainder;         /* Peripheral clocks not yet counted */
+    bool enabled;
+    bool running;
+} profile_host_tcpwm_cnt_t;
+
+typedef struct
+{
+    profile_host_tcpwm_cnt_t CNT[PROFILE_HOST_TCPWM_CNT_NR];
+} TCPWM_Type;
+
+extern TCPWM_Type * const TCPWM0;
+
+#define CY_TCPWM_COUNTER_PRESCALER_DIVBY_1  (0u)
+#define CY_TCPWM_COUNTER_CONTINUOUS         (0u)
+#define CY_TCPWM_COUNTER_COUNT_UP           (0u)
+#define CY_TCPWM_COUNTER_MODE_COMPARE       (2u)
+#define CY_TCPWM_INT_NONE                   (0u)
+#define CY_TCPWM_INT_ON_TC                  (1u)
+#define CY_TCPWM_INPUT_RISINGEDGE           (0u)
+#define CY_TCPWM_INPUT_LEVEL                (3u)
+#define CY_TCPWM_INPUT_0                    (0u)
+#define CY_TCPWM_INPUT_1                    (1u)
+
+typedef struct
+{
+    uint32_t period;
+    uint32_t clockPrescaler;
+    uint32_t runMode;
+    uint32_t countDirection;
+    uint32_t compareOrCapture;
+    uint32_t compare0;
+    uint32_t compare1;
+    bool enableCompareSwap;
+    uint32_t interruptSources;
+    uint32_t captureInputMode;
+    uint32_t captureInput;
+    uint32_t reloadInputMode;
+    uint32_t reloadInput;
+    uint32_t startInputMode;
+    uint32_t startInput;
+    uint32_t stopInputMode;
+    uint32_t stopInput;
+    uint32_t countInputMode;
+    uint32_t countInput;
+} cy_stc_tcpwm_counter_config_t;
+
+uint32_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum, const cy_stc_tcpwm_counter_config_t *config);
+void Cy_TCPWM_Enable_Multiple(TCPWM_Type *base, uint32_t counters);
+void Cy_TCPWM_TriggerStart(TCPWM_Type *base, uint32_t counters);
+void Cy_TCPWM_TriggerStopOrKill(TCPWM_Type *base, uint32_t counters);
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_Counter_SetCounter(TCPWM_Type *base, uint32_t cntNum, uint32_t count);
+uint32_t Cy_TCPWM_GetInterruptStatus(TCPWM_Type const *base, uint32_t cntNum);
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum, uint32_t source);
+
+/*******************************************************************************
+* Energy profiler
+*******************************************************************************/
+#define PROFILE_PRFL_CNT_NR         (8u)
+
+/* Monitor signals of the psoc63 devices, values as in the device header */
+typedef enum
+{
+    PROFILE_ONE             = 0x00u,
+    CPUSS_MONITOR_CM0       = 0x01u,
+    CPUSS_MONITOR_CM4       = 0x02u,
+    CPUSS_MONITOR_FLASH     = 0x03u,
+    CPUSS_MONITOR_DW0_AHB   = 0x04u,
+    CPUSS_MONITOR_DW1_AHB   = 0x05u,
+    CPUSS_MONITOR_CRYPTO    = 0x06u,
+    USB_MONITOR_AHB         = 0x07u,
+    SCB0_MONITOR_AHB        = 0x08u,
+    SCB1_MONITOR_AHB        = 0x09u,
+    SCB2_MONITOR_AHB        = 0x0Au,
+    SCB3_MONITOR_AHB        = 0x0Bu,
+    SCB4_MONITOR_AHB        = 0x0Cu,
+    SCB5_MONITOR_AHB        = 0x0Du,
+    SCB6_MONITOR_AHB        = 0x0Eu,
+    SCB7_MONITOR_AHB        = 0x0Fu,
+    SCB8_MONITOR_AHB        = 0x10u,
+    UDB_MONITOR_UDB0        = 0x11u,
+    UDB_MONITOR_UDB1        = 0x12u,
+    UDB_MONITOR_UDB2        = 0x13u,
+    UDB_MONITOR_UDB3        = 0x14u,
+    PROFILE_MONITOR_NR
+} en_ep_mon_sel_t;
+
+typedef enum
+{
+    CY_PROFILE_SUCCESS   = 0u,
+    CY_PROFILE_BAD_PARAM = 1u
+} cy_en_profile_status_t;
+
+typedef enum
+{
+    CY_PROFILE_EVENT    = 0u,
+    CY_PROFILE_DURATION = 1u
+} cy_en_profile_duration_t;
+
+typedef enum
+{
+    CY_PROFILE_CLK_TIMER = 0u,
+    CY_PROFILE_CLK_IMO   = 1u,
+    CY_PROFILE_CLK_ECO   = 2u,
+    CY_PROFILE_CLK_LF    = 3u,
+    CY_PROFILE_CLK_HF    = 4u,
+    CY_PROFILE_CLK_PERI  = 5u
+} cy_en_profile_ref_clk_t;
+
+typedef struct
+{
+    volatile uint32_t CTL;
+    volatile uint32_t CNT;
+} PROFILE_CNT_STRUCT_Type;
+
+typedef struct
+{
+    volatile uint32_t CTL;
+    volatile uint32_t CMD;
+    volatile uint32_t INTR;
+    volatile uint32_t INTR_MASK;
+    volatile uint32_t INTR_MASKED;
+    PROFILE_CNT_STRUCT_Type CNT_STRUCT[PROFILE_PRFL_CNT_NR];
+} PROFILE_Type;
+
+#define PROFILE_CNT_STRUCT_CTL_ENABLED_Msk  (0x80000000ul)
+
+extern PROFILE_Type * const PROFILE;
+
+typedef struct
+{
+    cy_en_profile_duration_t cntDuration;
+    cy_en_profile_ref_clk_t refClkSel;
+    en_ep_mon_sel_t monSel;
+} cy_stc_profile_ctr_ctl_t;
+
+typedef struct
+{
+    uint8_t ctrNum;
+    uint8_t used;
+    cy_stc_profile_ctr_ctl_t ctlRegVals;
+    PROFILE_CNT_STRUCT_Type *cntAddr;
+    uint32_t ctlReg;
+    uint32_t cntReg;
+    uint32_t overflow;
+    uint32_t weight;
+} cy_stc_profile_ctr_t;
+
+typedef cy_stc_profile_ctr_t * cy_stc_profile_ctr_ptr_t;
+
+void Cy_Profile_Init(void);
+void Cy_Profile_DeInit(void);
+void Cy_Profile_StartProfiling(void);
+void Cy_Profile_StopProfiling(void);
+void Cy_Profile_ClearConfiguration(void);
+void Cy_Profile_ClearCounters(void);
+void Cy_Profile_ISR(void);
+cy_stc_profile_ctr_ptr_t Cy_Profile_ConfigureCounter(en_ep_mon_sel_t monitor, cy_en_profile_duration_t duration,
+                                                     cy_en_profile_ref_clk_t refClk, uint32_t weight);
+cy_en_profile_status_t Cy_Profile_FreeCounter(cy_stc_profile_ctr_ptr_t ctrAddr);
+cy_en_profile_status_t Cy_Profile_EnableCounter(cy_stc_profile_ctr_ptr_t ctrAddr);
+cy_en_profile_status_t Cy_Profile_DisableCounter(cy_stc_profile_ctr_ptr_t ctrAddr);
+cy_en_profile_status_t Cy_Profile_GetRawCount(cy_stc_profile_ctr_ptr_t ctrAddr, uint64_t *result);
+cy_en_profile_status_t Cy_Profile_GetWeightedCount(cy_stc_profile_ctr_ptr_t ctrAddr, uint64_t *result);
+uint64_t Cy_Profile_GetSumWeightedCounts(cy_stc_profile_ctr_ptr_t ptrsArray[], uint32_t numCounters);
+
+/*******************************************************************************
+* Scripting of the simulated hardware
+*******************************************************************************/
+void ProfileHost_Reset(void);
+void ProfileHost_Access(en_ep_mon_sel_t monitor, uint32_t events);
+void ProfileHost_SetActive(en_ep_mon_sel_t monitor, bool active);
+void ProfileHost_Clock(uint32_t cycles);
+void ProfileHost_SetCount(uint32_t counter, uint32_t count);
+void ProfileHost_InjectOverflow(uint32_t counter);
+bool ProfileHost_IsRunning(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PROFILEHOST_H */
+
+/* [] END OF FILE */
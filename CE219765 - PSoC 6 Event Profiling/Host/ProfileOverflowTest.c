@@ -0,0 +1,226 @@
+/*****************************************************************************
+* File Name: ProfileOverflowTest.c
+*
+* Version 1.0
+*
+* Description: Host test of ProfileOverflow.c on ProfileHost. It checks the
+* 64-bit extension of a counter through its overflows, the overflow
+* statistics, and the budget alert of the window interrupt, including a
+* window in which the hardware counter wraps.
+* Build and run:
+*  cc -I. -I../CE219765_Event_Profiling.cydsn ProfileHost.c
+*     ../CE219765_Event_Profiling.cydsn/ProfileOverflow.c ProfileOverflowTest.c
+*     -o ProfileOverflowTest
+*  ./ProfileOverflowTest
+* The exit status is the number of failed checks.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileOverflow.h"
+
+/* Window of the budget checks, and the HF cycles of one microsecond */
+#define TEST_WINDOW_US      (1000u)
+#define TEST_CYCLES_US      (PROFILE_HOST_HF_HZ / 1000000ul)
+#define TEST_IRQ_PRIORITY   (3u)
+
+static unsigned failures = 0u;
+
+/* Calls of the budget callback */
+static uint32_t alertCalls;
+static uint32_t alertCounter;
+static uint64_t alertCount;
+
+#define CHECK_EQUAL(actual, expected) \
+    CheckEqual(__LINE__, #actual, (unsigned long long)(actual), (unsigned long long)(expected))
+
+static void CheckEqual(int line, const char *name, unsigned long long actual, unsigned long long expected)
+{
+    if (actual != expected)
+    {
+        printf("line %d: %s is 0x%llX, expected 0x%llX\n", line, name, actual, expected);
+        failures++;
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: BudgetAlert
+********************************************************************************
+*
+*  Budget callback, records its arguments
+*******************************************************************************/
+static void BudgetAlert(uint32_t counter, uint64_t count)
+{
+    alertCalls++;
+    alertCounter = counter;
+    alertCount = count;
+}
+
+/**
+********************************************************************************
+* Function Name: Wait
+********************************************************************************
+*
+*  Lets microseconds pass on the simulated device
+*******************************************************************************/
+static void Wait(uint32_t us)
+{
+    ProfileHost_Clock(us * TEST_CYCLES_US);
+}
+
+/**
+********************************************************************************
+* Function Name: Setup
+********************************************************************************
+*
+*  Starts the device, ProfileOverflow and one SCB5 event counter as
+*  main_cm4.c does, and returns the counter
+*******************************************************************************/
+static cy_stc_profile_ctr_ptr_t Setup(void)
+{
+    const cy_stc_sysint_t profileIrqCfg = { profile_interrupt_IRQn, TEST_IRQ_PRIORITY };
+    cy_stc_profile_ctr_ptr_t counter;
+
+    ProfileHost_Reset();
+    Cy_Profile_Init();
+    (void) Cy_SysInt_Init(&profileIrqCfg, &ProfileOverflow_ISR);
+    NVIC_EnableIRQ(profileIrqCfg.intrSrc);
+    ProfileOverflow_Init(TEST_WINDOW_US, TEST_IRQ_PRIORITY);
+
+    counter = Cy_Profile_ConfigureCounter(SCB5_MONITOR_AHB, CY_PROFILE_EVENT, CY_PROFILE_CLK_HF, 1u);
+    (void) Cy_Profile_EnableCounter(counter);
+    ProfileOverflow_Attach(counter);
+    Cy_Profile_StartProfiling();
+
+    alertCalls = 0u;
+    alertCounter = PROFILE_PRFL_CNT_NR;
+    alertCount = 0u;
+    return counter;
+}
+
+/**
+********************************************************************************
+* Function Name: TestExtension
+********************************************************************************
+*
+*  Wraps a counter three times: the 64-bit count, the count of the PDL
+*  handle and the statistics follow. The first overflow has no interval.
+*******************************************************************************/
+static void TestExtension(void)
+{
+    cy_stc_profile_ctr_ptr_t counter = Setup();
+    uint32_t index = ProfileOverflow_GetIndex(counter);
+    profile_overflow_stats_t stats;
+    uint64_t raw = 0u;
+
+    CHECK_EQUAL(index, 0u);
+    Wait(2000u);
+    ProfileHost_SetCount(index, 0xFFFFFFF0uL);
+    ProfileHost_Access(SCB5_MONITOR_AHB, 0x20u);
+    CHECK_EQUAL(ProfileOverflow_GetCount(index), 0x100000010uLL);
+    (void) Cy_Profile_GetRawCount(counter, &raw);
+    CHECK_EQUAL(raw, 0x100000010uLL);
+    ProfileOverflow_GetStats(index, &stats);
+    CHECK_EQUAL(stats.overflows, 1u);
+    CHECK_EQUAL(stats.lastOverflowUs, 2000u);
+    CHECK_EQUAL(stats.longestIntervalUs, 0u);
+
+    Wait(1000u);
+    ProfileHost_InjectOverflow(index);
+    Wait(500u);
+    ProfileHost_InjectOverflow(index);
+    ProfileHost_Access(SCB5_MONITOR_AHB, 7u);
+    CHECK_EQUAL(ProfileOverflow_GetCount(index), 0x300000007uLL);
+    (void) Cy_Profile_GetRawCount(counter, &raw);
+    CHECK_EQUAL(raw, 0x300000007uLL);
+    ProfileOverflow_GetStats(index, &stats);
+    CHECK_EQUAL(stats.overflows, 3u);
+    CHECK_EQUAL(stats.lastOverflowUs, 3500u);
+    CHECK_EQUAL(stats.longestIntervalUs, 1000u);
+    CHECK_EQUAL(ProfileOverflow_GetTimeUs(), 3500u);
+}
+
+/**
+********************************************************************************
+* Function Name: TestBudget
+********************************************************************************
+*
+*  Sets a budget of 100 events per window: a window of 150 events, counted
+*  across a wrap of the hardware counter, calls the alert once; a window
+*  of exactly the budget and a window without a budget do not
+*******************************************************************************/
+static void TestBudget(void)
+{
+    cy_stc_profile_ctr_ptr_t counter = Setup();
+    uint32_t index = ProfileOverflow_GetIndex(counter);
+    profile_overflow_stats_t stats;
+
+    Wait(TEST_WINDOW_US);
+    ProfileHost_SetCount(index, 0xFFFFFFFFuL - 49u);
+    ProfileOverflow_SetBudget(index, 100u, &BudgetAlert);
+
+    ProfileHost_Access(SCB5_MONITOR_AHB, 150u);
+    Wait(TEST_WINDOW_US);
+    CHECK_EQUAL(alertCalls, 1u);
+    CHECK_EQUAL(alertCounter, index);
+    CHECK_EQUAL(alertCount, 150u);
+    CHECK_EQUAL(ProfileOverflow_GetCount(index), 0x100000064uLL);
+
+    ProfileHost_Access(SCB5_MONITOR_AHB, 100u);
+    Wait(TEST_WINDOW_US);
+    CHECK_EQUAL(alertCalls, 1u);
+
+    ProfileOverflow_SetBudget(index, 0u, NULL);
+    ProfileHost_Access(SCB5_MONITOR_AHB, 500u);
+    Wait(TEST_WINDOW_US);
+    CHECK_EQUAL(alertCalls, 1u);
+
+    ProfileOverflow_GetStats(index, &stats);
+    CHECK_EQUAL(stats.budgetExceeded, 1u);
+    CHECK_EQUAL(stats.overflows, 1u);
+}
+
+int main(void)
+{
+    TestExtension();
+    TestBudget();
+    printf("ProfileOverflowTest: %u failed\n", failures);
+    return (int) failures;
+}
+
+/* [] END OF FILE */
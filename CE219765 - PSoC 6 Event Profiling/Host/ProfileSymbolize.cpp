@@ -0,0 +1,174 @@
+/*****************************************************************************
+* File Name: ProfileSymbolize.cpp
+*
+* Version 1.0
+*
+* Description: Host symbolizer of the PC samples of ProfilePc.h. It reads
+* the function symbols of the CM4 image, from the ELF file or from the GNU ld
+* map file PSoC Creator writes next to it, then scans a capture of the UART
+* output for the "PCS" lines of ProfilePc_Print() and prints a flat profile:
+* samples per function (PC), per caller (stacked LR) and per hot address.
+* Build:
+*  c++ -std=c++11 ProfileSymbolize.cpp ProfileSymbols.cpp -o ProfileSymbolize
+* Run "ProfileSymbolize CE219765_Event_Profiling.elf capture.txt", a .map file
+* works in place of the .elf. Without a capture stdin is read.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "ProfileSymbols.h"
+
+/* Rows of each table */
+#define SYMBOLIZE_ROWS          (20u)
+
+/* Samples of one function or address, for sorting */
+struct Row
+{
+    std::string name;
+    unsigned long samples;
+};
+
+/**
+********************************************************************************
+* Function Name: PrintTable
+********************************************************************************
+*
+*  Prints the rows with the most samples first
+*******************************************************************************/
+static void PrintTable(const char *title, const std::map<std::string, unsigned long> &counts,
+                       unsigned long total)
+{
+    std::vector<Row> rows;
+    size_t index;
+
+    for (std::map<std::string, unsigned long>::const_iterator it = counts.begin(); it != counts.end(); ++it)
+    {
+        Row row = { it->first, it->second };
+        rows.push_back(row);
+    }
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const Row &a, const Row &b) { return a.samples > b.samples; });
+
+    printf("\n%s\n  %7s %9s  %s\n", title, "%", "Samples", "Location");
+    for (index = 0u; (index < rows.size()) && (index < SYMBOLIZE_ROWS); index++)
+    {
+        printf("  %6.2f%% %9lu  %s\n", (100.0 * rows[index].samples) / total, rows[index].samples,
+               rows[index].name.c_str());
+    }
+    if (rows.size() > SYMBOLIZE_ROWS)
+    {
+        printf("  (%lu more)\n", (unsigned long)(rows.size() - SYMBOLIZE_ROWS));
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: main
+********************************************************************************
+*
+*  Symbolizes the capture given as second argument (or stdin)
+*  Returns 1 when the image or the capture cannot be read or holds no sample
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    std::vector<Symbol> symbols;
+    std::map<std::string, unsigned long> self;
+    std::map<std::string, unsigned long> callers;
+    std::map<std::string, unsigned long> addresses;
+    FILE *capture = stdin;
+    char line[512];
+    unsigned long total = 0u;
+    unsigned long pc;
+    unsigned long lr;
+    unsigned long count;
+
+    if ((argc < 2) || (argc > 3) || (0 == strcmp(argv[1], "--help")))
+    {
+        fprintf(stderr, "Usage: ProfileSymbolize image.elf|image.map [capture]\n");
+        return ((argc == 2) && (0 == strcmp(argv[1], "--help"))) ? 0 : 1;
+    }
+    if (!Symbols_Load(argv[1], symbols))
+    {
+        return 1;
+    }
+    fprintf(stderr, "%lu functions in %s\n", (unsigned long)symbols.size(), argv[1]);
+
+    if (argc == 3)
+    {
+        capture = fopen(argv[2], "rb");
+        if (NULL == capture)
+        {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+    while (NULL != fgets(line, sizeof(line), capture))
+    {
+        /* Terminal escapes may precede the tag */
+        const char *tag = strstr(line, "PCS ");
+        if ((NULL == tag) || (3 != sscanf(tag, "PCS %lx %lx %lu", &pc, &lr, &count)))
+        {
+            continue;
+        }
+        self[Symbols_Name(symbols, (uint32_t)pc, false)] += count;
+        callers[Symbols_Name(symbols, (uint32_t)lr & ~1uL, false)] += count;
+        addresses[Symbols_Name(symbols, (uint32_t)pc, true)] += count;
+        total += count;
+    }
+    if (stdin != capture)
+    {
+        fclose(capture);
+    }
+    if (0u == total)
+    {
+        fprintf(stderr, "no PCS lines found\n");
+        return 1;
+    }
+
+    printf("Flat profile of %lu samples\n", total);
+    PrintTable("Functions (stacked PC)", self, total);
+    PrintTable("Callers (stacked LR, exact for leaf functions)", callers, total);
+    PrintTable("Hot addresses", addresses, total);
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,292 @@
+/*****************************************************************************
+* File Name: ProfileSymbols.cpp
+*
+* Version 1.0
+*
+* Description: Symbol table of the host tools. ELF files are recognized by
+* their magic number and give the STT_FUNC symbols with their sizes; any other
+* file is read as a GNU ld map file, whose .text symbols end at the next one.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "ProfileSymbols.h"
+
+/* ELF32 constants used here */
+#define ELF_CLASS_OFFSET        (4u)
+#define ELF_CLASS_32            (1u)
+#define ELF_SHT_SYMTAB          (2u)
+#define ELF_STT_FUNC            (2u)
+#define ELF_SHDR_SIZE           (40u)
+#define ELF_SYM_SIZE            (16u)
+
+/**
+********************************************************************************
+* Function Name: ReadFile
+********************************************************************************
+*
+*  Reads a whole file into memory, returns false when it cannot be opened
+*******************************************************************************/
+static bool ReadFile(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t chunk[4096];
+    size_t size;
+
+    if (NULL == file)
+    {
+        perror(path);
+        return false;
+    }
+    while (0u != (size = fread(chunk, 1u, sizeof(chunk), file)))
+    {
+        data.insert(data.end(), chunk, chunk + size);
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+********************************************************************************
+* Function Name: Word / Half
+********************************************************************************
+*
+*  Little endian fields of the ELF file, 0 beyond its end
+*******************************************************************************/
+static uint32_t Word(const std::vector<uint8_t> &data, size_t offset)
+{
+    if (offset + 4u > data.size())
+    {
+        return 0u;
+    }
+    return (uint32_t)data[offset] | ((uint32_t)data[offset + 1u] << 8) |
+           ((uint32_t)data[offset + 2u] << 16) | ((uint32_t)data[offset + 3u] << 24);
+}
+
+static uint32_t Half(const std::vector<uint8_t> &data, size_t offset)
+{
+    return (offset + 2u > data.size()) ? 0u : ((uint32_t)data[offset] | ((uint32_t)data[offset + 1u] << 8));
+}
+
+/**
+********************************************************************************
+* Function Name: LoadElf
+********************************************************************************
+*
+*  Collects the STT_FUNC symbols of the symbol table of a 32-bit ELF file.
+*  The Thumb bit is removed from their addresses.
+*******************************************************************************/
+static void LoadElf(const std::vector<uint8_t> &data, std::vector<Symbol> &symbols)
+{
+    uint32_t shoff = Word(data, 0x20u);
+    uint32_t shnum = Half(data, 0x30u);
+    uint32_t section;
+
+    for (section = 0u; section < shnum; section++)
+    {
+        size_t header = shoff + (section * ELF_SHDR_SIZE);
+        if (ELF_SHT_SYMTAB != Word(data, header + 4u))
+        {
+            continue;
+        }
+        uint32_t symOffset = Word(data, header + 16u);
+        uint32_t symSize = Word(data, header + 20u);
+        size_t strHeader = shoff + (Word(data, header + 24u) * ELF_SHDR_SIZE);
+        uint32_t strOffset = Word(data, strHeader + 16u);
+        uint32_t strSize = Word(data, strHeader + 20u);
+        uint32_t entry;
+
+        for (entry = 0u; (entry + 1u) * ELF_SYM_SIZE <= symSize; entry++)
+        {
+            size_t sym = symOffset + (entry * ELF_SYM_SIZE);
+            uint32_t nameOffset = Word(data, sym);
+            if ((sym + ELF_SYM_SIZE > data.size()) || (ELF_STT_FUNC != (data[sym + 12u] & 0x0Fu)) ||
+                (nameOffset >= strSize) || ((size_t)strOffset + strSize > data.size()))
+            {
+                continue;
+            }
+            Symbol symbol;
+            symbol.address = Word(data, sym + 4u) & ~1uL;
+            symbol.size = Word(data, sym + 8u);
+            symbol.name.assign((const char *)&data[strOffset + nameOffset],
+                               strnlen((const char *)&data[strOffset + nameOffset], strSize - nameOffset));
+            symbols.push_back(symbol);
+        }
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: LoadMap
+********************************************************************************
+*
+*  Collects the symbols of the .text input sections of a GNU ld map file,
+*  the "<address> <name>" lines that follow a " .text..." section line.
+*  Map files hold no sizes; a function ends at the next symbol.
+*******************************************************************************/
+static void LoadMap(const std::vector<uint8_t> &data, std::vector<Symbol> &symbols)
+{
+    std::string text(data.begin(), data.end());
+    size_t begin = 0u;
+    bool inText = false;
+
+    while (begin < text.size())
+    {
+        size_t end = text.find('\n', begin);
+        std::string line = text.substr(begin, (std::string::npos == end) ? std::string::npos : end - begin);
+        char first[256];
+        char second[256];
+        char extra[2];
+        int fields;
+
+        begin = (std::string::npos == end) ? text.size() : end + 1u;
+        fields = sscanf(line.c_str(), "%255s %255s %1s", first, second, extra);
+        if ((fields >= 1) && ('.' == first[0]) && (' ' == line[0]))
+        {
+            inText = (0 == strncmp(first, ".text", 5u));
+        }
+        else if ((fields >= 1) && (' ' != line[0]))
+        {
+            /* Output section or other top level line */
+            inText = (0 == strncmp(first, ".text", 5u));
+        }
+        else if (inText && (2 == fields) && (0 == strncmp(first, "0x", 2u)) &&
+                 (NULL == strpbrk(second, "=(.*")))
+        {
+            Symbol symbol;
+            symbol.address = (uint32_t)strtoul(first, NULL, 16) & ~1uL;
+            symbol.size = 0u;
+            symbol.name = second;
+            symbols.push_back(symbol);
+        }
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: Symbols_Load
+********************************************************************************
+*
+*  Reads the functions of an ELF or map file, sorted by address
+*  Returns false when the file cannot be read
+*******************************************************************************/
+bool Symbols_Load(const char *path, std::vector<Symbol> &symbols)
+{
+    static const uint8_t elfMagic[4] = { 0x7Fu, 'E', 'L', 'F' };
+    std::vector<uint8_t> image;
+
+    if (!ReadFile(path, image))
+    {
+        return false;
+    }
+    if ((image.size() >= sizeof(elfMagic)) && (0 == memcmp(&image[0], elfMagic, sizeof(elfMagic))))
+    {
+        if (ELF_CLASS_32 != image[ELF_CLASS_OFFSET])
+        {
+            fprintf(stderr, "%s: not a 32-bit ELF file\n", path);
+            return false;
+        }
+        LoadElf(image, symbols);
+    }
+    else
+    {
+        LoadMap(image, symbols);
+    }
+    std::sort(symbols.begin(), symbols.end(),
+              [](const Symbol &a, const Symbol &b) { return a.address < b.address; });
+    return true;
+}
+
+/**
+********************************************************************************
+* Function Name: Symbols_Lookup
+********************************************************************************
+*
+*  Finds the function of an address in the sorted symbols
+*  Returns NULL when the address is before the first one or beyond its size
+*******************************************************************************/
+const Symbol *Symbols_Lookup(const std::vector<Symbol> &symbols, uint32_t address)
+{
+    std::vector<Symbol>::const_iterator next = std::upper_bound(symbols.begin(), symbols.end(), address,
+        [](uint32_t value, const Symbol &symbol) { return value < symbol.address; });
+
+    if (next == symbols.begin())
+    {
+        return NULL;
+    }
+    --next;
+    if ((0u != next->size) && (address - next->address >= next->size))
+    {
+        return NULL;
+    }
+    return &*next;
+}
+
+/**
+********************************************************************************
+* Function Name: Symbols_Name
+********************************************************************************
+*
+*  Name of the function of an address, or the address itself
+*  withOffset adds "+0x<offset>"
+*******************************************************************************/
+std::string Symbols_Name(const std::vector<Symbol> &symbols, uint32_t address, bool withOffset)
+{
+    const Symbol *symbol = Symbols_Lookup(symbols, address);
+    char text[32];
+
+    if (address >= EXC_RETURN_BASE)
+    {
+        return "<exception return>";
+    }
+    if (NULL == symbol)
+    {
+        snprintf(text, sizeof(text), "<0x%08lx>", (unsigned long)address);
+        return text;
+    }
+    if (!withOffset)
+    {
+        return symbol->name;
+    }
+    snprintf(text, sizeof(text), "+0x%lx", (unsigned long)(address - symbol->address));
+    return symbol->name + text;
+}
+
+/* [] END OF FILE */
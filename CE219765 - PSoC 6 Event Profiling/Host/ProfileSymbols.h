@@ -0,0 +1,70 @@
+/*****************************************************************************
+* File Name: ProfileSymbols.h
+*
+* Version 1.0
+*
+* Description: Definitions of the symbol table of the host tools. The
+* function symbols of the CM4 image are read from the ELF file or from the
+* GNU ld map file PSoC Creator writes next to it.
+*
+* Related Document: Code example CE219765.pdf
+*
+* Hardware Dependency: None (host)
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death (“High Risk Product”). By
+* including Cypress’s product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILESYMBOLS_H
+#define PROFILESYMBOLS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Stacked LR values from this address up are EXC_RETURN codes */
+#define EXC_RETURN_BASE         (0xF0000000uL)
+
+/* One function of the image */
+struct Symbol
+{
+    uint32_t address;
+    uint32_t size;
+    std::string name;
+};
+
+bool Symbols_Load(const char *path, std::vector<Symbol> &symbols);
+const Symbol *Symbols_Lookup(const std::vector<Symbol> &symbols, uint32_t address);
+std::string Symbols_Name(const std::vector<Symbol> &symbols, uint32_t address, bool withOffset);
+
+#endif /* PROFILESYMBOLS_H */
+
+/* [] END OF FILE */
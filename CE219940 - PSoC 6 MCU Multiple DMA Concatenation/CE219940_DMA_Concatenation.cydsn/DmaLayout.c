@@ -0,0 +1,120 @@
+/*******************************************************************************
+* File Name: DmaLayout.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the descriptor math of the DMA concatenation pipeline.
+*  A record is [header][date string][packet] and the records of a batch are
+*  packed back to back in the memory array:
+*   - RxDma_Descriptor_1 copies the alarm tick and textSize date bytes.
+*   - RxDma_Descriptor_2 receives up to packetSize bytes after the date.
+*   - MemoryDma_Descriptor_1 copies recordSize bytes (X) batchSize times (Y),
+*     advancing the destination by recordSize.
+*   - One TxDma record descriptor per record echoes the date and the packet.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "DmaLayout.h"
+
+/*******************************************************************************
+* Function Name: DmaLayout_Compute
+********************************************************************************
+*
+* Validates the requested layout against the limits of the build and the
+* DataWire X/Y counts, then fills the layout structure. The layout structure
+* is only written when the result is DMA_LAYOUT_SUCCESS.
+*
+*******************************************************************************/
+dma_layout_status_t DmaLayout_Compute(const dma_layout_config_t *config,
+    const dma_layout_limits_t *limits, dma_layout_t *layout)
+{
+    uint32_t recordSize;
+    uint32_t echoSize;
+
+    if ((0u == config->packetSize) || (config->packetSize > limits->maxPacketSize))
+    {
+        return DMA_LAYOUT_BAD_PACKET_SIZE;
+    }
+    if ((0u == config->textSize) || (config->textSize > limits->maxTextSize))
+    {
+        return DMA_LAYOUT_BAD_TEXT_SIZE;
+    }
+    if ((0u == config->batchSize) || (config->batchSize > limits->maxBatchSize) ||
+        (config->batchSize > DMA_LAYOUT_MAX_COUNT))
+    {
+        return DMA_LAYOUT_BAD_BATCH_SIZE;
+    }
+
+    recordSize = limits->headerSize + config->textSize + config->packetSize;
+    echoSize = config->textSize + config->packetSize;
+    if ((recordSize > DMA_LAYOUT_MAX_COUNT) ||
+        ((limits->stampSize + config->textSize) > DMA_LAYOUT_MAX_COUNT))
+    {
+        return DMA_LAYOUT_BAD_RECORD_SIZE;
+    }
+    if ((recordSize * config->batchSize) > limits->memorySize)
+    {
+        return DMA_LAYOUT_NO_MEMORY;
+    }
+
+    layout->recordSize       = recordSize;
+    layout->textOffset       = limits->headerSize;
+    layout->packetOffset     = limits->headerSize + config->textSize;
+    layout->rxStampXCount    = limits->stampSize + config->textSize;
+    layout->rxPacketXCount   = config->packetSize;
+    layout->memXCount        = recordSize;
+    layout->memYCount        = config->batchSize;
+    layout->memDstYIncrement = (int32_t)recordSize;
+    layout->txRecordCount    = config->batchSize;
+    layout->txTextXCount     = config->textSize;
+    layout->txMaxXCount      = echoSize;
+    layout->batchBytes       = recordSize * config->batchSize;
+    return DMA_LAYOUT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DmaLayout_RecordOffset
+********************************************************************************
+*
+* Returns the offset of a record in the memory array.
+*
+*******************************************************************************/
+uint32_t DmaLayout_RecordOffset(const dma_layout_t *layout, uint32_t record)
+{
+    return layout->recordSize * record;
+}
+
+/* [] END OF FILE */
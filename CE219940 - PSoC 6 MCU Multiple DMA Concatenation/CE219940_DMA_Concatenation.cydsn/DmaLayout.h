@@ -0,0 +1,108 @@
+/*******************************************************************************
+* File Name: DmaLayout.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the record layout of the DMA
+*  concatenation pipeline. DmaLayout_Compute() turns the packet size, date
+*  string size and batch size into the X/Y counts, increments and offsets of
+*  the RxDma, MemoryDma and TxDma descriptors, and validates them against the
+*  DataWire limits and the available memory. It depends on <stdint.h> only.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef DMALAYOUT_H
+#define DMALAYOUT_H
+
+#include <stdint.h>
+
+/* Largest X and Y count of a DataWire descriptor */
+#define DMA_LAYOUT_MAX_COUNT    (256u)
+
+/* Requested layout */
+typedef struct
+{
+    uint32_t packetSize;        /* Largest packet of a record, in bytes */
+    uint32_t textSize;          /* Bytes of the RTC date string kept per record */
+    uint32_t batchSize;         /* Records per batch */
+} dma_layout_config_t;
+
+/* Descriptor parameters derived from the requested layout */
+typedef struct
+{
+    uint32_t recordSize;        /* Header + date string + packet */
+    uint32_t textOffset;        /* Offset of the date string in a record */
+    uint32_t packetOffset;      /* Offset of the packet in a record */
+    uint32_t rxStampXCount;     /* RxDma_Descriptor_1: alarm tick + date string */
+    uint32_t rxPacketXCount;    /* RxDma_Descriptor_2: packet bytes */
+    uint32_t memXCount;         /* MemoryDma_Descriptor_1: bytes per record */
+    uint32_t memYCount;         /* MemoryDma_Descriptor_1: records per batch */
+    int32_t  memDstYIncrement;  /* MemoryDma_Descriptor_1: record stride */
+    uint32_t txRecordCount;     /* TxDma record descriptors in the chain */
+    uint32_t txTextXCount;      /* TxDma record descriptor: date string part */
+    uint32_t txMaxXCount;       /* TxDma record descriptor: largest echo */
+    uint32_t batchBytes;        /* Memory used by one batch */
+} dma_layout_t;
+
+/* Validation result */
+typedef enum
+{
+    DMA_LAYOUT_SUCCESS          = 0u,
+    DMA_LAYOUT_BAD_PACKET_SIZE  = 1u,   /* Zero or above the packet buffer */
+    DMA_LAYOUT_BAD_TEXT_SIZE    = 2u,   /* Zero or above the date string */
+    DMA_LAYOUT_BAD_BATCH_SIZE   = 3u,   /* Zero or above the descriptor count */
+    DMA_LAYOUT_BAD_RECORD_SIZE  = 4u,   /* Record or echo above DMA_LAYOUT_MAX_COUNT */
+    DMA_LAYOUT_NO_MEMORY        = 5u    /* Batch does not fit the memory array */
+} dma_layout_status_t;
+
+/* Fixed limits of the build */
+typedef struct
+{
+    uint32_t headerSize;        /* Size of the binary record header */
+    uint32_t stampSize;         /* Alarm tick copied in front of the date string */
+    uint32_t maxPacketSize;     /* Size of the packet buffer */
+    uint32_t maxTextSize;       /* Size of the date string buffer */
+    uint32_t maxBatchSize;      /* Number of TxDma record descriptors */
+    uint32_t memorySize;        /* Size of the memory array */
+} dma_layout_limits_t;
+
+dma_layout_status_t DmaLayout_Compute(const dma_layout_config_t *config,
+    const dma_layout_limits_t *limits, dma_layout_t *layout);
+uint32_t DmaLayout_RecordOffset(const dma_layout_t *layout, uint32_t record);
+
+#endif /* DMALAYOUT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,448 @@
+/*******************************************************************************
+* File Name: FlashLog.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the batch log. A page is sealed when the next batch does
+*  not fit, and written by FlashLog_Process() from the main loop, because a
+*  row write stalls execution from flash. The CRC and the commit marker are
+*  checked when the log is mounted and when a page is read back.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "FlashLog.h"
+#include <string.h>     //memcpy, memset
+
+#define FLASH_LOG_CRC_POLY      (0xEDB88320uL)
+
+static void FlashLog_Seal(flash_log_t *log);
+static void FlashLog_Advance(flash_log_t *log, uint32_t skip);
+static uint32_t FlashLog_IsSkipped(const flash_log_t *log, uint32_t row);
+static void FlashLog_SetSkipped(flash_log_t *log, uint32_t row, uint32_t skip);
+static uint32_t FlashLog_Crc(const uint32_t data[FLASH_LOG_ROW_WORDS]);
+static flash_log_status_t FlashLog_Check(const uint32_t data[FLASH_LOG_ROW_WORDS], uint32_t *sequence);
+
+/*******************************************************************************
+* Function Name: FlashLog_Mount
+********************************************************************************
+*
+* The FlashLog_Mount function performs the following actions:
+*  1. Scans the rows for the committed page with the highest sequence.
+*  2. Walks back over the other rows and counts the pages whose sequence
+*     continues the log. The rows in between, left by write errors, are
+*     marked as skipped.
+*  3. Places the head of the log on the row after the newest page.
+*
+*******************************************************************************/
+flash_log_status_t FlashLog_Mount(flash_log_t *log, const flash_log_port_t *port)
+{
+    uint32_t row;
+    uint32_t distance;
+    uint32_t sequence;
+    uint32_t newest = 0u;
+    uint32_t newestRow = 0u;
+    uint32_t found = 0u;
+
+    if ((NULL == port) || (0u == port->numRows) || (port->numRows > FLASH_LOG_MAX_ROWS))
+    {
+        return FLASH_LOG_BAD_PARAM;
+    }
+    (void) memset(log, 0, sizeof(flash_log_t));
+    log->port = port;
+
+    for (row = 0u; row < port->numRows; row++)
+    {
+        port->readRow(row, log->writePage);
+        if ((FLASH_LOG_SUCCESS == FlashLog_Check(log->writePage, &sequence)) &&
+            ((0u == found) || ((int32_t)(sequence - newest) > 0)))
+        {
+            newest = sequence;
+            newestRow = row;
+            found = 1u;
+        }
+    }
+    if (0u == found)
+    {
+        return FLASH_LOG_SUCCESS;
+    }
+
+    /* Walk back over all rows: a page one sequence below the oldest one found
+    * extends the log, any other row is skipped. Skipped rows past the oldest
+    * page are outside the log.
+    */
+    log->rows = 1u;
+    log->pages = 1u;
+    row = newestRow;
+    for (distance = 1u; distance < port->numRows; distance++)
+    {
+        row = (0u == row) ? (port->numRows - 1u) : (row - 1u);
+        port->readRow(row, log->writePage);
+        if ((FLASH_LOG_SUCCESS == FlashLog_Check(log->writePage, &sequence)) &&
+            (sequence == (newest - log->pages)))
+        {
+            log->pages++;
+            log->rows = distance + 1u;
+        }
+        else
+        {
+            FlashLog_SetSkipped(log, row, 1u);
+        }
+    }
+    for (distance = log->rows; distance < port->numRows; distance++)
+    {
+        FlashLog_SetSkipped(log, (newestRow + port->numRows - distance) % port->numRows, 0u);
+    }
+    log->head = (newestRow + 1u) % port->numRows;
+    log->sequence = newest + 1u;
+    return FLASH_LOG_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Append
+********************************************************************************
+*
+* Copies a batch into the page being filled. When it does not fit, the page
+* is sealed and handed to FlashLog_Process first. If the previous page is
+* still pending the batch is dropped and counted.
+*
+*******************************************************************************/
+flash_log_status_t FlashLog_Append(flash_log_t *log, const void *data, uint32_t size)
+{
+    uint8_t *payload = (uint8_t *) log->fillPage + sizeof(flash_log_page_header_t);
+    uint16_t entrySize = (uint16_t) size;
+
+    if ((0u == size) || ((size + FLASH_LOG_ENTRY_SIZE) > FLASH_LOG_PAYLOAD_SIZE))
+    {
+        return FLASH_LOG_BAD_PARAM;
+    }
+    if ((log->fill + FLASH_LOG_ENTRY_SIZE + size) > FLASH_LOG_PAYLOAD_SIZE)
+    {
+        if (0u != log->pending)
+        {
+            log->droppedBatches++;
+            return FLASH_LOG_BUSY;
+        }
+        FlashLog_Seal(log);
+    }
+    (void) memcpy(&payload[log->fill], &entrySize, FLASH_LOG_ENTRY_SIZE);
+    (void) memcpy(&payload[log->fill + FLASH_LOG_ENTRY_SIZE], data, size);
+    log->fill += FLASH_LOG_ENTRY_SIZE + size;
+    log->batches++;
+    return FLASH_LOG_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Flush
+********************************************************************************
+*
+* Seals a partly filled page so that FlashLog_Process writes it, for example
+* before power down. Must not run concurrently with FlashLog_Append.
+*
+*******************************************************************************/
+flash_log_status_t FlashLog_Flush(flash_log_t *log)
+{
+    if (0u == log->fill)
+    {
+        return FLASH_LOG_EMPTY;
+    }
+    if (0u != log->pending)
+    {
+        return FLASH_LOG_BUSY;
+    }
+    FlashLog_Seal(log);
+    return FLASH_LOG_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Process
+********************************************************************************
+*
+* The FlashLog_Process function performs the following actions:
+*  1. Returns when no page is pending.
+*  2. Computes the CRC of the page and writes it to the head row.
+*  3. Advances the head. A row that fails is marked as skipped and the page
+*     stays pending, so it is written to the next row on the next call with
+*     the same sequence.
+*
+*******************************************************************************/
+flash_log_status_t FlashLog_Process(flash_log_t *log)
+{
+    flash_log_page_header_t *header = (flash_log_page_header_t *) log->writePage;
+    int32_t status;
+
+    if (0u == log->pending)
+    {
+        return FLASH_LOG_EMPTY;
+    }
+    header->crc = 0u;
+    header->crc = FlashLog_Crc(log->writePage);
+
+    status = log->port->writeRow(log->head, log->writePage);
+    FlashLog_Advance(log, (0 != status) ? 1u : 0u);
+    if (0 != status)
+    {
+        log->writeErrors++;
+        return FLASH_LOG_WRITE_ERROR;
+    }
+    log->pending = 0u;
+    return FLASH_LOG_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_GetPageCount
+********************************************************************************
+*
+* Returns the number of committed pages that can be read back.
+*
+*******************************************************************************/
+uint32_t FlashLog_GetPageCount(const flash_log_t *log)
+{
+    return log->pages;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_ReadPage
+********************************************************************************
+*
+* Copies a committed page, page 0 being the oldest one, and checks it. The
+* skipped rows of the log are stepped over.
+*
+*******************************************************************************/
+flash_log_status_t FlashLog_ReadPage(const flash_log_t *log, uint32_t page,
+    uint32_t data[FLASH_LOG_ROW_WORDS])
+{
+    uint32_t sequence;
+    uint32_t numRows = log->port->numRows;
+    uint32_t row = (log->head + numRows - log->rows) % numRows;
+
+    if (page >= log->pages)
+    {
+        return FLASH_LOG_EMPTY;
+    }
+    for (;;)
+    {
+        if (0u == FlashLog_IsSkipped(log, row))
+        {
+            if (0u == page)
+            {
+                break;
+            }
+            page--;
+        }
+        row = (row + 1u) % numRows;
+    }
+    log->port->readRow(row, data);
+    return FlashLog_Check(data, &sequence);
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_GetBatch
+********************************************************************************
+*
+* Returns a batch of a page read with FlashLog_ReadPage and its size, or
+* NULL when the page has fewer batches.
+*
+*******************************************************************************/
+const uint8_t * FlashLog_GetBatch(const uint32_t data[FLASH_LOG_ROW_WORDS], uint32_t batch,
+    uint32_t *size)
+{
+    const flash_log_page_header_t *header = (const flash_log_page_header_t *) data;
+    const uint8_t *payload = (const uint8_t *) data + sizeof(flash_log_page_header_t);
+    uint32_t offset = 0u;
+    uint16_t entrySize;
+
+    if (batch >= header->batches)
+    {
+        return NULL;
+    }
+    for (;;)
+    {
+        (void) memcpy(&entrySize, &payload[offset], FLASH_LOG_ENTRY_SIZE);
+        if (0u == batch)
+        {
+            break;
+        }
+        offset += FLASH_LOG_ENTRY_SIZE + entrySize;
+        batch--;
+    }
+    *size = entrySize;
+    return &payload[offset + FLASH_LOG_ENTRY_SIZE];
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Seal
+********************************************************************************
+*
+* Completes the header and the commit marker of the page being filled, hands
+* it to FlashLog_Process and starts an empty page.
+*
+*******************************************************************************/
+static void FlashLog_Seal(flash_log_t *log)
+{
+    flash_log_page_header_t *header = (flash_log_page_header_t *) log->fillPage;
+
+    header->magic = FLASH_LOG_MAGIC;
+    header->sequence = log->sequence;
+    header->length = (uint16_t) log->fill;
+    header->batches = (uint16_t) log->batches;
+    log->fillPage[FLASH_LOG_ROW_WORDS - 1u] = FLASH_LOG_COMMIT ^ log->sequence;
+    (void) memcpy(log->writePage, log->fillPage, FLASH_LOG_ROW_SIZE);
+    log->pending = 1u;
+
+    log->sequence++;
+    log->fill = 0u;
+    log->batches = 0u;
+    (void) memset(log->fillPage, 0, FLASH_LOG_ROW_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Advance
+********************************************************************************
+*
+* Moves the head past the row just written, or just skipped. When the log
+* spans all rows, the head row is its oldest one and leaves the log.
+*
+*******************************************************************************/
+static void FlashLog_Advance(flash_log_t *log, uint32_t skip)
+{
+    if (log->rows < log->port->numRows)
+    {
+        log->rows++;
+    }
+    else if (0u == FlashLog_IsSkipped(log, log->head))
+    {
+        log->pages--;
+    }
+    else
+    {
+        /* The oldest row was skipped, no page leaves the log */
+    }
+    FlashLog_SetSkipped(log, log->head, skip);
+    if (0u == skip)
+    {
+        log->pages++;
+    }
+    log->head = (log->head + 1u) % log->port->numRows;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_IsSkipped
+********************************************************************************
+*
+* Returns 1 if the row is in the log without holding a page.
+*
+*******************************************************************************/
+static uint32_t FlashLog_IsSkipped(const flash_log_t *log, uint32_t row)
+{
+    return (log->skipped[row / 32u] >> (row % 32u)) & 1u;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_SetSkipped
+********************************************************************************
+*
+* Marks the row as skipped, or as holding a page.
+*
+*******************************************************************************/
+static void FlashLog_SetSkipped(flash_log_t *log, uint32_t row, uint32_t skip)
+{
+    if (0u != skip)
+    {
+        log->skipped[row / 32u] |= (1uL << (row % 32u));
+    }
+    else
+    {
+        log->skipped[row / 32u] &= ~(1uL << (row % 32u));
+    }
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Crc
+********************************************************************************
+*
+* Returns the CRC-32 (IEEE 802.3) of a row. The crc field of the header must
+* be zero.
+*
+*******************************************************************************/
+static uint32_t FlashLog_Crc(const uint32_t data[FLASH_LOG_ROW_WORDS])
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint32_t crc = 0xFFFFFFFFuL;
+    uint32_t index;
+    uint32_t bit;
+
+    for (index = 0u; index < FLASH_LOG_ROW_SIZE; index++)
+    {
+        crc ^= bytes[index];
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (crc >> 1u) ^ ((0u != (crc & 1u)) ? FLASH_LOG_CRC_POLY : 0u);
+        }
+    }
+    return ~crc;
+}
+
+/*******************************************************************************
+* Function Name: FlashLog_Check
+********************************************************************************
+*
+* Checks the magic, the commit marker, the length and the CRC of a row and
+* returns the sequence of the page.
+*
+*******************************************************************************/
+static flash_log_status_t FlashLog_Check(const uint32_t data[FLASH_LOG_ROW_WORDS], uint32_t *sequence)
+{
+    flash_log_page_header_t header;
+    uint32_t row[FLASH_LOG_ROW_WORDS];
+
+    (void) memcpy(&header, data, sizeof(header));
+    if ((FLASH_LOG_MAGIC != header.magic) ||
+        ((FLASH_LOG_COMMIT ^ header.sequence) != data[FLASH_LOG_ROW_WORDS - 1u]) ||
+        (header.length > FLASH_LOG_PAYLOAD_SIZE))
+    {
+        return FLASH_LOG_CORRUPT;
+    }
+    (void) memcpy(row, data, FLASH_LOG_ROW_SIZE);
+    ((flash_log_page_header_t *) row)->crc = 0u;
+    if (FlashLog_Crc(row) != header.crc)
+    {
+        return FLASH_LOG_CORRUPT;
+    }
+    *sequence = header.sequence;
+    return FLASH_LOG_SUCCESS;
+}
+
+/* [] END OF FILE */
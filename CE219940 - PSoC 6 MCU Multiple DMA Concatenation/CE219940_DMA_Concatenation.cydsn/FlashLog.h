@@ -0,0 +1,139 @@
+/*******************************************************************************
+* File Name: FlashLog.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the batch log. Completed batches are
+*  coalesced in RAM into row-sized pages and a page is written to flash only
+*  when it is full, so the flash write cost is paid once per page instead of
+*  once per record. Pages are written round robin over the rows of the log
+*  region, so every row is erased once per pass through the log. Each page
+*  carries a sequence number, a CRC and a commit marker in its last word; a
+*  page that was not completely programmed is ignored by FlashLog_Mount().
+*  A row that fails to program is skipped and the page is written to the
+*  next row; the skipped rows stay inside the log window and are stepped
+*  over when pages are read back, so a write error loses no committed page.
+*  The flash itself is accessed through a flash_log_port_t: FlashLogPort.c for
+*  the PSoC 6 flash and Host/FlashLogFile.c for a file-backed stand-in. This
+*  file depends on <stdint.h> only.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+
+#include <stdint.h>
+
+/* Size of a page, equal to a flash row (CY_FLASH_SIZEOF_ROW) */
+#define FLASH_LOG_ROW_SIZE      (512u)
+#define FLASH_LOG_ROW_WORDS     (FLASH_LOG_ROW_SIZE / 4u)
+
+/* Largest log region handled, in rows */
+#define FLASH_LOG_MAX_ROWS      (256u)
+
+/* Page format: [header][entry]...[entry][free][commit word]
+* Every entry is a 16-bit size followed by the batch bytes.
+*/
+#define FLASH_LOG_MAGIC         (0x474F4C46uL)  /* "FLOG" */
+#define FLASH_LOG_COMMIT        (0xC0DE600DuL)  /* XORed with the sequence */
+#define FLASH_LOG_ENTRY_SIZE    (2u)
+#define FLASH_LOG_PAYLOAD_SIZE  (FLASH_LOG_ROW_SIZE - sizeof(flash_log_page_header_t) - 4u)
+
+/* Header at the start of every page */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;          /* Increments by one per page written */
+    uint16_t length;            /* Payload bytes used */
+    uint16_t batches;           /* Entries in the payload */
+    uint32_t crc;               /* CRC-32 of the row with this field zero */
+} flash_log_page_header_t;
+
+/* Access to the flash region of the log */
+typedef struct
+{
+    uint32_t numRows;
+    /* Erases and programs one row, returns 0 on success */
+    int32_t (*writeRow)(uint32_t row, const uint32_t data[FLASH_LOG_ROW_WORDS]);
+    /* Copies one row */
+    void (*readRow)(uint32_t row, uint32_t data[FLASH_LOG_ROW_WORDS]);
+} flash_log_port_t;
+
+/* Result of the log functions */
+typedef enum
+{
+    FLASH_LOG_SUCCESS       = 0u,
+    FLASH_LOG_BAD_PARAM     = 1u,   /* Empty batch, above the page payload or too many rows */
+    FLASH_LOG_BUSY          = 2u,   /* The previous page is not written yet */
+    FLASH_LOG_EMPTY         = 3u,   /* Nothing to write or no such page */
+    FLASH_LOG_WRITE_ERROR   = 4u,   /* The port rejected the row */
+    FLASH_LOG_CORRUPT       = 5u    /* The row does not hold a committed page */
+} flash_log_status_t;
+
+/* Log instance. FlashLog_Append() may run in an interrupt while
+* FlashLog_Process() runs in the main loop: the page being filled and the
+* page being written are separate buffers handed over by the pending flag.
+*/
+typedef struct
+{
+    const flash_log_port_t *port;
+    uint32_t head;              /* Row of the next page written */
+    uint32_t rows;              /* Rows from the oldest page to the head */
+    uint32_t pages;             /* Committed pages in the log */
+    uint32_t skipped[FLASH_LOG_MAX_ROWS / 32u];   /* Rows of the window without a page */
+    uint32_t sequence;          /* Sequence of the next page sealed */
+    uint32_t fill;              /* Payload bytes in the page being filled */
+    uint32_t batches;           /* Entries in the page being filled */
+    volatile uint32_t pending;  /* Sealed page waiting for FlashLog_Process */
+    uint32_t droppedBatches;    /* Batches lost because a page was pending */
+    uint32_t writeErrors;
+    uint32_t fillPage[FLASH_LOG_ROW_WORDS];
+    uint32_t writePage[FLASH_LOG_ROW_WORDS];
+} flash_log_t;
+
+flash_log_status_t FlashLog_Mount(flash_log_t *log, const flash_log_port_t *port);
+flash_log_status_t FlashLog_Append(flash_log_t *log, const void *data, uint32_t size);
+flash_log_status_t FlashLog_Flush(flash_log_t *log);
+flash_log_status_t FlashLog_Process(flash_log_t *log);
+uint32_t FlashLog_GetPageCount(const flash_log_t *log);
+flash_log_status_t FlashLog_ReadPage(const flash_log_t *log, uint32_t page,
+    uint32_t data[FLASH_LOG_ROW_WORDS]);
+const uint8_t * FlashLog_GetBatch(const uint32_t data[FLASH_LOG_ROW_WORDS], uint32_t batch,
+    uint32_t *size);
+
+#endif /* FLASHLOG_H */
+
+/* [] END OF FILE */
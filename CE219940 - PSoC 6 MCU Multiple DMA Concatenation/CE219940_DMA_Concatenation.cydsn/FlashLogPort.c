@@ -0,0 +1,118 @@
+/*******************************************************************************
+* File Name: FlashLogPort.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the PSoC 6 flash port of the batch log. The CM4 request
+*  is executed by the CM0+ through the IPC driver, which must be running.
+*  Execution from flash stalls while a row is programmed. The log region is
+*  the emulated EEPROM flash, which holds nothing of the application image,
+*  so programming the device does not erase the log.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "project.h"
+#include "FlashLogPort.h"
+
+/* Log region at the start of the emulated EEPROM flash, erased rows read as
+* zero. It is read through a volatile pointer: the compiler must not assume
+* the rows keep the content they had at reset.
+*/
+#define FLASH_LOG_BASE          (CY_EM_EEPROM_BASE)
+#define FLASH_LOG_ROW_ADDR(row) (FLASH_LOG_BASE + ((row) * CY_FLASH_SIZEOF_ROW))
+
+#if ((FLASH_LOG_ROWS * CY_FLASH_SIZEOF_ROW) > CY_EM_EEPROM_SIZE)
+    #error "The log region does not fit in the emulated EEPROM flash"
+#endif
+
+static int32_t FlashLogPort_WriteRow(uint32_t row, const uint32_t data[FLASH_LOG_ROW_WORDS]);
+static void FlashLogPort_ReadRow(uint32_t row, uint32_t data[FLASH_LOG_ROW_WORDS]);
+
+static const flash_log_port_t FlashLogPort =
+{
+    .numRows  = FLASH_LOG_ROWS,
+    .writeRow = &FlashLogPort_WriteRow,
+    .readRow  = &FlashLogPort_ReadRow
+};
+
+/*******************************************************************************
+* Function Name: FlashLogPort_Get
+********************************************************************************
+*
+* Returns the port to pass to FlashLog_Mount.
+*
+*******************************************************************************/
+const flash_log_port_t * FlashLogPort_Get(void)
+{
+    return &FlashLogPort;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogPort_WriteRow
+********************************************************************************
+*
+* Erases and programs one row of the log region, then invalidates the flash
+* cache so that the row is read back from the array.
+*
+*******************************************************************************/
+static int32_t FlashLogPort_WriteRow(uint32_t row, const uint32_t data[FLASH_LOG_ROW_WORDS])
+{
+    cy_en_flashdrv_status_t status;
+
+    status = Cy_Flash_WriteRow(FLASH_LOG_ROW_ADDR(row), data);
+    FLASHC->FLASH_CMD = FLASHC_FLASH_CMD_INV_Msk;
+    return (CY_FLASH_DRV_SUCCESS == status) ? 0 : -1;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogPort_ReadRow
+********************************************************************************
+*
+* Copies one row of the log region.
+*
+*******************************************************************************/
+static void FlashLogPort_ReadRow(uint32_t row, uint32_t data[FLASH_LOG_ROW_WORDS])
+{
+    const volatile uint32_t *rowWords = (const volatile uint32_t *) FLASH_LOG_ROW_ADDR(row);
+    uint32_t index;
+
+    for (index = 0u; index < FLASH_LOG_ROW_WORDS; index++)
+    {
+        data[index] = rowWords[index];
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,58 @@
+/*******************************************************************************
+* File Name: FlashLogPort.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the PSoC 6 flash port of the batch
+*  log. The log region is at the start of the emulated EEPROM flash, which
+*  is not programmed with the image, written one row at a time with
+*  Cy_Flash_WriteRow().
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef FLASHLOGPORT_H
+#define FLASHLOGPORT_H
+
+#include "FlashLog.h"
+
+/* Rows of the log region, the 32 KB of emulated EEPROM flash in 512-byte rows */
+#define FLASH_LOG_ROWS          (64u)
+
+const flash_log_port_t * FlashLogPort_Get(void);
+
+#endif /* FLASHLOGPORT_H */
+
+/* [] END OF FILE */
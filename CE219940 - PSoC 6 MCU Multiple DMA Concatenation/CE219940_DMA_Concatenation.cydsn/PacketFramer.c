@@ -0,0 +1,351 @@
+/*******************************************************************************
+* File Name: PacketFramer.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the variable-length packet framing. The RxDma chain is
+*   Tick -> Descriptor_1 -> Descriptor_2 (up to packetMaxSize bytes) -> Close
+*  The close descriptor writes the packet length into the record header and
+*  ends the chain, which triggers the MemoryDma as before. A packet is closed:
+*   - by the next RX trigger when Descriptor_2 is full, or
+*   - by the gap timer ISR after an inter-byte gap or a delimiter. The ISR
+*     rewinds the channel to the close descriptor and triggers it by software.
+*  The gap timer only runs while a packet is being received. Bytes that the
+*  RxDma moved after a delimiter are carried into the next packet: they are
+*  copied to the start of its buffer and Descriptor_2 continues after them.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "PacketFramer.h"
+#include "Timebase.h"
+#include "string.h"     //memcpy
+
+/* Largest packet of the current layout, see PacketFramer_Configure() */
+static uint32_t packetMaxSize = PACKET_MAX_SIZE;
+
+/* Length written into the record header by the close descriptor */
+static uint32_t packetLength = PACKET_MAX_SIZE;
+
+/* Last descriptor of the RxDma chain */
+static cy_stc_dma_descriptor_t closeDescriptor;
+
+/* Gap detection state */
+static uint8_t *packetData;
+static uint32_t lastReceived;
+static uint32_t idleChecks;
+
+/* Bytes received after a delimiter, the start of the next packet */
+static uint8_t carryData[PACKET_MAX_SIZE];
+static uint32_t carryLength;
+/* Carried bytes at the start of the current packet */
+static uint32_t packetCarry;
+
+static uint32_t PacketFramer_GetReceived(void);
+static void PacketFramer_Close(uint32_t length);
+static void PacketFramer_GapCheck(void);
+
+/*******************************************************************************
+* Function Name: PacketFramer_Init
+********************************************************************************
+*
+* The PacketFramer_Init function performs the following actions:
+*  1. Builds the close descriptor that copies the packet length to lengthDst.
+*  2. Chains the close descriptor after RxDma_Descriptor_2 and sets the data
+*     descriptor to PACKET_MAX_SIZE bytes (see PacketFramer_Configure).
+*  3. Configures the gap timer and its interrupt. The timer is not started.
+*
+* Must be called after RxDma_Init().
+*
+*******************************************************************************/
+void PacketFramer_Init(volatile uint32_t *lengthDst, uint8_t *packetBuffer)
+{
+    const cy_stc_dma_descriptor_config_t closeConfig =
+    {
+        .retrigger       = CY_DMA_RETRIG_IM,
+        .interruptType   = CY_DMA_DESCR_CHAIN,
+        .triggerOutType  = CY_DMA_DESCR_CHAIN,
+        .channelState    = CY_DMA_CHANNEL_ENABLED,
+        .triggerInType   = CY_DMA_DESCR,
+        .dataSize        = CY_DMA_WORD,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .descriptorType  = CY_DMA_SINGLE_TRANSFER,
+        .srcAddress      = (void *) &packetLength,
+        .dstAddress      = (void *) lengthDst,
+        .srcXincrement   = 0,
+        .dstXincrement   = 0,
+        .xCount          = 1uL,
+        .srcYincrement   = 0,
+        .dstYincrement   = 0,
+        .yCount          = 1uL,
+        .nextDescriptor  = NULL
+    };
+
+    const cy_stc_tcpwm_counter_config_t gapConfig =
+    {
+        .period             = PACKET_CHECK_US - 1uL,
+        .clockPrescaler     = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode            = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection     = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture   = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0           = 0uL,
+        .compare1           = 0uL,
+        .enableCompareSwap  = false,
+        .interruptSources   = CY_TCPWM_INT_ON_TC,
+        .captureInputMode   = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput       = CY_TCPWM_INPUT_0,
+        .reloadInputMode    = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput        = CY_TCPWM_INPUT_0,
+        .startInputMode     = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput         = CY_TCPWM_INPUT_0,
+        .stopInputMode      = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput          = CY_TCPWM_INPUT_0,
+        .countInputMode     = CY_TCPWM_INPUT_LEVEL,
+        .countInput         = CY_TCPWM_INPUT_1,
+    };
+
+    const cy_stc_sysint_t gapIntrConfig =
+    {
+        .intrSrc      = PACKET_GAP_INTR_SRC,
+        .intrPriority = PACKET_GAP_INTR_PRIORITY
+    };
+
+    /* Extend the RxDma chain with the close descriptor */
+    (void) Cy_DMA_Descriptor_Init(&closeDescriptor, &closeConfig);
+    Cy_DMA_Descriptor_SetNextDescriptor(&RxDma_Descriptor_2, &closeDescriptor);
+    PacketFramer_Configure(packetBuffer, PACKET_MAX_SIZE);
+
+    /* The gap timer ticks with the timebase clock (TIMEBASE_TICK_HZ = 1 MHz) */
+    Cy_SysClk_PeriphAssignDivider(PACKET_GAP_CLK_DST, TIMEBASE_DIV_TYPE, TIMEBASE_DIV_NUM);
+    (void) Cy_TCPWM_Counter_Init(PACKET_GAP_HW, PACKET_GAP_CNT_NUM, &gapConfig);
+    Cy_TCPWM_Enable_Multiple(PACKET_GAP_HW, PACKET_GAP_CNT_MASK);
+
+    (void) Cy_SysInt_Init(&gapIntrConfig, &PacketFramer_GapCheck);
+    NVIC_EnableIRQ(gapIntrConfig.intrSrc);
+    return;
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_Configure
+********************************************************************************
+*
+* Sets the packet buffer and the largest packet of the layout. The
+* destination of RxDma_Descriptor_2 is set to packetBuffer and its X count to
+* maxSize. Carried bytes are discarded. Must be called while the RxDma channel
+* is disabled; maxSize must not exceed PACKET_MAX_SIZE.
+*
+*******************************************************************************/
+void PacketFramer_Configure(uint8_t *packetBuffer, uint32_t maxSize)
+{
+    packetData = packetBuffer;
+    packetMaxSize = maxSize;
+    carryLength = 0u;
+    packetCarry = 0u;
+    Cy_DMA_Descriptor_SetDstAddress(&RxDma_Descriptor_2, packetBuffer);
+    Cy_DMA_Descriptor_SetXloopDataCount(&RxDma_Descriptor_2, maxSize);
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_Rearm
+********************************************************************************
+*
+* Called from the RxDma ISR when the chain has completed, instead of setting
+* the first descriptor directly. Bytes carried from the closed packet are
+* left out of RxDma_Descriptor_2, which continues after them, and the chain
+* is triggered by software as their RX trigger has already been used.
+*
+*******************************************************************************/
+void PacketFramer_Rearm(cy_stc_dma_descriptor_t *first)
+{
+    packetCarry = carryLength;
+    carryLength = 0u;
+    Cy_DMA_Descriptor_SetDstAddress(&RxDma_Descriptor_2, &packetData[packetCarry]);
+    Cy_DMA_Descriptor_SetXloopDataCount(&RxDma_Descriptor_2, packetMaxSize - packetCarry);
+    RxDma_SetDescriptor(first);
+
+    if (0u != packetCarry)
+    {
+        (void) Cy_TrigMux_SwTrigger(PACKET_RX_TR_IN, CY_TRIGGER_TWO_CYCLES);
+    }
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_PacketStarted
+********************************************************************************
+*
+* Called from the RxDma ISR when the tick descriptor of a new packet has been
+* executed. Copies the carried bytes to the start of the packet and starts
+* the gap timer. The MemoryDma has copied the previous record by now: it was
+* triggered by the end of the chain, before the tick descriptor ran.
+*
+*******************************************************************************/
+void PacketFramer_PacketStarted(void)
+{
+    (void) memcpy(packetData, carryData, packetCarry);
+    packetLength = packetMaxSize;
+    /* The carried bytes are checked for a delimiter like received ones */
+    lastReceived = 0u;
+    idleChecks = 0u;
+
+    Cy_TCPWM_Counter_SetCounter(PACKET_GAP_HW, PACKET_GAP_CNT_NUM, 0uL);
+    Cy_TCPWM_TriggerStart(PACKET_GAP_HW, PACKET_GAP_CNT_MASK);
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_PacketDone
+********************************************************************************
+*
+* Called from the RxDma ISR when the chain has completed. Stops the gap timer.
+*
+*******************************************************************************/
+void PacketFramer_PacketDone(void)
+{
+    Cy_TCPWM_TriggerStopOrKill(PACKET_GAP_HW, PACKET_GAP_CNT_MASK);
+    Cy_TCPWM_ClearInterrupt(PACKET_GAP_HW, PACKET_GAP_CNT_NUM, CY_TCPWM_INT_ON_TC);
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_GetReceived
+********************************************************************************
+*
+* Returns the number of packet bytes so far: the carried bytes and the bytes
+* moved by the RxDma, taken from the X index of the channel.
+*
+*******************************************************************************/
+static uint32_t PacketFramer_GetReceived(void)
+{
+    uint32_t received = packetCarry;
+    cy_stc_dma_descriptor_t *current = Cy_DMA_Channel_GetCurrentDescriptor(RxDma_HW, RxDma_DW_CHANNEL);
+
+    if (&RxDma_Descriptor_2 == current)
+    {
+        received += _FLD2VAL(DW_CH_STRUCT_CH_IDX_X_IDX, RxDma_HW->CH_STRUCT[RxDma_DW_CHANNEL].CH_IDX);
+    }
+    else if (&closeDescriptor == current)
+    {
+        received = packetMaxSize;
+    }
+    else
+    {
+        /* Tick or date descriptors, no packet byte yet */
+    }
+    return received;
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_Close
+********************************************************************************
+*
+* The PacketFramer_Close function performs the following actions:
+*  1. Stops the gap timer and the RxDma channel. Bytes that arrive meanwhile
+*     stay in the RX FIFO and start the next packet.
+*  2. Stores the packet length for the close descriptor: length, or all the
+*     received bytes when fewer have been received.
+*  3. Keeps the bytes received after length for the next packet.
+*  4. Moves the channel to the close descriptor and triggers it.
+*
+*******************************************************************************/
+static void PacketFramer_Close(uint32_t length)
+{
+    uint32_t received;
+
+    PacketFramer_PacketDone();
+
+    RxDma_ChannelDisable();
+    received = PacketFramer_GetReceived();
+    packetLength = (length < received) ? length : received;
+    carryLength = received - packetLength;
+    (void) memcpy(carryData, &packetData[packetLength], carryLength);
+    RxDma_SetDescriptor(&closeDescriptor);
+    RxDma_ChannelEnable();
+
+    (void) Cy_TrigMux_SwTrigger(PACKET_RX_TR_IN, CY_TRIGGER_TWO_CYCLES);
+}
+
+/*******************************************************************************
+* Function Name: PacketFramer_GapCheck
+********************************************************************************
+*
+* The PacketFramer_GapCheck ISR runs every PACKET_CHECK_US while a packet is
+* received and performs the following actions:
+*  1. Closes the packet after the first delimiter among the bytes received
+*     since the last check. Several bytes arrive between two checks, the
+*     ones after the delimiter start the next packet.
+*  2. Closes the packet when no byte has arrived for PACKET_GAP_US.
+*  3. Closes the packet when the data descriptor is full.
+*
+*******************************************************************************/
+static void PacketFramer_GapCheck(void)
+{
+    uint32_t received;
+#if defined(PACKET_DELIMITER)
+    uint32_t index;
+#endif /* PACKET_DELIMITER */
+
+    Cy_TCPWM_ClearInterrupt(PACKET_GAP_HW, PACKET_GAP_CNT_NUM, CY_TCPWM_INT_ON_TC);
+
+    received = PacketFramer_GetReceived();
+    if (received != lastReceived)
+    {
+    #if defined(PACKET_DELIMITER)
+        for (index = lastReceived; index < received; index++)
+        {
+            if ((uint8_t)PACKET_DELIMITER == packetData[index])
+            {
+                PacketFramer_Close(index + 1u);
+                return;
+            }
+        }
+    #endif /* PACKET_DELIMITER */
+
+        lastReceived = received;
+        idleChecks = 0u;
+    }
+    else if (0u != received)
+    {
+        idleChecks++;
+        if ((idleChecks >= PACKET_GAP_CHECKS) || (packetMaxSize == received))
+        {
+            PacketFramer_Close(received);
+        }
+    }
+    else
+    {
+        /* Date string still being copied */
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* File Name: PacketFramer.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for variable-length packet framing. The
+*  packet bytes are moved by RxDma_Descriptor_2; the framer only decides where
+*  a packet ends (inter-byte gap, delimiter or full buffer) and closes the
+*  RxDma chain so the record continues through the DMA pipeline.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef PACKETFRAMER_H
+#define PACKETFRAMER_H
+
+#include "project.h"
+
+/* Size of the packet buffer, the largest packet size that can be configured */
+#define PACKET_MAX_SIZE         (64u)
+
+/* Packet terminator. Comment out to frame on inter-byte gaps only. */
+#define PACKET_DELIMITER        ('\r')
+
+/* Interval of the gap checks and the gap that ends a packet, in microseconds.
+* A delimiter is recognised at the next check after it is received; the
+* bytes after it that were already moved by the RxDma are carried.
+*/
+#define PACKET_CHECK_US         (1000u)
+#define PACKET_GAP_US           (500000u)
+#define PACKET_GAP_CHECKS       (PACKET_GAP_US / PACKET_CHECK_US)
+
+/* TCPWM counter used as the gap timer. It shares the timebase clock. */
+#define PACKET_GAP_HW           (TCPWM0)
+#define PACKET_GAP_CNT_NUM      (6u)
+#define PACKET_GAP_CNT_MASK     (1uL << PACKET_GAP_CNT_NUM)
+#define PACKET_GAP_CLK_DST      ((en_clk_dst_t)((uint32_t)PCLK_TCPWM0_CLOCKS0 + PACKET_GAP_CNT_NUM))
+#define PACKET_GAP_INTR_SRC     (tcpwm_0_interrupts_6_IRQn)
+#define PACKET_GAP_INTR_PRIORITY (3u)
+
+/* Trigger mux input of the RxDma channel, used to run the closing descriptor */
+#define PACKET_RX_TR_IN         (RxDma_DW__TR_IN)
+
+void PacketFramer_Init(volatile uint32_t *lengthDst, uint8_t *packetBuffer);
+void PacketFramer_Configure(uint8_t *packetBuffer, uint32_t maxSize);
+void PacketFramer_Rearm(cy_stc_dma_descriptor_t *first);
+void PacketFramer_PacketStarted(void);
+void PacketFramer_PacketDone(void);
+
+#endif /* PACKETFRAMER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,268 @@
+/*******************************************************************************
+* File Name: PipelineStats.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the error and throughput statistics of the DMA
+*  concatenation pipeline. The counters are updated from the DMA and UART
+*  ISRs only; the snapshot is taken inside a critical section so that all
+*  counters of a snapshot belong to the same moment.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "PipelineStats.h"
+#include "Timebase.h"
+#include "string.h"     //memcpy, memset
+
+static pipeline_stats_t stats;
+static uint32_t lastWakeTick;
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountDmaError
+********************************************************************************
+*
+* Counts one interrupt cause other than completion of a DMA channel.
+*
+*******************************************************************************/
+void PipelineStats_CountDmaError(pipeline_dma_t channel, uint32_t cause)
+{
+    pipeline_dma_errors_t *errors = &stats.dma[channel];
+
+    switch(cause)
+    {
+    case CY_DMA_INTR_CAUSE_SRC_BUS_ERROR:
+        errors->srcBusError++;
+        break;
+    case CY_DMA_INTR_CAUSE_DST_BUS_ERROR:
+        errors->dstBusError++;
+        break;
+    case CY_DMA_INTR_CAUSE_SRC_MISAL:
+        errors->srcMisaligned++;
+        break;
+    case CY_DMA_INTR_CAUSE_DST_MISAL:
+        errors->dstMisaligned++;
+        break;
+    case CY_DMA_INTR_CAUSE_CURR_PTR_NULL:
+        errors->currPtrNull++;
+        break;
+    case CY_DMA_INTR_CAUSE_ACTIVE_CH_DISABLED:
+        errors->activeChDisabled++;
+        break;
+    case CY_DMA_INTR_CAUSE_DESCR_BUS_ERROR:
+        errors->descrBusError++;
+        break;
+    default:
+        errors->unknown++;
+        break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountUartErrors
+********************************************************************************
+*
+* Counts the error sources of the UART RX and TX FIFO status.
+*
+*******************************************************************************/
+void PipelineStats_CountUartErrors(uint32_t rxStatus, uint32_t txStatus)
+{
+    if (0u != (rxStatus & CY_SCB_UART_RX_OVERFLOW))
+    {
+        stats.uart.rxOverflow++;
+    }
+    if (0u != (rxStatus & CY_SCB_UART_RX_UNDERFLOW))
+    {
+        stats.uart.rxUnderflow++;
+    }
+    if (0u != (rxStatus & CY_SCB_UART_RX_ERR_FRAME))
+    {
+        stats.uart.rxFrameError++;
+    }
+    if (0u != (rxStatus & CY_SCB_UART_RX_ERR_PARITY))
+    {
+        stats.uart.rxParityError++;
+    }
+    if (0u != (txStatus & CY_SCB_UART_TX_OVERFLOW))
+    {
+        stats.uart.txOverflow++;
+    }
+    if (0u != (txStatus & CY_SCB_UART_TX_UNDERFLOW))
+    {
+        stats.uart.txUnderflow++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountRecovery
+********************************************************************************
+*
+* Counts a channel reset and records its duration. startTick is the timebase
+* count read when the ISR detected the error.
+*
+*******************************************************************************/
+void PipelineStats_CountRecovery(pipeline_dma_t channel, uint32_t startTick)
+{
+    uint32_t duration = Timebase_GetTicks() - startTick;
+
+    stats.dma[channel].recoveries++;
+    stats.lastRecoveryTicks = duration;
+    if (duration > stats.maxRecoveryTicks)
+    {
+        stats.maxRecoveryTicks = duration;
+    }
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountPacket
+********************************************************************************
+*
+* Counts a record completed by the RxDma.
+*
+*******************************************************************************/
+void PipelineStats_CountPacket(void)
+{
+    stats.packets++;
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountBatch
+********************************************************************************
+*
+* Counts a batch of records completed by the MemoryDma.
+*
+*******************************************************************************/
+void PipelineStats_CountBatch(void)
+{
+    stats.batches++;
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountDroppedPacket
+********************************************************************************
+*
+* Counts a partial packet discarded by the RxDma recovery.
+*
+*******************************************************************************/
+void PipelineStats_CountDroppedPacket(void)
+{
+    stats.droppedPackets++;
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountDroppedBatch
+********************************************************************************
+*
+* Counts a partial batch discarded by the MemoryDma recovery.
+*
+*******************************************************************************/
+void PipelineStats_CountDroppedBatch(void)
+{
+    stats.droppedBatches++;
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_CountWakeup
+********************************************************************************
+*
+* Counts a return from Cy_SysPm_Sleep. sleepTick is the timebase count read
+* just before the sleep. The time between sleepTick and the wakeup includes
+* the ISRs that ran, so the residency is an upper bound.
+*
+*******************************************************************************/
+void PipelineStats_CountWakeup(uint32_t sleepTick)
+{
+    uint32_t wakeTick = Timebase_GetTicks();
+
+    stats.wakeups++;
+    stats.sleepTicks += wakeTick - sleepTick;
+    stats.elapsedTicks += wakeTick - lastWakeTick;
+    lastWakeTick = wakeTick;
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_GetSleepReport
+********************************************************************************
+*
+* Returns the wakeups per second and the share of time spent in sleep since
+* the counters were cleared.
+*
+*******************************************************************************/
+void PipelineStats_GetSleepReport(pipeline_sleep_report_t *report)
+{
+    pipeline_stats_t snapshot;
+
+    PipelineStats_GetSnapshot(&snapshot);
+    if (0u == snapshot.elapsedTicks)
+    {
+        report->wakeupsPerSecondX100 = 0u;
+        report->sleepResidencyPermille = 0u;
+        return;
+    }
+    report->wakeupsPerSecondX100 = (uint32_t)(((uint64_t)snapshot.wakeups * 100u * TIMEBASE_TICK_HZ) /
+        snapshot.elapsedTicks);
+    report->sleepResidencyPermille = (uint32_t)((snapshot.sleepTicks * 1000u) / snapshot.elapsedTicks);
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_GetSnapshot
+********************************************************************************
+*
+* Copies all counters into the snapshot with interrupts disabled.
+*
+*******************************************************************************/
+void PipelineStats_GetSnapshot(pipeline_stats_t *snapshot)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+    (void) memcpy(snapshot, &stats, sizeof(stats));
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/*******************************************************************************
+* Function Name: PipelineStats_Clear
+********************************************************************************
+*
+* Resets all counters to zero.
+*
+*******************************************************************************/
+void PipelineStats_Clear(void)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+    (void) memset(&stats, 0, sizeof(stats));
+    lastWakeTick = Timebase_GetTicks();
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/* [] END OF FILE */
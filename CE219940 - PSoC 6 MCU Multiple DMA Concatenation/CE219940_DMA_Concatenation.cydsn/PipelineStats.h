@@ -0,0 +1,122 @@
+/*******************************************************************************
+* File Name: PipelineStats.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the error and throughput statistics
+*  of the DMA concatenation pipeline. The ISRs count every error cause and the
+*  time spent in the recovery path. The application reads a consistent copy
+*  of all counters with PipelineStats_GetSnapshot().
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef PIPELINESTATS_H
+#define PIPELINESTATS_H
+
+#include "project.h"
+
+/* DMA channels of the pipeline */
+typedef enum
+{
+    PIPELINE_RX_DMA     = 0u,
+    PIPELINE_MEMORY_DMA = 1u,
+    PIPELINE_TX_DMA     = 2u,
+    PIPELINE_DMA_NR     = 3u
+} pipeline_dma_t;
+
+/* Error causes of one DMA channel */
+typedef struct
+{
+    uint32_t srcBusError;       /* CY_DMA_INTR_CAUSE_SRC_BUS_ERROR */
+    uint32_t dstBusError;       /* CY_DMA_INTR_CAUSE_DST_BUS_ERROR */
+    uint32_t srcMisaligned;     /* CY_DMA_INTR_CAUSE_SRC_MISAL */
+    uint32_t dstMisaligned;     /* CY_DMA_INTR_CAUSE_DST_MISAL */
+    uint32_t currPtrNull;       /* CY_DMA_INTR_CAUSE_CURR_PTR_NULL */
+    uint32_t activeChDisabled;  /* CY_DMA_INTR_CAUSE_ACTIVE_CH_DISABLED */
+    uint32_t descrBusError;     /* CY_DMA_INTR_CAUSE_DESCR_BUS_ERROR */
+    uint32_t unknown;           /* Any other cause */
+    uint32_t recoveries;        /* Channel resets performed */
+} pipeline_dma_errors_t;
+
+/* Error causes of the UART */
+typedef struct
+{
+    uint32_t rxOverflow;
+    uint32_t rxUnderflow;
+    uint32_t rxFrameError;
+    uint32_t rxParityError;
+    uint32_t txOverflow;
+    uint32_t txUnderflow;
+} pipeline_uart_errors_t;
+
+/* Snapshot of all pipeline counters */
+typedef struct
+{
+    pipeline_dma_errors_t dma[PIPELINE_DMA_NR];
+    pipeline_uart_errors_t uart;
+    uint32_t packets;           /* Records completed by the RxDma */
+    uint32_t batches;           /* Batches completed by the MemoryDma */
+    uint32_t droppedPackets;    /* Partial packets discarded by a recovery */
+    uint32_t droppedBatches;    /* Partial batches discarded by a recovery */
+    uint32_t lastRecoveryTicks; /* Duration of the last recovery in timebase ticks */
+    uint32_t maxRecoveryTicks;  /* Longest recovery in timebase ticks */
+    uint32_t wakeups;           /* Returns from Cy_SysPm_Sleep */
+    uint64_t sleepTicks;        /* Ticks from sleep to wakeup, ISRs included */
+    uint64_t elapsedTicks;      /* Ticks covered by the sleep counters */
+} pipeline_stats_t;
+
+/* Wakeup rate and sleep residency derived from the sleep counters */
+typedef struct
+{
+    uint32_t wakeupsPerSecondX100;
+    uint32_t sleepResidencyPermille;
+} pipeline_sleep_report_t;
+
+void PipelineStats_CountDmaError(pipeline_dma_t channel, uint32_t cause);
+void PipelineStats_CountUartErrors(uint32_t rxStatus, uint32_t txStatus);
+void PipelineStats_CountRecovery(pipeline_dma_t channel, uint32_t startTick);
+void PipelineStats_CountPacket(void);
+void PipelineStats_CountBatch(void);
+void PipelineStats_CountDroppedPacket(void);
+void PipelineStats_CountDroppedBatch(void);
+void PipelineStats_CountWakeup(uint32_t sleepTick);
+void PipelineStats_GetSleepReport(pipeline_sleep_report_t *report);
+void PipelineStats_GetSnapshot(pipeline_stats_t *snapshot);
+void PipelineStats_Clear(void);
+
+#endif /* PIPELINESTATS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/*******************************************************************************
+* File Name: RecordAssembler.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the record assembler. Fields are placed in the order of
+*  the sources, each one aligned to its element size, and the record size is
+*  rounded up to a word. The gather chain is:
+*   source 0 -> source 1 -> ... -> source N-1 -> NULL
+*  The first descriptor takes the trigger for the whole chain. The end of the
+*  chain triggers the store channel, whose 2D descriptor copies the staging
+*  record into the next ring slot and wraps to the first slot by itself.
+*  The gather channel interrupt must call RecordAssembler_Rearm(), which only
+*  points the channel back to the first descriptor, in the same way as
+*  RxDma_Complete does for the RxDma chain.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "RecordAssembler.h"
+
+/* Largest X/Y count of a DataWire descriptor */
+#define RECORD_MAX_COUNT        (256u)
+
+static uint32_t RecordAssembler_ElementSize(cy_en_dma_data_size_t dataSize);
+static uint32_t RecordAssembler_Align(uint32_t offset, uint32_t alignment);
+
+/*******************************************************************************
+* Function Name: RecordAssembler_Init
+********************************************************************************
+*
+* The RecordAssembler_Init function performs the following actions:
+*  1. Validates the sources and computes the field offsets and record size.
+*  2. Builds one descriptor per source and links them into the gather chain.
+*  3. Builds the 2D store descriptor for the ring when a store channel is set.
+*  4. Initializes the channels. They are enabled by RecordAssembler_Start.
+*
+*******************************************************************************/
+record_assembler_status_t RecordAssembler_Init(record_assembler_t *assembler,
+    const record_source_t sources[], uint32_t numSources)
+{
+    cy_stc_dma_descriptor_config_t descrConfig;
+    cy_stc_dma_channel_config_t channelConfig;
+    uint32_t source;
+    uint32_t offset = 0u;
+    uint32_t elementSize;
+
+    if ((NULL == assembler->descriptors) || (NULL == assembler->staging) || (0u == numSources) ||
+        ((NULL != assembler->storeHw) && ((NULL == assembler->ring) || (0u == assembler->ringDepth) ||
+        (assembler->ringDepth > RECORD_MAX_COUNT))))
+    {
+        return RECORD_ASSEMBLER_BAD_PARAM;
+    }
+
+    /* Place the fields */
+    for (source = 0u; source < numSources; source++)
+    {
+        if ((0u == sources[source].count) || (sources[source].count > RECORD_MAX_COUNT) ||
+            (NULL == sources[source].address))
+        {
+            return RECORD_ASSEMBLER_BAD_PARAM;
+        }
+        elementSize = RecordAssembler_ElementSize(sources[source].dataSize);
+        offset = RecordAssembler_Align(offset, elementSize) + (sources[source].count * elementSize);
+    }
+    assembler->recordSize = RecordAssembler_Align(offset, 4u);
+    if ((assembler->recordSize > assembler->stagingSize) || (assembler->recordSize > RECORD_MAX_COUNT))
+    {
+        return RECORD_ASSEMBLER_TOO_LARGE;
+    }
+    assembler->numSources = numSources;
+
+    /* Gather chain: one trigger runs the whole chain */
+    offset = 0u;
+    for (source = 0u; source < numSources; source++)
+    {
+        elementSize = RecordAssembler_ElementSize(sources[source].dataSize);
+        offset = RecordAssembler_Align(offset, elementSize);
+
+        descrConfig.retrigger       = assembler->retrigger;
+        descrConfig.interruptType   = CY_DMA_DESCR_CHAIN;
+        descrConfig.triggerOutType  = CY_DMA_DESCR_CHAIN;
+        descrConfig.channelState    = CY_DMA_CHANNEL_ENABLED;
+        descrConfig.triggerInType   = CY_DMA_DESCR_CHAIN;
+        descrConfig.dataSize        = sources[source].dataSize;
+        /* Peripheral registers are read with word accesses */
+        descrConfig.srcTransferSize = (RECORD_SRC_REGISTER == sources[source].type) ?
+                                      CY_DMA_TRANSFER_SIZE_WORD : CY_DMA_TRANSFER_SIZE_DATA;
+        descrConfig.dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA;
+        descrConfig.descriptorType  = (1u == sources[source].count) ? CY_DMA_SINGLE_TRANSFER : CY_DMA_1D_TRANSFER;
+        descrConfig.srcAddress      = (void *) sources[source].address;
+        descrConfig.dstAddress      = (void *) &assembler->staging[offset];
+        descrConfig.srcXincrement   = (RECORD_SRC_REGISTER == sources[source].type) ? 0 : 1;
+        descrConfig.dstXincrement   = 1;
+        descrConfig.xCount          = sources[source].count;
+        descrConfig.srcYincrement   = 0;
+        descrConfig.dstYincrement   = 0;
+        descrConfig.yCount          = 1uL;
+        descrConfig.nextDescriptor  = (source < (numSources - 1u)) ? &assembler->descriptors[source + 1u] : NULL;
+
+        if (CY_DMA_SUCCESS != Cy_DMA_Descriptor_Init(&assembler->descriptors[source], &descrConfig))
+        {
+            return RECORD_ASSEMBLER_DMA_ERROR;
+        }
+        offset += sources[source].count * elementSize;
+    }
+
+    channelConfig.descriptor  = &assembler->descriptors[0];
+    channelConfig.preemptable = false;
+    channelConfig.priority    = 0u;
+    channelConfig.enable      = false;
+    channelConfig.bufferable  = false;
+    if (CY_DMA_SUCCESS != Cy_DMA_Channel_Init(assembler->gatherHw, assembler->gatherChannel, &channelConfig))
+    {
+        return RECORD_ASSEMBLER_DMA_ERROR;
+    }
+    Cy_DMA_Channel_SetInterruptMask(assembler->gatherHw, assembler->gatherChannel, CY_DMA_INTR_MASK);
+
+    /* Store: one record (X loop) per trigger, the ring wraps to the first slot */
+    if (NULL != assembler->storeHw)
+    {
+        descrConfig.retrigger       = CY_DMA_RETRIG_IM;
+        descrConfig.interruptType   = CY_DMA_DESCR;
+        descrConfig.triggerOutType  = CY_DMA_X_LOOP;
+        descrConfig.channelState    = CY_DMA_CHANNEL_ENABLED;
+        descrConfig.triggerInType   = CY_DMA_X_LOOP;
+        descrConfig.dataSize        = CY_DMA_WORD;
+        descrConfig.srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA;
+        descrConfig.dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA;
+        descrConfig.descriptorType  = CY_DMA_2D_TRANSFER;
+        descrConfig.srcAddress      = (void *) assembler->staging;
+        descrConfig.dstAddress      = (void *) assembler->ring;
+        descrConfig.srcXincrement   = 1;
+        descrConfig.dstXincrement   = 1;
+        descrConfig.xCount          = assembler->recordSize / 4u;
+        descrConfig.srcYincrement   = 0;
+        descrConfig.dstYincrement   = (int32_t)(assembler->recordSize / 4u);
+        descrConfig.yCount          = assembler->ringDepth;
+        descrConfig.nextDescriptor  = &assembler->storeDescriptor;
+
+        if (CY_DMA_SUCCESS != Cy_DMA_Descriptor_Init(&assembler->storeDescriptor, &descrConfig))
+        {
+            return RECORD_ASSEMBLER_DMA_ERROR;
+        }
+        channelConfig.descriptor = &assembler->storeDescriptor;
+        if (CY_DMA_SUCCESS != Cy_DMA_Channel_Init(assembler->storeHw, assembler->storeChannel, &channelConfig))
+        {
+            return RECORD_ASSEMBLER_DMA_ERROR;
+        }
+    }
+    return RECORD_ASSEMBLER_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_Start
+********************************************************************************
+*
+* Enables the store and gather channels and their DataWire blocks.
+*
+*******************************************************************************/
+void RecordAssembler_Start(record_assembler_t *assembler)
+{
+    if (NULL != assembler->storeHw)
+    {
+        Cy_DMA_Channel_Enable(assembler->storeHw, assembler->storeChannel);
+        Cy_DMA_Enable(assembler->storeHw);
+    }
+    Cy_DMA_Channel_Enable(assembler->gatherHw, assembler->gatherChannel);
+    Cy_DMA_Enable(assembler->gatherHw);
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_Stop
+********************************************************************************
+*
+* Disables the gather and store channels. The DataWire blocks stay enabled
+* because other channels may use them.
+*
+*******************************************************************************/
+void RecordAssembler_Stop(record_assembler_t *assembler)
+{
+    Cy_DMA_Channel_Disable(assembler->gatherHw, assembler->gatherChannel);
+    if (NULL != assembler->storeHw)
+    {
+        Cy_DMA_Channel_Disable(assembler->storeHw, assembler->storeChannel);
+    }
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_Rearm
+********************************************************************************
+*
+* Must be called from the interrupt of the gather channel. Clears the
+* interrupt and resets the chain to the first descriptor for the next
+* trigger. No record data is touched by the CPU.
+*
+*******************************************************************************/
+void RecordAssembler_Rearm(record_assembler_t *assembler)
+{
+    Cy_DMA_Channel_ClearInterrupt(assembler->gatherHw, assembler->gatherChannel);
+    Cy_DMA_Channel_SetDescriptor(assembler->gatherHw, assembler->gatherChannel, &assembler->descriptors[0]);
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_GetFieldOffset
+********************************************************************************
+*
+* Returns the offset of the field of a source inside the record.
+*
+*******************************************************************************/
+uint32_t RecordAssembler_GetFieldOffset(const record_assembler_t *assembler, uint32_t source)
+{
+    return (uint32_t)((const uint8_t *) Cy_DMA_Descriptor_GetDstAddress(&assembler->descriptors[source]) -
+        assembler->staging);
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_GetRecord
+********************************************************************************
+*
+* Returns a record of the ring, or the staging record when no ring is used.
+*
+*******************************************************************************/
+uint8_t * RecordAssembler_GetRecord(const record_assembler_t *assembler, uint32_t record)
+{
+    return (NULL != assembler->storeHw) ? &assembler->ring[record * assembler->recordSize] : assembler->staging;
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_ElementSize
+********************************************************************************
+*
+* Returns the element size in bytes.
+*
+*******************************************************************************/
+static uint32_t RecordAssembler_ElementSize(cy_en_dma_data_size_t dataSize)
+{
+    return (CY_DMA_WORD == dataSize) ? 4u : ((CY_DMA_HALFWORD == dataSize) ? 2u : 1u);
+}
+
+/*******************************************************************************
+* Function Name: RecordAssembler_Align
+********************************************************************************
+*
+* Rounds the offset up to a multiple of the alignment (a power of two).
+*
+*******************************************************************************/
+static uint32_t RecordAssembler_Align(uint32_t offset, uint32_t alignment)
+{
+    return (offset + (alignment - 1u)) & ~(alignment - 1u);
+}
+
+/* [] END OF FILE */
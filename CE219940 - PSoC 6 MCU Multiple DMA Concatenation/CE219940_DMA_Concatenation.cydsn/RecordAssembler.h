@@ -0,0 +1,123 @@
+/*******************************************************************************
+* File Name: RecordAssembler.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the record assembler. The caller
+*  describes a record as a list of sources (peripheral registers, memory
+*  slices or constant headers). The assembler builds one DataWire descriptor
+*  per source and links them into a chain that gathers a complete record on
+*  every trigger of the gather channel, without any CPU copy.
+*
+*  A second, optional channel stores every record into a ring of records. Its
+*  trigger input must be connected to the trigger output of the gather
+*  channel in the schematic, like MemoryDma is connected to RxDma.
+*
+*  Example, a counter value, a constant sync word and 8 ADC results:
+*   static const uint16_t sync = 0xA55Au;
+*   static const record_source_t sources[] =
+*   {
+*       { RECORD_SRC_CONSTANT, &sync,                    1u, CY_DMA_HALFWORD },
+*       { RECORD_SRC_REGISTER, &TCPWM0->CNT[7].COUNTER, 1u, CY_DMA_WORD },
+*       { RECORD_SRC_MEMORY,   adcResults,               8u, CY_DMA_HALFWORD },
+*   };
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef RECORDASSEMBLER_H
+#define RECORDASSEMBLER_H
+
+#include "project.h"
+
+/* Kind of record source, selects the source increment of the descriptor */
+typedef enum
+{
+    RECORD_SRC_REGISTER = 0u,   /* Peripheral register or FIFO, read in place */
+    RECORD_SRC_MEMORY   = 1u,   /* Slice of SRAM, read element by element */
+    RECORD_SRC_CONSTANT = 2u    /* Constant header in flash or SRAM */
+} record_src_type_t;
+
+/* One field of the record */
+typedef struct
+{
+    record_src_type_t type;
+    const volatile void *address;   /* Register, memory slice or constant */
+    uint32_t count;                 /* Number of elements, 1 to 256 */
+    cy_en_dma_data_size_t dataSize; /* Element size, also the field alignment */
+} record_source_t;
+
+/* Assembler instance. The descriptor array must hold one descriptor per
+* source and must stay valid while the assembler runs.
+*/
+typedef struct
+{
+    DW_Type *gatherHw;              /* Channel that gathers the record */
+    uint32_t gatherChannel;
+    DW_Type *storeHw;               /* Channel that stores the record, NULL if unused */
+    uint32_t storeChannel;
+    cy_en_dma_retrigger_t retrigger;/* Retrigger setting of the gather chain */
+    cy_stc_dma_descriptor_t *descriptors;
+    uint8_t *staging;               /* Word aligned, holds one record */
+    uint32_t stagingSize;
+    uint8_t *ring;                  /* Word aligned, holds ringDepth records */
+    uint32_t ringDepth;
+
+    /* Filled by RecordAssembler_Init */
+    uint32_t numSources;
+    uint32_t recordSize;
+    cy_stc_dma_descriptor_t storeDescriptor;
+} record_assembler_t;
+
+/* Result of RecordAssembler_Init */
+typedef enum
+{
+    RECORD_ASSEMBLER_SUCCESS     = 0u,
+    RECORD_ASSEMBLER_BAD_PARAM   = 1u,  /* Missing buffer, source or count */
+    RECORD_ASSEMBLER_TOO_LARGE   = 2u,  /* Record above the staging buffer or 256 bytes */
+    RECORD_ASSEMBLER_DMA_ERROR   = 3u   /* Descriptor or channel rejected by the driver */
+} record_assembler_status_t;
+
+record_assembler_status_t RecordAssembler_Init(record_assembler_t *assembler,
+    const record_source_t sources[], uint32_t numSources);
+void RecordAssembler_Start(record_assembler_t *assembler);
+void RecordAssembler_Stop(record_assembler_t *assembler);
+void RecordAssembler_Rearm(record_assembler_t *assembler);
+uint32_t RecordAssembler_GetFieldOffset(const record_assembler_t *assembler, uint32_t source);
+uint8_t * RecordAssembler_GetRecord(const record_assembler_t *assembler, uint32_t record);
+
+#endif /* RECORDASSEMBLER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/*******************************************************************************
+* File Name: StringEmitter.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the constant string emitter. The descriptors use the
+*  settings of TxDma_Descriptor_1 like the record descriptors: one byte per
+*  UART TX FIFO trigger. Only the end of their chain raises the TxDma
+*  interrupt.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "StringEmitter.h"
+#include "TxWindow.h"
+#include "string.h"     //strlen
+
+/*******************************************************************************
+* Function Name: StringEmitter_Init
+********************************************************************************
+*
+* Builds a descriptor that sends a string to the UART TX FIFO, then chains to
+* next. The string must stay valid, it is read by the DMA.
+*
+*******************************************************************************/
+cy_en_dma_status_t StringEmitter_Init(cy_stc_dma_descriptor_t *descriptor, const char *string,
+    cy_stc_dma_descriptor_t *next)
+{
+    cy_stc_dma_descriptor_config_t stringConfig = TxDma_Descriptor_1_config;
+    uint32_t length = strlen(string);
+
+    if ((0u == length) || (length > STRING_EMITTER_MAX_LENGTH))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+    stringConfig.descriptorType = (1u == length) ? CY_DMA_SINGLE_TRANSFER : CY_DMA_1D_TRANSFER;
+    stringConfig.srcAddress = (void *) string;
+    stringConfig.dstAddress = (void *) &UART_HW->TX_FIFO_WR;
+    stringConfig.xCount = length;
+    stringConfig.yCount = 1uL;
+    stringConfig.nextDescriptor = next;
+    /* TxDma_Complete disables the channel, so only the end of the chain interrupts */
+    stringConfig.interruptType = CY_DMA_DESCR_CHAIN;
+    return Cy_DMA_Descriptor_Init(descriptor, &stringConfig);
+}
+
+/*******************************************************************************
+* Function Name: StringEmitter_Chain
+********************************************************************************
+*
+* Builds one descriptor per string and links them in order, the last one
+* chains to next.
+*
+*******************************************************************************/
+cy_en_dma_status_t StringEmitter_Chain(cy_stc_dma_descriptor_t descriptors[], const char *const strings[],
+    uint32_t count, cy_stc_dma_descriptor_t *next)
+{
+    cy_en_dma_status_t status = CY_DMA_SUCCESS;
+    uint32_t index;
+
+    for (index = 0u; (index < count) && (CY_DMA_SUCCESS == status); index++)
+    {
+        status = StringEmitter_Init(&descriptors[index], strings[index],
+            (index < (count - 1u)) ? &descriptors[index + 1u] : next);
+    }
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: StringEmitter_Start
+********************************************************************************
+*
+* Sends a chain of strings when the TxDma is idle. The claim keeps windows
+* from reprogramming the channel until TxDma_Complete ends the chain. Returns
+* false, without sending, when the TxDma is busy.
+*
+*******************************************************************************/
+bool StringEmitter_Start(cy_stc_dma_descriptor_t *first)
+{
+    if (!TxWindow_Claim())
+    {
+        return false;
+    }
+    TxDma_SetDescriptor(first);
+    TxDma_ChannelEnable();
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* File Name: StringEmitter.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the constant string emitter. A
+*  string in flash is sent to the UART by a TxDma descriptor, which can be
+*  chained after the record descriptors or started on its own, so that the
+*  CPU never waits for the TX FIFO.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef STRINGEMITTER_H
+#define STRINGEMITTER_H
+
+#include "project.h"
+
+/* Longest string of one descriptor (X count) */
+#define STRING_EMITTER_MAX_LENGTH   (256u)
+
+cy_en_dma_status_t StringEmitter_Init(cy_stc_dma_descriptor_t *descriptor, const char *string,
+    cy_stc_dma_descriptor_t *next);
+cy_en_dma_status_t StringEmitter_Chain(cy_stc_dma_descriptor_t descriptors[], const char *const strings[],
+    uint32_t count, cy_stc_dma_descriptor_t *next);
+bool StringEmitter_Start(cy_stc_dma_descriptor_t *first);
+
+#endif /* STRINGEMITTER_H */
+
+/* [] END OF FILE */
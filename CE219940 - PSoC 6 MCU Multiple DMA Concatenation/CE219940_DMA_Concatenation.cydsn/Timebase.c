@@ -0,0 +1,208 @@
+/*******************************************************************************
+* File Name: Timebase.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the sub-second timebase. The timebase combines the one
+*  second resolution of the RTC with a free running TCPWM counter:
+*   - The RxDma chain copies the counter value into each record (packetTick).
+*   - The RTC alarm ISR latches the counter (alarmTick) together with the date
+*     string, so each record carries both values.
+*   - The number of ticks between two alarms is measured against the WCO and
+*     filtered to correct the drift of the counter clock.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "Timebase.h"
+
+/* Expected number of ticks between two alarms */
+#define TIMEBASE_NOMINAL_DELTA  (TIMEBASE_TICK_HZ * TIMEBASE_ALARM_PERIOD)
+#define TIMEBASE_MAX_ERROR      ((TIMEBASE_NOMINAL_DELTA / 1000000uL) * TIMEBASE_MAX_DRIFT_PPM)
+
+/* Timebase state */
+static uint32_t lastAlarmTick;
+static uint32_t rateQ8 = TIMEBASE_TICK_HZ << TIMEBASE_RATE_FRAC_BITS;
+static uint32_t alarmCount;
+static uint32_t rejectCount;
+
+/*******************************************************************************
+* Function Name: Timebase_Start
+********************************************************************************
+*
+* The Timebase_Start function performs the following actions:
+*  1. Assigns a peripheral clock divider that runs the counter at
+*     TIMEBASE_TICK_HZ.
+*  2. Configures the TCPWM counter as a free-running 32-bit up counter.
+*  3. Starts the counter.
+*
+*******************************************************************************/
+void Timebase_Start(void)
+{
+    const cy_stc_tcpwm_counter_config_t counterConfig =
+    {
+        .period             = 0xFFFFFFFFuL,
+        .clockPrescaler     = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode            = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection     = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture   = CY_TCPWM_COUNTER_MODE_COMPARE,
+        .compare0           = 0uL,
+        .compare1           = 0uL,
+        .enableCompareSwap  = false,
+        .interruptSources   = CY_TCPWM_INT_NONE,
+        .captureInputMode   = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput       = CY_TCPWM_INPUT_0,
+        .reloadInputMode    = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput        = CY_TCPWM_INPUT_0,
+        .startInputMode     = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput         = CY_TCPWM_INPUT_0,
+        .stopInputMode      = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput          = CY_TCPWM_INPUT_0,
+        .countInputMode     = CY_TCPWM_INPUT_LEVEL,
+        .countInput         = CY_TCPWM_INPUT_1,
+    };
+
+    /* Derive the tick clock from clk_peri */
+    Cy_SysClk_PeriphAssignDivider(TIMEBASE_CLK_DST, TIMEBASE_DIV_TYPE, TIMEBASE_DIV_NUM);
+    Cy_SysClk_PeriphSetDivider(TIMEBASE_DIV_TYPE, TIMEBASE_DIV_NUM,
+        (cy_PeriClkFreqHz / TIMEBASE_TICK_HZ) - 1uL);
+    Cy_SysClk_PeriphEnableDivider(TIMEBASE_DIV_TYPE, TIMEBASE_DIV_NUM);
+
+    /* Configure and start the free-running counter */
+    (void) Cy_TCPWM_Counter_Init(TIMEBASE_HW, TIMEBASE_CNT_NUM, &counterConfig);
+    Cy_TCPWM_Enable_Multiple(TIMEBASE_HW, TIMEBASE_CNT_MASK);
+    Cy_TCPWM_TriggerStart(TIMEBASE_HW, TIMEBASE_CNT_MASK);
+
+    lastAlarmTick = Cy_TCPWM_Counter_GetCounter(TIMEBASE_HW, TIMEBASE_CNT_NUM);
+    return;
+}
+
+/*******************************************************************************
+* Function Name: Timebase_AlarmLatch
+********************************************************************************
+*
+* Must be called first thing in the RTC alarm ISR. Performs the following:
+*  1. Latches the counter value for the current RTC second.
+*  2. Measures the ticks since the previous alarm against the WCO and
+*     updates the filtered tick rate when the measurement is plausible.
+*
+* Returns the latched counter value.
+*
+*******************************************************************************/
+uint32_t Timebase_AlarmLatch(void)
+{
+    uint32_t tick = Cy_TCPWM_Counter_GetCounter(TIMEBASE_HW, TIMEBASE_CNT_NUM);
+    uint32_t delta = tick - lastAlarmTick;
+    int32_t  error = (int32_t)(delta - TIMEBASE_NOMINAL_DELTA);
+
+    /* The first alarm only arms the measurement */
+    if (0uL != alarmCount)
+    {
+        if ((error <= (int32_t)TIMEBASE_MAX_ERROR) && (error >= -(int32_t)TIMEBASE_MAX_ERROR))
+        {
+            /* Single pole IIR filter of the rate in Q8 format */
+            int32_t measuredQ8 = (int32_t)((delta / TIMEBASE_ALARM_PERIOD) << TIMEBASE_RATE_FRAC_BITS);
+            rateQ8 = (uint32_t)((int32_t)rateQ8 + ((measuredQ8 - (int32_t)rateQ8) >> TIMEBASE_FILTER_SHIFT));
+        }
+        else
+        {
+            rejectCount++;
+        }
+    }
+
+    alarmCount++;
+    lastAlarmTick = tick;
+    return tick;
+}
+
+/*******************************************************************************
+* Function Name: Timebase_GetTicks
+********************************************************************************
+*
+* Returns the current counter value.
+*
+*******************************************************************************/
+uint32_t Timebase_GetTicks(void)
+{
+    return Cy_TCPWM_Counter_GetCounter(TIMEBASE_HW, TIMEBASE_CNT_NUM);
+}
+
+/*******************************************************************************
+* Function Name: Timebase_GetCounterAddress
+********************************************************************************
+*
+* Returns the address of the counter register to be used as a DMA source.
+*
+*******************************************************************************/
+volatile uint32_t * Timebase_GetCounterAddress(void)
+{
+    return &TIMEBASE_HW->CNT[TIMEBASE_CNT_NUM].COUNTER;
+}
+
+/*******************************************************************************
+* Function Name: Timebase_StampToMicroseconds
+********************************************************************************
+*
+* Converts the timestamp header of a record into the microseconds elapsed
+* between the RTC second of the record and the arrival of the packet. The
+* conversion uses the drift-corrected tick rate.
+*
+*******************************************************************************/
+uint32_t Timebase_StampToMicroseconds(const timebase_stamp_t *stamp)
+{
+    uint64_t ticks = (uint64_t)(stamp->packetTick - stamp->alarmTick);
+
+    return (uint32_t)(((ticks * 1000000uLL) << TIMEBASE_RATE_FRAC_BITS) / rateQ8);
+}
+
+/*******************************************************************************
+* Function Name: Timebase_GetStatus
+********************************************************************************
+*
+* Fills the status structure with the drift correction results.
+*
+*******************************************************************************/
+void Timebase_GetStatus(timebase_status_t *status)
+{
+    uint32_t rate = rateQ8;
+
+    status->ticksPerSecond = rate >> TIMEBASE_RATE_FRAC_BITS;
+    status->driftPpm = (int32_t)(((int64_t)rate - (int64_t)(TIMEBASE_TICK_HZ << TIMEBASE_RATE_FRAC_BITS))
+        * 1000000 / (int64_t)(TIMEBASE_TICK_HZ << TIMEBASE_RATE_FRAC_BITS));
+    status->alarmCount = alarmCount;
+    status->rejectCount = rejectCount;
+}
+
+/* [] END OF FILE */
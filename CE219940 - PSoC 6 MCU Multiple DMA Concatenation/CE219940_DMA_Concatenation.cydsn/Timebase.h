@@ -0,0 +1,103 @@
+/*******************************************************************************
+* File Name: Timebase.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the sub-second timebase. A free
+*  running TCPWM counter provides the ticks that the RxDma chain captures
+*  with every packet. The counter is latched at each RTC alarm and its rate
+*  is disciplined against the Watch-Crystal Oscillator that clocks the RTC.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "project.h"
+
+/* TCPWM counter used as the timebase. TCPWM0 provides the 32-bit counters. */
+#define TIMEBASE_HW             (TCPWM0)
+#define TIMEBASE_CNT_NUM        (7u)
+#define TIMEBASE_CNT_MASK       (1uL << TIMEBASE_CNT_NUM)
+
+/* Peripheral clock divider that feeds the timebase counter */
+#define TIMEBASE_CLK_DST        ((en_clk_dst_t)((uint32_t)PCLK_TCPWM0_CLOCKS0 + TIMEBASE_CNT_NUM))
+#define TIMEBASE_DIV_TYPE       (CY_SYSCLK_DIV_16_BIT)
+#define TIMEBASE_DIV_NUM        (7u)
+
+/* Nominal tick frequency, one tick per microsecond */
+#define TIMEBASE_TICK_HZ        (1000000uL)
+
+/* Period of the RTC alarm that latches the counter, in seconds */
+#define TIMEBASE_ALARM_PERIOD   (1uL)
+
+/* Alarm intervals further than this from nominal are not used for drift
+* correction (missed or delayed alarms). Value in parts per million.
+*/
+#define TIMEBASE_MAX_DRIFT_PPM  (50000uL)
+
+/* Weight of every new WCO measurement in the rate filter is 1/2^SHIFT */
+#define TIMEBASE_FILTER_SHIFT   (3u)
+
+/* Fractional bits of the filtered tick rate */
+#define TIMEBASE_RATE_FRAC_BITS (8u)
+
+/* Timestamp header placed at the start of every record by the RxDma chain */
+typedef struct
+{
+    uint32_t packetTick;    /* Counter value captured when the packet arrived */
+    uint32_t alarmTick;     /* Counter value latched at the preceding RTC alarm */
+} timebase_stamp_t;
+
+/* Drift correction status */
+typedef struct
+{
+    uint32_t ticksPerSecond;    /* Measured counter rate against the WCO */
+    int32_t  driftPpm;          /* Deviation of the counter clock from nominal */
+    uint32_t alarmCount;        /* Alarms latched since Timebase_Start */
+    uint32_t rejectCount;       /* Alarm intervals rejected by the filter */
+} timebase_status_t;
+
+void Timebase_Start(void);
+uint32_t Timebase_AlarmLatch(void);
+uint32_t Timebase_GetTicks(void);
+volatile uint32_t * Timebase_GetCounterAddress(void);
+uint32_t Timebase_StampToMicroseconds(const timebase_stamp_t *stamp);
+void Timebase_GetStatus(timebase_status_t *status);
+
+#endif /* TIMEBASE_H */
+
+/* [] END OF FILE */
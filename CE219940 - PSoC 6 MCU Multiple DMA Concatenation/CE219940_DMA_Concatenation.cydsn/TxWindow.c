@@ -0,0 +1,299 @@
+/*******************************************************************************
+* File Name: TxWindow.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the TX windows. The RTC alarm ISR, the MemoryDma ISR and
+*  the TxDma ISR share the slot states, so every function runs in a critical
+*  section. A slot is free, held (complete, waiting for a window) or being
+*  sent. The window is "due" when it should open; it opens when the TxDma is
+*  idle and the caller asks for the slots with TxWindow_Release().
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include "TxWindow.h"
+#include "string.h"     //memset
+
+typedef enum
+{
+    SLOT_FREE    = 0u,
+    SLOT_HELD    = 1u,
+    SLOT_SENDING = 2u
+} slot_state_t;
+
+static tx_window_config_t windowConfig;
+static tx_window_status_t windowStatus;
+static slot_state_t slotState[TX_WINDOW_SLOTS];
+static uint32_t slotSecond[TX_WINDOW_SLOTS];    /* Alarm count when held */
+static uint32_t slotOrder[TX_WINDOW_SLOTS];     /* Held slots, oldest first */
+static uint32_t fillSlot;
+static uint32_t seconds;
+static bool due;
+static bool forced;
+static bool sending;
+
+/*******************************************************************************
+* Function Name: TxWindow_Init
+********************************************************************************
+*
+* Applies the window settings and frees all slots. The MemoryDma fills slot 0.
+*
+*******************************************************************************/
+void TxWindow_Init(const tx_window_config_t *config)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    windowConfig = *config;
+    (void) memset(&windowStatus, 0, sizeof(windowStatus));
+    (void) memset(slotState, 0, sizeof(slotState));
+    fillSlot = 0u;
+    seconds = 0u;
+    due = false;
+    forced = false;
+    sending = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_Configure
+********************************************************************************
+*
+* Changes the window settings while running. Held batches are kept and the
+* new settings apply from the next RTC alarm.
+*
+*******************************************************************************/
+void TxWindow_Configure(const tx_window_config_t *config)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+    windowConfig = *config;
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_GetFillSlot
+********************************************************************************
+*
+* Returns the slot the MemoryDma writes the current batch into.
+*
+*******************************************************************************/
+uint32_t TxWindow_GetFillSlot(void)
+{
+    return fillSlot;
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_BatchDone
+********************************************************************************
+*
+* The TxWindow_BatchDone function performs the following actions:
+*  1. Holds the batch of the fill slot.
+*  2. Moves the fill slot to a free slot. Without a free slot the batch just
+*     completed is dropped and its slot is filled again.
+*  3. Returns true when the held batches must be sent now: no hold is
+*     configured or no free slot is left.
+*
+*******************************************************************************/
+bool TxWindow_BatchDone(void)
+{
+    uint32_t slot;
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    slotState[fillSlot] = SLOT_HELD;
+    slotSecond[fillSlot] = seconds;
+    slotOrder[windowStatus.held] = fillSlot;
+    windowStatus.held++;
+
+    for (slot = 0u; (slot < TX_WINDOW_SLOTS) && (SLOT_FREE != slotState[slot]); slot++)
+    {
+    }
+    if (TX_WINDOW_SLOTS == slot)
+    {
+        slotState[fillSlot] = SLOT_FREE;
+        windowStatus.held--;
+        windowStatus.droppedBatches++;
+        due = true;
+        forced = true;
+    }
+    else
+    {
+        fillSlot = slot;
+        if (0u == windowConfig.periodSeconds)
+        {
+            due = true;
+        }
+        else
+        {
+            /* Release before the last free slot is taken */
+            for (slot = 0u; (slot < TX_WINDOW_SLOTS) &&
+                ((SLOT_FREE != slotState[slot]) || (slot == fillSlot)); slot++)
+            {
+            }
+            if (TX_WINDOW_SLOTS == slot)
+            {
+                due = true;
+                forced = true;
+            }
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+    return due;
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_Tick
+********************************************************************************
+*
+* Must be called on every RTC alarm. Returns true when a window is due:
+* the period has elapsed or the oldest held batch reached the latency bound.
+*
+*******************************************************************************/
+bool TxWindow_Tick(void)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    seconds++;
+    if (0u != windowStatus.held)
+    {
+        if ((0u == windowConfig.periodSeconds) || (0u == (seconds % windowConfig.periodSeconds)))
+        {
+            due = true;
+        }
+        else if ((seconds - slotSecond[slotOrder[0]]) >= windowConfig.maxLatencySeconds)
+        {
+            due = true;
+            forced = true;
+        }
+        else
+        {
+            /* Keep holding */
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+    return due;
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_Release
+********************************************************************************
+*
+* Opens a window when one is due and the TxDma is idle. Fills slots with the
+* held slots, oldest first, marks them as being sent and returns their
+* number. Returns 0 when no window opens.
+*
+*******************************************************************************/
+uint32_t TxWindow_Release(uint32_t slots[TX_WINDOW_SLOTS])
+{
+    uint32_t count = 0u;
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    if (due && !sending && (0u != windowStatus.held))
+    {
+        for (count = 0u; count < windowStatus.held; count++)
+        {
+            slots[count] = slotOrder[count];
+            slotState[slotOrder[count]] = SLOT_SENDING;
+        }
+        windowStatus.windows++;
+        windowStatus.forcedWindows += forced ? 1u : 0u;
+        windowStatus.batchesSent += count;
+        windowStatus.held = 0u;
+        due = false;
+        forced = false;
+        sending = true;
+    }
+    Cy_SysLib_ExitCriticalSection(intrState);
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_Claim
+********************************************************************************
+*
+* Marks the TxDma as busy with a chain that is not a window (strings). Returns
+* false when the TxDma is already sending. TxWindow_TxDone() ends the claim.
+*
+*******************************************************************************/
+bool TxWindow_Claim(void)
+{
+    bool claimed;
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    claimed = !sending;
+    sending = true;
+    Cy_SysLib_ExitCriticalSection(intrState);
+    return claimed;
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_TxDone
+********************************************************************************
+*
+* Frees the slots of the window that was sent, or abandoned by a recovery.
+* Returns true when another window is already due.
+*
+*******************************************************************************/
+bool TxWindow_TxDone(void)
+{
+    uint32_t slot;
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+
+    for (slot = 0u; slot < TX_WINDOW_SLOTS; slot++)
+    {
+        if (SLOT_SENDING == slotState[slot])
+        {
+            slotState[slot] = SLOT_FREE;
+        }
+    }
+    sending = false;
+    Cy_SysLib_ExitCriticalSection(intrState);
+    return due && (0u != windowStatus.held);
+}
+
+/*******************************************************************************
+* Function Name: TxWindow_GetStatus
+********************************************************************************
+*
+* Copies the window counters.
+*
+*******************************************************************************/
+void TxWindow_GetStatus(tx_window_status_t *status)
+{
+    uint32_t intrState = Cy_SysLib_EnterCriticalSection();
+    *status = windowStatus;
+    Cy_SysLib_ExitCriticalSection(intrState);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name: TxWindow.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for the TX windows. The MemoryDma fills
+*  one of several batch slots of the memory array. Completed batches are held
+*  and echoed together in a window that opens on the RTC alarm every
+*  periodSeconds, so that the TxDma, its interrupt and the prompt run once per
+*  window instead of once per batch. A batch is never held longer than
+*  maxLatencySeconds, and the held batches are released as soon as no free
+*  slot is left. A period of zero echoes every batch when it completes.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef TXWINDOW_H
+#define TXWINDOW_H
+
+#include "project.h"
+
+/* Batch slots of the memory array */
+#define TX_WINDOW_SLOTS         (4u)
+
+/* Window settings */
+typedef struct
+{
+    uint32_t periodSeconds;     /* RTC alarms between windows, 0 for no hold */
+    uint32_t maxLatencySeconds; /* Longest hold of a batch */
+} tx_window_config_t;
+
+/* Window counters */
+typedef struct
+{
+    uint32_t windows;           /* Windows opened */
+    uint32_t forcedWindows;     /* Opened by the latency bound or a full hold */
+    uint32_t batchesSent;       /* Batches released in windows */
+    uint32_t droppedBatches;    /* Batches lost because no slot was free */
+    uint32_t held;              /* Batches held now */
+} tx_window_status_t;
+
+void TxWindow_Init(const tx_window_config_t *config);
+void TxWindow_Configure(const tx_window_config_t *config);
+uint32_t TxWindow_GetFillSlot(void);
+bool TxWindow_BatchDone(void);
+bool TxWindow_Tick(void);
+uint32_t TxWindow_Release(uint32_t slots[TX_WINDOW_SLOTS]);
+bool TxWindow_Claim(void);
+bool TxWindow_TxDone(void);
+void TxWindow_GetStatus(tx_window_status_t *status);
+
+#endif /* TXWINDOW_H */
+
+/* [] END OF FILE */
@@ -8,7 +8,19 @@
 *  sources. Uses more than one descriptor and DMA to transfer data from the UART
 *  RX buffer and the Real Time Clock to a memory array. Creating a timestamp
 *  of the incoming data. After 4 packets are timestamped, echoes them back to
-*  the UART.
+*  the UART. Every record also carries a sub-second timestamp header captured
+*  from a TCPWM counter that is disciplined by the RTC (see Timebase.c). It
+*  is echoed in microseconds with the drift of the counter clock.
+*  Packets have a variable length and end with a delimiter or an inter-byte
+*  gap (see PacketFramer.c). DMA and UART errors are counted and recovered
+*  by resetting the affected channel (see PipelineStats.c). Packet, date
+*  string and batch sizes can be changed at run time with ConfigureLayout()
+*  (see DmaLayout.c). Every batch is also appended to a log in flash
+*  that survives a reset (see FlashLog.c). The banner and the prompts are
+*  sent by the TxDma from flash (see StringEmitter.c). Batches can be held
+*  and echoed together in TX windows aligned to the RTC alarm, and the
+*  wakeups and the sleep residency are counted and reported every ten
+*  seconds (see TxWindow.c).
 *******************************************************************************
 * Related Document: CE219940.pdf
 *
@@ -45,7 +57,16 @@
 
 #include "project.h"
 #include "stdio.h"      //snprintf
-#include "string.h"     //strncpy
+#include "stddef.h"     //offsetof
+#include "string.h"     //strncpy, memcpy
+#include "Timebase.h"
+#include "PacketFramer.h"
+#include "PipelineStats.h"
+#include "DmaLayout.h"
+#include "FlashLog.h"
+#include "FlashLogPort.h"
+#include "StringEmitter.h"
+#include "TxWindow.h"
 
 /* Defines for starting date */
 #define START_SEC               (0u)    /* Value must be in range 0-59 */
@@ -58,21 +79,111 @@
 /* Defines for RTC Buffer Size */
 #define RTC_BUFFER_SIZE         (20u)
 
-/* Defines for Buffer Size */
-#define PACKET_SIZE             (5u)
-#define CON_BUFFER_SIZE         (PACKET_SIZE + RTC_BUFFER_SIZE)
-#define MAX_LOG                 (4u)   /* Number of memory buffers in the array */
+/* Header at the start of every record */
+typedef struct
+{
+    uint32_t length;            /* Number of valid packet bytes */
+    timebase_stamp_t stamp;     /* Sub-second timestamp of the packet */
+} record_header_t;
+
+/* Defines for Buffer Size, these are the largest values of the layout */
+#define HEADER_SIZE             (sizeof(record_header_t))
+#define CON_BUFFER_SIZE         (HEADER_SIZE + RTC_BUFFER_SIZE + PACKET_MAX_SIZE)
+#define MAX_LOG                 (4u)   /* Number of full-size records in the array */
+#define MAX_LOG_LIMIT           (16u)  /* Number of TxDma record descriptors */
+#define MEMORY_ARRAY_SIZE       (MAX_LOG * CON_BUFFER_SIZE) /* One batch slot */
+
+/* Layout applied at start-up */
+#define DEFAULT_PACKET_SIZE     (16u)
+#define DEFAULT_TEXT_SIZE       (RTC_BUFFER_SIZE)
+#define DEFAULT_BATCH_SIZE      (MAX_LOG)
+
+/* TX windows applied at start-up, a period of 0 echoes every batch at once */
+#define DEFAULT_TX_PERIOD       (0u)    /* RTC alarms (seconds) between windows */
+#define DEFAULT_TX_MAX_LATENCY  (5u)    /* Longest hold of a batch in seconds */
+
+/* Sleep and TX window report */
+#define REPORT_PERIOD           (10u)   /* RTC alarms (seconds) between reports */
+#define REPORT_BUFFER_SIZE      (STRING_EMITTER_MAX_LENGTH)
+
+/* Record layout: [length][packetTick][alarmTick][RTC string][packet]
+* Only the RTC string and the valid packet bytes are echoed back to the UART,
+* followed by the stamp text written from the header by MemoryDma_Complete.
+* The size of the RTC string and of the packet is set by the current layout.
+*/
+#define PACKET_TICK_OFFSET      (offsetof(record_header_t, stamp.packetTick))
+#define ALARM_TICK_OFFSET       (offsetof(record_header_t, stamp.alarmTick))
+
+/* Stamp text echoed after every record: " (+999999 us, drift -50000 ppm)" */
+#define STAMP_TEXT_SIZE         (40u)
+
+/* Date string and the timebase count latched at the same RTC alarm */
+typedef struct
+{
+    uint32_t alarmTick;
+    char text[RTC_BUFFER_SIZE];
+} rtc_stamp_t;
 
 /* Buffers for DMA Operation */
-uint8 ConcatenatedDataBuffer[CON_BUFFER_SIZE];
-char RTCBuffer[RTC_BUFFER_SIZE];
-uint8_t MemoryArray[MAX_LOG][CON_BUFFER_SIZE];
+CY_ALIGN(4) uint8 ConcatenatedDataBuffer[CON_BUFFER_SIZE];
+rtc_stamp_t RTCBuffer;
+uint8_t MemoryArray[TX_WINDOW_SLOTS * MEMORY_ARRAY_SIZE];
+
+/* Descriptor parameters of the current layout */
+dma_layout_t PipelineLayout;
+
+/* Current TX window settings */
+tx_window_config_t TxWindowConfig;
+
+/* Persistent log of the batches */
+flash_log_t BatchLog;
+
+/* Head of the RxDma chain: captures the timebase count of each packet */
+cy_stc_dma_descriptor_t RxDma_TickDescriptor;
+
+/* TxDma chains, one descriptor per record of every batch slot sized to the
+* record length. The slots of a window are chained when it opens.
+*/
+cy_stc_dma_descriptor_t TxDma_RecordDescriptor[TX_WINDOW_SLOTS][MAX_LOG_LIMIT];
+
+/* Stamp text of every record and the descriptors chained after the records */
+char StampText[TX_WINDOW_SLOTS][MAX_LOG_LIMIT][STAMP_TEXT_SIZE];
+cy_stc_dma_descriptor_t TxDma_StampDescriptor[TX_WINDOW_SLOTS][MAX_LOG_LIMIT];
+
+/* Strings sent by the TxDma */
+static const char * const BannerStrings[] =
+{
+    //ANSI VT100 - Erases the screen with the background color and moves the cursor to home.
+    //Comment out next line if not using VT100 terminals.
+    "\x1b[2J\x1b[;H", /* <esc>[2J<esc>[;H */
+    "\r\n****************************************************************\r\n",
+    "This is CE219940_Multiple_DMA_Concatenation code example project\r\n",
+    "Transmit a packet of up to 16 characters to add a RTC timestamp.\r\n",
+    "A packet ends with Enter or after a pause of half a second.\r\n",
+    "After 4 packets the data will be echoed back.\r\n",
+    "Enter the 1st four packets: "
+};
+#define BANNER_LINES            (sizeof(BannerStrings) / sizeof(BannerStrings[0]))
+static const char PromptString[] = "\r\nEnter the next four packets: ";
+
+/* Banner chain and the prompt chained after the last record of a batch */
+cy_stc_dma_descriptor_t TxDma_BannerDescriptor[BANNER_LINES];
+cy_stc_dma_descriptor_t TxDma_PromptDescriptor;
+
+/* Report text, rebuilt by the main loop before every report */
+char ReportString[REPORT_BUFFER_SIZE];
+cy_stc_dma_descriptor_t TxDma_ReportDescriptor;
+
+/* Set by the RTC alarm ISR every REPORT_PERIOD seconds */
+volatile bool ReportDue;
 
 /* Local function declarations */
 void ConfigureRTC(void);
 void ConfigureRxDma(void);
 void ConfigureMemoryDma(void);
 void ConfigureTxDma(void);
+dma_layout_status_t ConfigureLayout(uint32_t packetSize, uint32_t textSize, uint32_t batchSize);
+void ConfigureTxWindow(uint32_t periodSeconds, uint32_t maxLatencySeconds);
 
 /* ISR declarations */
 void RxDma_Complete(void);
@@ -80,6 +191,17 @@ void MemoryDma_Complete(void);
 void TxDma_Complete(void);
 void UartErrors(void);
 
+/* Recovery paths of the ISRs */
+static void RecoverRxDma(void);
+static void RecoverMemoryDma(void);
+static void RecoverTxDma(void);
+
+/* Starts the TxDma for the batches of a TX window */
+static void StartTxWindow(void);
+
+/* Sends the sleep and TX window report */
+static bool SendReport(void);
+
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
@@ -88,17 +210,34 @@ void UartErrors(void);
 *  1. Sets up RX and TX DMAs to handle UART RX+TX direction and an extra DMA
 *     to handle data concatenation into the memory array.
 *  2. Sets up the RTC component and its interrupt.
-*  3. UART sends text header into the serial terminal.
+*  3. TxDma sends the text header into the serial terminal.
 *  4. UART waits for the 4 packets to send them back to
 *     the serial terminal with a timestamp.
+*  5. Writes the pages of the batch log to flash when they are full.
+*  6. Counts the wakeups and the time spent in sleep, and reports them every
+*     REPORT_PERIOD seconds.
 *
 *******************************************************************************/
 int main(void)
 {       
+    uint32_t sleepTick;
+
+    /* Starts the free-running counter used for sub-second timestamps */
+    Timebase_Start();
+    /* The sleep counters start with the timebase */
+    PipelineStats_Clear();
+
+    /* Finds the end of the batch log kept in flash */
+    (void) FlashLog_Mount(&BatchLog, FlashLogPort_Get());
+
     /* Configures DMA Rx and Tx channels for operation. */
     ConfigureRxDma();
     ConfigureMemoryDma();
     ConfigureTxDma();
+
+    /* Sets the TX windows and the packet, date string and batch sizes */
+    ConfigureTxWindow(DEFAULT_TX_PERIOD, DEFAULT_TX_MAX_LATENCY);
+    (void) ConfigureLayout(DEFAULT_PACKET_SIZE, DEFAULT_TEXT_SIZE, DEFAULT_BATCH_SIZE);
     
     /* Configures and starts the RTC to interrupt every second */
     /* Sets the start time of the RTC as 12:00 Mar 30. 2017 */
@@ -108,23 +247,26 @@ int main(void)
     Cy_SysInt_Init(&UART_INT_cfg, &UartErrors);
     NVIC_EnableIRQ(UART_INT_cfg.intrSrc);
     UART_Start();
-  
-    //ANSI VT100 - Erases the screen with the background color and moves the cursor to home.
-    //Comment out next line if not using VT100 terminals.
-    UART_PutString("\x1b[2J\x1b[;H");/* <esc>[2J<esc>[;H */
 
-    UART_PutString("\r\n****************************************************************\r\n");
-    UART_PutString("This is CE219940_Multiple_DMA_Concatenation code example project\r\n");
-    UART_PutString("Transmit a 5 characters packet to add a RTC timestamp.\r\n");   
-    UART_PutString("After 4 packets the data will be echoed back.\r\n");   
-    UART_PutString("Enter the 1st four packets: ");
+    /* The TxDma is idle, so the banner is sent. Windows wait until
+    * TxDma_Complete ends the banner chain.
+    */
+    (void) StringEmitter_Start(&TxDma_BannerDescriptor[0]);
     /* Enable global interrupts. */
     __enable_irq();
     
     for(;;)
     {
-        //Do nothing.
+        /* Row writes are done here, not in the MemoryDma ISR */
+        (void) FlashLog_Process(&BatchLog);
+        /* A busy TxDma delays the report until the next wakeup */
+        if (ReportDue && SendReport())
+        {
+            ReportDue = false;
+        }
+        sleepTick = Timebase_GetTicks();
         Cy_SysPm_Sleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+        PipelineStats_CountWakeup(sleepTick);
     }
 }
 
@@ -183,11 +325,16 @@ void ConfigureRTC(void)
 ********************************************************************************
 *
 * The ConfigureRxDma function performs the following actions:
-*  1. Configures the source address of the first descriptor as the date string.
-*  2. Configures the source address of the second descriptor as the UART RX FIFO.
-*  3. Configures both destination addresses to the concatenated buffer with the
+*  1. Builds the tick descriptor that captures the timebase counter and
+*     chains it in front of the customizer descriptors. Its completion
+*     interrupt signals the start of a packet.
+*  2. Configures the source address of the first descriptor as the alarm
+*     tick followed by the date string.
+*  3. Configures the source address of the second descriptor as the UART RX FIFO.
+*  4. Configures all destination addresses to the concatenated buffer with the
 *     respective offset.
-*  4. Starts the DMA Component.
+*  5. Lets the packet framer append the descriptor that closes each packet.
+*  6. Starts the DMA Component.
 *
 *******************************************************************************/
 void ConfigureRxDma(void)
@@ -196,16 +343,51 @@ void ConfigureRxDma(void)
     RxDma_SetDescriptorType(&RxDma_Descriptor_1, CY_DMA_1D_TRANSFER);
     RxDma_SetDescriptorType(&RxDma_Descriptor_2, CY_DMA_1D_TRANSFER);
     
+    /* Tick descriptor: one word from the timebase counter per packet. It is
+    * executed by the first RX trigger of a packet and chains to descriptor 1.
+    */
+    const cy_stc_dma_descriptor_config_t tickConfig =
+    {
+        .retrigger       = CY_DMA_RETRIG_IM,
+        .interruptType   = CY_DMA_DESCR,
+        .triggerOutType  = CY_DMA_DESCR_CHAIN,
+        .channelState    = CY_DMA_CHANNEL_ENABLED,
+        .triggerInType   = CY_DMA_DESCR,
+        .dataSize        = CY_DMA_WORD,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .descriptorType  = CY_DMA_SINGLE_TRANSFER,
+        .srcAddress      = (void *) Timebase_GetCounterAddress(),
+        .dstAddress      = (void *) &ConcatenatedDataBuffer[PACKET_TICK_OFFSET],
+        .srcXincrement   = 0,
+        .dstXincrement   = 0,
+        .xCount          = 1uL,
+        .srcYincrement   = 0,
+        .dstYincrement   = 0,
+        .yCount          = 1uL,
+        .nextDescriptor  = &RxDma_Descriptor_1
+    };
+
     /* Configure DMA channel per parameters from the customizer */
     RxDma_Init();
 
-    /* Set sources and destination for descriptor 1. */
-    RxDma_SetSrcAddress(&RxDma_Descriptor_1, (uint32_t *) RTCBuffer);
-    RxDma_SetDstAddress(&RxDma_Descriptor_1, (uint32_t *) ConcatenatedDataBuffer);    
+    /* Put the tick descriptor at the head of the chain. */
+    (void) Cy_DMA_Descriptor_Init(&RxDma_TickDescriptor, &tickConfig);
+    RxDma_SetDescriptor(&RxDma_TickDescriptor);
+
+    /* Set sources and destination for descriptor 1. The alarm tick is copied
+    * together with the date string.
+    */
+    RxDma_SetSrcAddress(&RxDma_Descriptor_1, (uint32_t *) &RTCBuffer);
+    RxDma_SetDstAddress(&RxDma_Descriptor_1, (uint32_t *) &ConcatenatedDataBuffer[ALARM_TICK_OFFSET]);    
     
     /* Set sources and destination for descriptor 2. */
     RxDma_SetSrcAddress(&RxDma_Descriptor_2, (uint32_t *) &UART_HW->RX_FIFO_RD);
-    RxDma_SetDstAddress(&RxDma_Descriptor_2, (uint32_t *) &ConcatenatedDataBuffer[RTC_BUFFER_SIZE]);
+
+    /* Descriptor 2 takes up to the packet size of the layout, then the close
+    * descriptor writes the length into the record header.
+    */
+    PacketFramer_Init((uint32_t *) ConcatenatedDataBuffer, &ConcatenatedDataBuffer[CON_BUFFER_SIZE - PACKET_MAX_SIZE]);
 
     /* Initialize and enable interrupt from RxDma. */
     Cy_SysInt_Init(&RX_DMA_INT_cfg, &RxDma_Complete);
@@ -261,22 +443,52 @@ void ConfigureMemoryDma(void)
 ********************************************************************************
 *
 * The ConfigureTxDma function performs the following actions:
-*  1. Configures the source address of the descriptor as the memory array.
-*  2. Configures the destination address of the descriptor as the UART TX FIFO.
-*  3. Starts the DMA Component.
+*  1. Builds one 1D descriptor per record from the customizer descriptor,
+*     interrupting at the end of the chain only, and one per stamp text. The
+*     sources and the chain are set by ConfigureLayout, the lengths per batch
+*     by MemoryDma_Complete.
+*  2. Configures the destination address of the descriptors as the UART TX FIFO.
+*  3. Builds the string descriptors of the banner and of the prompt. The
+*     prompt is chained after the stamp of the last record by ConfigureLayout.
+*  4. Starts the DMA Component.
 *
 *******************************************************************************/
 void ConfigureTxDma(void)
 {
-    /* Configure DMA Descriptors as 2D (X and Y loops)*/
-    TxDma_SetDescriptorType(&TxDma_Descriptor_1, CY_DMA_2D_TRANSFER);
+    cy_stc_dma_descriptor_config_t recordConfig = TxDma_Descriptor_1_config;
+    cy_stc_dma_descriptor_config_t stampConfig;
+    uint32_t slot;
+    uint32_t record;
 
     /* Configure DMA channel per parameters from the customizer. */
     TxDma_Init();
-    
-    /* Set sources and destination for descriptor 1. */
-    TxDma_SetSrcAddress(&TxDma_Descriptor_1, (uint32_t *) &(MemoryArray[0][0]));
-    TxDma_SetDstAddress(&TxDma_Descriptor_1, (uint32_t *) &UART_HW->TX_FIFO_WR);
+
+    /* One descriptor per record, each one sends the date and the packet.
+    * Only the end of the chain interrupts: TxDma_Complete disables the channel,
+    * so an interrupt per record would stop the batch after its first record.
+    */
+    recordConfig.interruptType = CY_DMA_DESCR_CHAIN;
+    recordConfig.descriptorType = CY_DMA_1D_TRANSFER;
+    recordConfig.srcAddress = (void *) MemoryArray;
+    recordConfig.dstAddress = (void *) &UART_HW->TX_FIFO_WR;
+    recordConfig.xCount = 1uL;
+    recordConfig.yCount = 1uL;
+    recordConfig.nextDescriptor = NULL;
+    stampConfig = recordConfig;
+    for (slot = 0u; slot < TX_WINDOW_SLOTS; slot++)
+    {
+        for (record = 0u; record < MAX_LOG_LIMIT; record++)
+        {
+            (void) Cy_DMA_Descriptor_Init(&TxDma_RecordDescriptor[slot][record], &recordConfig);
+            stampConfig.srcAddress = (void *) StampText[slot][record];
+            (void) Cy_DMA_Descriptor_Init(&TxDma_StampDescriptor[slot][record], &stampConfig);
+        }
+    }
+    TxDma_SetDescriptor(&TxDma_RecordDescriptor[0][0]);
+
+    /* Strings read from flash by the DMA */
+    (void) StringEmitter_Chain(TxDma_BannerDescriptor, BannerStrings, BANNER_LINES, NULL);
+    (void) StringEmitter_Init(&TxDma_PromptDescriptor, PromptString, NULL);
 
     /* Initialize and enable interrupt from TxDma. */
     Cy_SysInt_Init(&TX_DMA_INT_cfg, &TxDma_Complete);
@@ -290,6 +502,111 @@ void ConfigureTxDma(void)
     Cy_DMA_Enable(TxDma_HW);
     return;
 }
+
+/*******************************************************************************
+* Function Name: ConfigureLayout
+********************************************************************************
+*
+* The ConfigureLayout function performs the following actions:
+*  1. Validates the packet, date string and batch sizes (see DmaLayout.c).
+*     Nothing is changed when they are rejected.
+*  2. Stops the three channels. Partial records and batches are discarded.
+*  3. Reprograms the X/Y counts, increments and addresses of
+*     RxDma_Descriptor_1/2, MemoryDma_Descriptor_1 and the TxDma record and
+*     stamp chains of every batch slot. Held batches are discarded.
+*  4. Restarts the RX and memory channels.
+*
+* Returns DMA_LAYOUT_SUCCESS or the reason of the rejection.
+*
+*******************************************************************************/
+dma_layout_status_t ConfigureLayout(uint32_t packetSize, uint32_t textSize, uint32_t batchSize)
+{
+    const dma_layout_limits_t limits =
+    {
+        .headerSize    = HEADER_SIZE,
+        .stampSize     = sizeof(RTCBuffer.alarmTick),
+        .maxPacketSize = PACKET_MAX_SIZE,
+        .maxTextSize   = RTC_BUFFER_SIZE,
+        .maxBatchSize  = MAX_LOG_LIMIT,
+        .memorySize    = MEMORY_ARRAY_SIZE
+    };
+    const dma_layout_config_t config =
+    {
+        .packetSize = packetSize,
+        .textSize   = textSize,
+        .batchSize  = batchSize
+    };
+    dma_layout_t layout;
+    dma_layout_status_t status;
+    uint32_t slot;
+    uint32_t record;
+    uint32_t offset;
+
+    status = DmaLayout_Compute(&config, &limits, &layout);
+    if (DMA_LAYOUT_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* Stop the pipeline */
+    RxDma_ChannelDisable();
+    MemoryDma_ChannelDisable();
+    TxDma_ChannelDisable();
+    PacketFramer_PacketDone();
+    TxWindow_Init(&TxWindowConfig);
+    PipelineLayout = layout;
+
+    /* RxDma: alarm tick and date string, then the packet right after it */
+    Cy_DMA_Descriptor_SetXloopDataCount(&RxDma_Descriptor_1, layout.rxStampXCount);
+    PacketFramer_Configure(&ConcatenatedDataBuffer[layout.packetOffset], layout.rxPacketXCount);
+    RxDma_SetDescriptor(&RxDma_TickDescriptor);
+
+    /* MemoryDma: one record per X loop, one batch per descriptor */
+    Cy_DMA_Descriptor_SetXloopDataCount(&MemoryDma_Descriptor_1, layout.memXCount);
+    Cy_DMA_Descriptor_SetYloopDataCount(&MemoryDma_Descriptor_1, layout.memYCount);
+    Cy_DMA_Descriptor_SetYloopDstIncrement(&MemoryDma_Descriptor_1, layout.memDstYIncrement);
+    MemoryDma_SetDstAddress(&MemoryDma_Descriptor_1, (uint32_t *) &MemoryArray[0]);
+    MemoryDma_SetDescriptor(&MemoryDma_Descriptor_1);
+
+    /* TxDma: chain the record and stamp descriptors of each slot, then the prompt */
+    for (slot = 0u; slot < TX_WINDOW_SLOTS; slot++)
+    {
+        for (record = 0u; record < layout.txRecordCount; record++)
+        {
+            offset = (slot * MEMORY_ARRAY_SIZE) + DmaLayout_RecordOffset(&layout, record) + layout.textOffset;
+            TxDma_SetSrcAddress(&TxDma_RecordDescriptor[slot][record], (uint32_t *) &MemoryArray[offset]);
+            Cy_DMA_Descriptor_SetXloopDataCount(&TxDma_RecordDescriptor[slot][record], layout.txMaxXCount);
+            Cy_DMA_Descriptor_SetNextDescriptor(&TxDma_RecordDescriptor[slot][record],
+                &TxDma_StampDescriptor[slot][record]);
+            Cy_DMA_Descriptor_SetNextDescriptor(&TxDma_StampDescriptor[slot][record],
+                (record < (layout.txRecordCount - 1u)) ? &TxDma_RecordDescriptor[slot][record + 1u] :
+                &TxDma_PromptDescriptor);
+        }
+    }
+    TxDma_SetDescriptor(&TxDma_RecordDescriptor[0][0]);
+
+    /* Restart the pipeline, the TxDma is enabled by the MemoryDma */
+    MemoryDma_ChannelEnable();
+    RxDma_ChannelEnable();
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: ConfigureTxWindow
+********************************************************************************
+*
+* Sets the number of RTC alarms between TX windows and the longest hold of
+* a batch. A period of 0 echoes every batch as soon as the TxDma is idle.
+* Held batches are kept.
+*
+*******************************************************************************/
+void ConfigureTxWindow(uint32_t periodSeconds, uint32_t maxLatencySeconds)
+{
+    TxWindowConfig.periodSeconds = periodSeconds;
+    TxWindowConfig.maxLatencySeconds = maxLatencySeconds;
+    TxWindow_Configure(&TxWindowConfig);
+}
+
 /* Interrupt Service Routines */
 
 /*******************************************************************************
@@ -297,21 +614,36 @@ void ConfigureTxDma(void)
 ********************************************************************************
 *
 * The Cy_RTC_Alarm1Interrupt ISR performs the following actions:
-*  1. Gets the current date & time.
-*  2. Writes the current date & time as a string into the string buffer.
+*  1. Latches the timebase counter for the new second.
+*  2. Gets the current date & time.
+*  3. Writes the current date & time as a string into the string buffer.
+*  4. Opens a TX window when one is due.
+*  5. Asks the main loop for a report every REPORT_PERIOD seconds.
 *
 *******************************************************************************/
 void Cy_RTC_Alarm1Interrupt(void)
 {
+    static uint32_t reportAlarms = 0u;
     cy_stc_rtc_config_t Date;
     char tempString[RTC_BUFFER_SIZE + 1]; /* Null Termination */
+    RTCBuffer.alarmTick = Timebase_AlarmLatch();
     RTC_GetDateAndTime(&Date);
     snprintf(tempString, RTC_BUFFER_SIZE + 1,
         "\r\n%02d:%02d:%02d %02d/%02d/%02d ", 
         (int)Date.hour,(int)Date.min,(int)Date.sec,
         (int)Date.month,(int)Date.date,(int)Date.year);
     /* Remove Null termination */
-    strncpy(RTCBuffer, tempString, RTC_BUFFER_SIZE);
+    strncpy(RTCBuffer.text, tempString, RTC_BUFFER_SIZE);
+
+    if (TxWindow_Tick())
+    {
+        StartTxWindow();
+    }
+    if (++reportAlarms >= REPORT_PERIOD)
+    {
+        reportAlarms = 0u;
+        ReportDue = true;
+    }
 }
 
 /*******************************************************************************
@@ -319,26 +651,48 @@ void Cy_RTC_Alarm1Interrupt(void)
 ********************************************************************************
 *
 * The RxDma_Complete ISR performs the following actions:
-*  1. Clears the Interrupt and resets the DMA to the first descriptor.
-*  2. If there was an error stays in the DMA ISR forever.
+*  1. Clears the Interrupt.
+*  2. After the tick descriptor, starts the gap timer of the packet framer.
+*  3. After the close descriptor, resets the DMA to the first descriptor.
+*  4. If there was an error counts the cause and resets the channel.
 *
 *******************************************************************************/
 void RxDma_Complete(void)
 {
+    uint32_t startTick = Timebase_GetTicks();
+    uint32_t cause = RxDma_GetInterruptStatus();
+
     /* Check interrupt cause to capture errors. */
-    if (CY_DMA_INTR_CAUSE_COMPLETION != RxDma_GetInterruptStatus())
+    if (CY_DMA_INTR_CAUSE_COMPLETION != cause)
     {
-        /* The DMA error must not occur while RX operations.
-        * Go into infinite loop to identify that something is wrong with DMA.
+        PipelineStats_CountDmaError(PIPELINE_RX_DMA, cause);
+        /* A null pointer only means that the next packet arrived before the
+        * chain was reset; its bytes are still in the RX FIFO.
         */
-        for(;;)
+        if (CY_DMA_INTR_CAUSE_CURR_PTR_NULL != cause)
         {
+            PipelineStats_CountDroppedPacket();
         }
+        RecoverRxDma();
+        PipelineStats_CountRecovery(PIPELINE_RX_DMA, startTick);
+        return;
     }
     /* Clear interrupt after receiving cause */    
     RxDma_ClearInterrupt();
-    /* Reset DMA Descriptor chain */
-    RxDma_SetDescriptor(&RxDma_Descriptor_1);
+
+    if (NULL != Cy_DMA_Channel_GetCurrentDescriptor(RxDma_HW, RxDma_DW_CHANNEL))
+    {
+        /* Tick captured, a new packet is being received */
+        PacketFramer_PacketStarted();
+    }
+    else
+    {
+        /* Packet closed and handed to the MemoryDma */
+        PacketFramer_PacketDone();
+        PipelineStats_CountPacket();
+        /* Reset DMA Descriptor chain, carried bytes start the next packet */
+        PacketFramer_Rearm(&RxDma_TickDescriptor);
+    }
 }
 
 /*******************************************************************************
@@ -347,57 +701,112 @@ void RxDma_Complete(void)
 *
 * The MemoryDma_Complete ISR performs the following actions:
 *  1. Clears the Interrupt.
-*  2. If there was an error stays in the DMA ISR forever.
-*  3. Resets the TxDma Descriptor and enables it to start sending the memory array.
+*  2. If there was an error counts the cause and restarts the batch.
+*  3. Appends the batch to the batch log. The page is written by main.
+*  4. Sets the length of every TxDma record descriptor of the slot from the
+*     record header, and writes the stamp text: the time of the packet after
+*     the RTC alarm in microseconds and the drift of the timebase.
+*  5. Holds the batch and moves the MemoryDma to the next free slot.
+*  6. Starts the TxDma when the TX window is due.
 *
 *******************************************************************************/
 void MemoryDma_Complete(void)
 {
+    record_header_t header;
+    timebase_status_t timebase;
+    uint32_t stampLength;
+    uint32_t record;
+    uint32_t slot = TxWindow_GetFillSlot();
+    uint8_t *batch = &MemoryArray[slot * MEMORY_ARRAY_SIZE];
+    uint32_t startTick = Timebase_GetTicks();
+    uint32_t cause = MemoryDma_GetInterruptStatus();
+
     /* Check interrupt cause to capture errors. */
-    if (CY_DMA_INTR_CAUSE_COMPLETION != MemoryDma_GetInterruptStatus())
+    if (CY_DMA_INTR_CAUSE_COMPLETION != cause)
     {
-        /* Go into infinite loop to identify that something is wrong with the DMA. */
-        for(;;)
-        {
-        }
+        PipelineStats_CountDmaError(PIPELINE_MEMORY_DMA, cause);
+        PipelineStats_CountDroppedBatch();
+        RecoverMemoryDma();
+        PipelineStats_CountRecovery(PIPELINE_MEMORY_DMA, startTick);
+        return;
     }
     /* Clear interrupt after receiving cause */
     MemoryDma_ClearInterrupt();
-    /* Reset DMA Descriptor chain and enable the DMA. */
-    TxDma_SetDescriptor(&TxDma_Descriptor_1);
-    TxDma_ChannelEnable();
+    PipelineStats_CountBatch();
+    (void) FlashLog_Append(&BatchLog, batch, PipelineLayout.batchBytes);
+    Timebase_GetStatus(&timebase);
+    /* Send only the valid bytes of each record, then its stamp */
+    for (record = 0u; record < PipelineLayout.txRecordCount; record++)
+    {
+        (void) memcpy(&header, &batch[DmaLayout_RecordOffset(&PipelineLayout, record)], HEADER_SIZE);
+        if (header.length > PipelineLayout.rxPacketXCount)
+        {
+            header.length = PipelineLayout.rxPacketXCount;
+        }
+        Cy_DMA_Descriptor_SetXloopDataCount(&TxDma_RecordDescriptor[slot][record],
+            PipelineLayout.txTextXCount + header.length);
+        stampLength = (uint32_t) snprintf(StampText[slot][record], STAMP_TEXT_SIZE, " (+%lu us, drift %ld ppm)",
+            (unsigned long) Timebase_StampToMicroseconds(&header.stamp), (long) timebase.driftPpm);
+        if (stampLength >= STAMP_TEXT_SIZE)
+        {
+            stampLength = STAMP_TEXT_SIZE - 1u;
+        }
+        Cy_DMA_Descriptor_SetXloopDataCount(&TxDma_StampDescriptor[slot][record], stampLength);
+    }
+    /* The next batch goes to the next free slot */
+    if (TxWindow_BatchDone())
+    {
+        StartTxWindow();
+    }
+    if (slot != TxWindow_GetFillSlot())
+    {
+        MemoryDma_SetDstAddress(&MemoryDma_Descriptor_1,
+            (uint32_t *) &MemoryArray[TxWindow_GetFillSlot() * MEMORY_ARRAY_SIZE]);
+    }
+    else
+    {
+        PipelineStats_CountDroppedBatch();
+    }
 }
 
 /*******************************************************************************
 * Function Name: TxDma_Complete
 ********************************************************************************
 *
-* The TxDma_Complete ISR performs the following actions:
-*  1. Outputs a string to the UART for better Terminal visualization.
+* The TxDma_Complete ISR runs at the end of the chain, after the prompt or
+* the banner, and performs the following actions:
+*  1. Disables the channel and frees the slots of the TX window.
+*  2. Starts the next TX window if one is already due.
+*  3. If there was an error counts the cause and resets the channel. The
+*     rest of the batch is not echoed.
 *
 *******************************************************************************/
 void TxDma_Complete(void)
 {    
+    uint32_t startTick = Timebase_GetTicks();
+    uint32_t cause = TxDma_GetInterruptStatus();
+
     /* Check interrupt cause to capture errors. */
     /* Having a null pointer on the descriptor is not an error on this DMA */
-    switch(TxDma_GetInterruptStatus())
+    switch(cause)
     {
     case CY_DMA_INTR_CAUSE_COMPLETION:
-        UART_PutString("\r\nEnter the next four packets: ");
-        //while(UART_GetNumInTxFifo() != 0) {}
-        break;
     case CY_DMA_INTR_CAUSE_CURR_PTR_NULL:
         break;
     default:
-        /* Go into infinite loop to identify that something is wrong with the DMA. */
-        for(;;)
-        {
-        }
+        PipelineStats_CountDmaError(PIPELINE_TX_DMA, cause);
+        RecoverTxDma();
+        PipelineStats_CountRecovery(PIPELINE_TX_DMA, startTick);
+        return;
     }
-    /* Disable DMA channel until the MemoryDMA enables it again */
+    /* Disable DMA channel until the next TX window enables it again */
     TxDma_ChannelDisable();
     /* Clear interrupt after receiving cause */
     TxDma_ClearInterrupt();
+    if (TxWindow_TxDone())
+    {
+        StartTxWindow();
+    }
 }
 
 /*******************************************************************************
@@ -406,7 +815,8 @@ void TxDma_Complete(void)
 *
 * The UartErrors ISR performs the following actions:
 *  1. Gets the error cause (TX or RX FIFO Overflow).
-*  2. Stays in the ISR forever.
+*  2. Counts the error causes. The DMA channels keep running; a packet that
+*     lost bytes is closed by the packet framer as usual.
 *
 *******************************************************************************/
 void UartErrors(void)
@@ -422,12 +832,126 @@ void UartErrors(void)
     intrSrcTx = UART_GetTxFifoStatus();
     UART_ClearTxFifoStatus(intrSrcTx);
 
-    /* The TX/RX overflow must not occur while operation.
-    * Go into infinite loop to identify that something went wrong.
-    */
-    for(;;)
+    PipelineStats_CountUartErrors(intrSrcRx, intrSrcTx);
+}
+
+/*******************************************************************************
+* Function Name: RecoverRxDma
+********************************************************************************
+*
+* The RecoverRxDma function performs the following actions:
+*  1. Stops the channel and the gap timer, discarding the partial record
+*     and the bytes carried into it.
+*  2. Clears the interrupt and resets the DMA to the first descriptor.
+*  3. Enables the channel. Bytes waiting in the RX FIFO start a new packet.
+*
+*******************************************************************************/
+static void RecoverRxDma(void)
+{
+    RxDma_ChannelDisable();
+    PacketFramer_PacketDone();
+    PacketFramer_Configure(&ConcatenatedDataBuffer[PipelineLayout.packetOffset], PipelineLayout.rxPacketXCount);
+    RxDma_ClearInterrupt();
+    RxDma_SetDescriptor(&RxDma_TickDescriptor);
+    RxDma_ChannelEnable();
+}
+
+/*******************************************************************************
+* Function Name: RecoverMemoryDma
+********************************************************************************
+*
+* The RecoverMemoryDma function performs the following actions:
+*  1. Stops the channel.
+*  2. Clears the interrupt and resets the descriptor, which restarts the batch
+*     at the first record of the memory array.
+*  3. Enables the channel for the next record.
+*
+*******************************************************************************/
+static void RecoverMemoryDma(void)
+{
+    MemoryDma_ChannelDisable();
+    MemoryDma_ClearInterrupt();
+    MemoryDma_SetDescriptor(&MemoryDma_Descriptor_1);
+    MemoryDma_ChannelEnable();
+}
+
+/*******************************************************************************
+* Function Name: RecoverTxDma
+********************************************************************************
+*
+* The RecoverTxDma function performs the following actions:
+*  1. Stops the channel until the next TX window enables it.
+*  2. Clears the interrupt and resets the DMA to the first record descriptor.
+*  3. Frees the slots of the window. The rest of it is not echoed.
+*
+*******************************************************************************/
+static void RecoverTxDma(void)
+{
+    TxDma_ChannelDisable();
+    TxDma_ClearInterrupt();
+    TxDma_SetDescriptor(&TxDma_RecordDescriptor[0][0]);
+    (void) TxWindow_TxDone();
+}
+
+/*******************************************************************************
+* Function Name: StartTxWindow
+********************************************************************************
+*
+* The StartTxWindow function performs the following actions:
+*  1. Takes the held batch slots when a window is due and the TxDma is idle.
+*  2. Chains the stamp of the last record of every slot to the first record
+*     of the next one, and the last slot to the prompt.
+*  3. Starts the TxDma at the first record of the oldest slot.
+*
+*******************************************************************************/
+static void StartTxWindow(void)
+{
+    uint32_t slots[TX_WINDOW_SLOTS];
+    uint32_t count = TxWindow_Release(slots);
+    uint32_t last = PipelineLayout.txRecordCount - 1u;
+    uint32_t index;
+
+    if (0u == count)
+    {
+        return;
+    }
+    for (index = 0u; index < count; index++)
     {
+        Cy_DMA_Descriptor_SetNextDescriptor(&TxDma_StampDescriptor[slots[index]][last],
+            (index < (count - 1u)) ? &TxDma_RecordDescriptor[slots[index + 1u]][0] : &TxDma_PromptDescriptor);
     }
+    TxDma_SetDescriptor(&TxDma_RecordDescriptor[slots[0]][0]);
+    TxDma_ChannelEnable();
+}
+
+/*******************************************************************************
+* Function Name: SendReport
+********************************************************************************
+*
+* The SendReport function performs the following actions:
+*  1. Writes the wakeups per second, the sleep residency and the TX window
+*     counters into the report string.
+*  2. Sends it with the TxDma. Returns false when the TxDma is busy with a
+*     window, the main loop tries again at its next wakeup.
+*
+*******************************************************************************/
+static bool SendReport(void)
+{
+    pipeline_sleep_report_t sleep;
+    tx_window_status_t window;
+
+    PipelineStats_GetSleepReport(&sleep);
+    TxWindow_GetStatus(&window);
+    (void) snprintf(ReportString, REPORT_BUFFER_SIZE,
+        "\r\n[%lu.%02lu wakeups/s, %lu.%lu%% asleep, %lu windows (%lu forced), "
+        "%lu batches sent, %lu dropped, %lu held]",
+        (unsigned long)(sleep.wakeupsPerSecondX100 / 100u), (unsigned long)(sleep.wakeupsPerSecondX100 % 100u),
+        (unsigned long)(sleep.sleepResidencyPermille / 10u), (unsigned long)(sleep.sleepResidencyPermille % 10u),
+        (unsigned long)window.windows, (unsigned long)window.forcedWindows,
+        (unsigned long)window.batchesSent, (unsigned long)window.droppedBatches,
+        (unsigned long)window.held);
+    (void) StringEmitter_Init(&TxDma_ReportDescriptor, ReportString, NULL);
+    return StringEmitter_Start(&TxDma_ReportDescriptor);
 }
 
 /* [] END OF FILE */
@@ -0,0 +1,374 @@
+/*******************************************************************************
+* File Name: DmaHost.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the host stand-in of the PDL DMA (DataWire) driver, see
+*  DmaHost.h. Descriptors run element by element, in order; channel priority
+*  and preemption are not modelled.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include <string.h>
+#include "DmaHost.h"
+
+/* Largest X and Y count of a descriptor */
+#define DMA_HOST_MAX_COUNT          (256u)
+
+/* Trigger outputs waiting for delivery */
+#define DMA_HOST_PENDING            (64u)
+
+DW_Type DmaHost_Dw[DMA_HOST_BLOCKS];
+
+static DW_Type *PendingHw[DMA_HOST_PENDING];
+static uint32_t PendingChannel[DMA_HOST_PENDING];
+static uint32_t PendingCount;
+static bool Delivering;
+
+static uint32_t DmaHost_ElementSize(cy_en_dma_data_size_t dataSize);
+static void DmaHost_Move(const cy_stc_dma_descriptor_t *descriptor, uint32_t x, uint32_t y);
+static void DmaHost_Run(dma_host_channel_t *channel);
+
+/*******************************************************************************
+* Function Name: DmaHost_Reset
+********************************************************************************
+*
+* Disables every block and channel and removes the trigger connections.
+*
+*******************************************************************************/
+void DmaHost_Reset(void)
+{
+    (void) memset(DmaHost_Dw, 0, sizeof(DmaHost_Dw));
+    PendingCount = 0u;
+    Delivering = false;
+}
+
+/*******************************************************************************
+* Function Name: DmaHost_Connect
+********************************************************************************
+*
+* Connects the trigger output of a channel to the trigger input of another
+* one, like a trigger mux route in the schematic.
+*
+*******************************************************************************/
+void DmaHost_Connect(DW_Type *srcHw, uint32_t srcChannel, DW_Type *dstHw, uint32_t dstChannel)
+{
+    srcHw->channel[srcChannel].triggerOutHw = dstHw;
+    srcHw->channel[srcChannel].triggerOutChannel = dstChannel;
+}
+
+/*******************************************************************************
+* Function Name: DmaHost_Trigger
+********************************************************************************
+*
+* Delivers a trigger to the channel. A disabled channel or block ignores it,
+* a channel without a current descriptor reports CY_DMA_INTR_CAUSE_CURR_PTR_NULL.
+* Trigger outputs raised meanwhile are delivered before returning.
+*
+*******************************************************************************/
+void DmaHost_Trigger(DW_Type *base, uint32_t channel)
+{
+    dma_host_channel_t *state = &base->channel[channel];
+    uint32_t index;
+
+    state->triggers++;
+    if (base->enabled && state->enabled)
+    {
+        if (NULL == state->current)
+        {
+            state->cause = CY_DMA_INTR_CAUSE_CURR_PTR_NULL;
+        }
+        else
+        {
+            DmaHost_Run(state);
+        }
+    }
+
+    if (!Delivering)
+    {
+        Delivering = true;
+        for (index = 0u; index < PendingCount; index++)
+        {
+            DmaHost_Trigger(PendingHw[index], PendingChannel[index]);
+        }
+        PendingCount = 0u;
+        Delivering = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: DmaHost_GetTriggers
+********************************************************************************
+*
+* Returns the number of triggers the channel received since the reset.
+*
+*******************************************************************************/
+uint32_t DmaHost_GetTriggers(DW_Type const *base, uint32_t channel)
+{
+    return base->channel[channel].triggers;
+}
+
+/*******************************************************************************
+* Function Name: DmaHost_Run
+********************************************************************************
+*
+* Runs the elements of one trigger. Every element completes the element, the
+* X loop, the descriptor or the chain; the interrupt, the trigger output and
+* the end of the trigger happen when their type is reached.
+*
+*******************************************************************************/
+static void DmaHost_Run(dma_host_channel_t *channel)
+{
+    const cy_stc_dma_descriptor_t *descriptor;
+    cy_en_dma_trigger_type_t reached;
+    uint32_t xCount;
+    uint32_t yCount;
+    bool done = false;
+
+    while (!done)
+    {
+        descriptor = channel->current;
+        xCount = (CY_DMA_SINGLE_TRANSFER == descriptor->descriptorType) ? 1u : descriptor->xCount;
+        yCount = (CY_DMA_2D_TRANSFER == descriptor->descriptorType) ? descriptor->yCount : 1u;
+
+        DmaHost_Move(descriptor, channel->xIndex, channel->yIndex);
+        reached = CY_DMA_1ELEMENT;
+        if (++channel->xIndex == xCount)
+        {
+            channel->xIndex = 0u;
+            reached = CY_DMA_X_LOOP;
+            if (++channel->yIndex == yCount)
+            {
+                channel->yIndex = 0u;
+                reached = (NULL == descriptor->nextDescriptor) ? CY_DMA_DESCR_CHAIN : CY_DMA_DESCR;
+                channel->current = descriptor->nextDescriptor;
+                if (CY_DMA_CHANNEL_DISABLED == descriptor->channelState)
+                {
+                    channel->enabled = false;
+                }
+            }
+        }
+
+        if (reached >= descriptor->interruptType)
+        {
+            channel->cause = CY_DMA_INTR_CAUSE_COMPLETION;
+        }
+        if ((reached >= descriptor->triggerOutType) && (NULL != channel->triggerOutHw) &&
+            (PendingCount < DMA_HOST_PENDING))
+        {
+            PendingHw[PendingCount] = (DW_Type *) channel->triggerOutHw;
+            PendingChannel[PendingCount] = channel->triggerOutChannel;
+            PendingCount++;
+        }
+        done = (reached >= descriptor->triggerInType) || !channel->enabled || (NULL == channel->current);
+    }
+}
+
+/*******************************************************************************
+* Function Name: DmaHost_Move
+********************************************************************************
+*
+* Moves one element. The addresses advance by the X and Y increments in
+* elements. A word transfer size accesses 32 bits and the value is cut to
+* the element size.
+*
+*******************************************************************************/
+static void DmaHost_Move(const cy_stc_dma_descriptor_t *descriptor, uint32_t x, uint32_t y)
+{
+    uint32_t size = DmaHost_ElementSize(descriptor->dataSize);
+    const uint8_t *src = (const uint8_t *) descriptor->srcAddress +
+        (((int32_t) x * descriptor->srcXincrement) + ((int32_t) y * descriptor->srcYincrement)) * (int32_t) size;
+    uint8_t *dst = (uint8_t *) descriptor->dstAddress +
+        (((int32_t) x * descriptor->dstXincrement) + ((int32_t) y * descriptor->dstYincrement)) * (int32_t) size;
+    uint32_t value = 0u;
+
+    if (CY_DMA_TRANSFER_SIZE_WORD == descriptor->srcTransferSize)
+    {
+        (void) memcpy(&value, src, sizeof(value));
+    }
+    else
+    {
+        (void) memcpy(&value, src, size);
+    }
+    if (size < sizeof(value))
+    {
+        value &= (1uL << (8u * size)) - 1u;
+    }
+    (void) memcpy(dst, &value, (CY_DMA_TRANSFER_SIZE_WORD == descriptor->dstTransferSize) ? sizeof(value) : size);
+}
+
+static uint32_t DmaHost_ElementSize(cy_en_dma_data_size_t dataSize)
+{
+    return (CY_DMA_WORD == dataSize) ? 4u : ((CY_DMA_HALFWORD == dataSize) ? 2u : 1u);
+}
+
+/* PDL functions */
+
+cy_en_dma_status_t Cy_DMA_Descriptor_Init(cy_stc_dma_descriptor_t *descriptor,
+    const cy_stc_dma_descriptor_config_t *config)
+{
+    if ((NULL == descriptor) || (NULL == config) ||
+        (0u == config->xCount) || (config->xCount > DMA_HOST_MAX_COUNT) ||
+        (0u == config->yCount) || (config->yCount > DMA_HOST_MAX_COUNT))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+    descriptor->retrigger       = config->retrigger;
+    descriptor->interruptType   = config->interruptType;
+    descriptor->triggerOutType  = config->triggerOutType;
+    descriptor->channelState    = config->channelState;
+    descriptor->triggerInType   = config->triggerInType;
+    descriptor->dataSize        = config->dataSize;
+    descriptor->srcTransferSize = config->srcTransferSize;
+    descriptor->dstTransferSize = config->dstTransferSize;
+    descriptor->descriptorType  = config->descriptorType;
+    descriptor->srcAddress      = config->srcAddress;
+    descriptor->dstAddress      = config->dstAddress;
+    descriptor->srcXincrement   = config->srcXincrement;
+    descriptor->dstXincrement   = config->dstXincrement;
+    descriptor->xCount          = config->xCount;
+    descriptor->srcYincrement   = config->srcYincrement;
+    descriptor->dstYincrement   = config->dstYincrement;
+    descriptor->yCount          = config->yCount;
+    descriptor->nextDescriptor  = config->nextDescriptor;
+    return CY_DMA_SUCCESS;
+}
+
+void Cy_DMA_Descriptor_SetNextDescriptor(cy_stc_dma_descriptor_t *descriptor,
+    const cy_stc_dma_descriptor_t *nextDescriptor)
+{
+    descriptor->nextDescriptor = (cy_stc_dma_descriptor_t *) nextDescriptor;
+}
+
+void Cy_DMA_Descriptor_SetSrcAddress(cy_stc_dma_descriptor_t *descriptor, const void *srcAddress)
+{
+    descriptor->srcAddress = (void *) srcAddress;
+}
+
+void Cy_DMA_Descriptor_SetDstAddress(cy_stc_dma_descriptor_t *descriptor, const void *dstAddress)
+{
+    descriptor->dstAddress = (void *) dstAddress;
+}
+
+void * Cy_DMA_Descriptor_GetSrcAddress(const cy_stc_dma_descriptor_t *descriptor)
+{
+    return descriptor->srcAddress;
+}
+
+void * Cy_DMA_Descriptor_GetDstAddress(const cy_stc_dma_descriptor_t *descriptor)
+{
+    return descriptor->dstAddress;
+}
+
+void Cy_DMA_Descriptor_SetXloopDataCount(cy_stc_dma_descriptor_t *descriptor, uint32_t xCount)
+{
+    descriptor->xCount = xCount;
+}
+
+void Cy_DMA_Descriptor_SetYloopDataCount(cy_stc_dma_descriptor_t *descriptor, uint32_t yCount)
+{
+    descriptor->yCount = yCount;
+}
+
+cy_en_dma_status_t Cy_DMA_Channel_Init(DW_Type *base, uint32_t channel,
+    const cy_stc_dma_channel_config_t *channelConfig)
+{
+    if ((NULL == base) || (channel >= DMA_HOST_CHANNELS) || (NULL == channelConfig))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+    base->channel[channel].current = channelConfig->descriptor;
+    base->channel[channel].xIndex = 0u;
+    base->channel[channel].yIndex = 0u;
+    base->channel[channel].priority = channelConfig->priority;
+    base->channel[channel].enabled = channelConfig->enable;
+    return CY_DMA_SUCCESS;
+}
+
+void Cy_DMA_Channel_SetDescriptor(DW_Type *base, uint32_t channel, const cy_stc_dma_descriptor_t *descriptor)
+{
+    base->channel[channel].current = (cy_stc_dma_descriptor_t *) descriptor;
+    base->channel[channel].xIndex = 0u;
+    base->channel[channel].yIndex = 0u;
+}
+
+cy_stc_dma_descriptor_t * Cy_DMA_Channel_GetCurrentDescriptor(DW_Type const *base, uint32_t channel)
+{
+    return base->channel[channel].current;
+}
+
+void Cy_DMA_Channel_Enable(DW_Type *base, uint32_t channel)
+{
+    base->channel[channel].enabled = true;
+}
+
+void Cy_DMA_Channel_Disable(DW_Type *base, uint32_t channel)
+{
+    base->channel[channel].enabled = false;
+}
+
+void Cy_DMA_Channel_SetInterruptMask(DW_Type *base, uint32_t channel, uint32_t interrupt)
+{
+    base->channel[channel].interruptMask = interrupt;
+}
+
+uint32_t Cy_DMA_Channel_GetInterruptStatus(DW_Type const *base, uint32_t channel)
+{
+    return (CY_DMA_INTR_CAUSE_NO_INTR != base->channel[channel].cause) ?
+        (CY_DMA_INTR_MASK & base->channel[channel].interruptMask) : 0u;
+}
+
+cy_en_dma_intr_cause_t Cy_DMA_Channel_GetStatus(DW_Type const *base, uint32_t channel)
+{
+    return base->channel[channel].cause;
+}
+
+void Cy_DMA_Channel_ClearInterrupt(DW_Type *base, uint32_t channel)
+{
+    base->channel[channel].cause = CY_DMA_INTR_CAUSE_NO_INTR;
+}
+
+void Cy_DMA_Enable(DW_Type *base)
+{
+    base->enabled = true;
+}
+
+void Cy_DMA_Disable(DW_Type *base)
+{
+    base->enabled = false;
+}
+
+/* [] END OF FILE */
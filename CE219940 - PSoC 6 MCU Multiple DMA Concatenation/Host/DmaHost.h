@@ -0,0 +1,250 @@
+/*******************************************************************************
+* File Name: DmaHost.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains a host stand-in for the parts of the PDL DMA (DataWire)
+*  driver used by RecordAssembler.c: the descriptor and channel types, their
+*  init and control functions, and an executor of the descriptors. Host/project.h
+*  includes this file, so the module builds unchanged on a PC.
+*  Nothing runs on its own. A test calls DmaHost_Reset(), optionally connects
+*  the trigger output of one channel to the trigger input of another, then
+*  calls DmaHost_Trigger() for every hardware trigger. A trigger runs as many
+*  elements as the trigger input type of the current descriptor asks for:
+*  one element, one X loop, one descriptor or the descriptors up to the end
+*  of the chain. Trigger outputs are delivered after the trigger completes,
+*  interrupts are latched as a completion cause of the channel.
+*  Addresses are host pointers. Increments are in elements. A transfer size
+*  of a word reads or writes 32 bits and keeps the element size, like the
+*  DataWire does for peripheral registers.
+*  Build, e.g. with RecordAssembler:
+*   cc -I. -I../CE219940_DMA_Concatenation.cydsn DmaHost.c
+*      ../CE219940_DMA_Concatenation.cydsn/RecordAssembler.c your_test.c
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef DMAHOST_H
+#define DMAHOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Simulated DataWire blocks and channels */
+#define DMA_HOST_BLOCKS             (2u)
+#define DMA_HOST_CHANNELS           (16u)
+
+/* Descriptor settings, same names and values as the PDL (cy_dma.h) */
+typedef enum
+{
+    CY_DMA_RETRIG_IM      = 0u,
+    CY_DMA_RETRIG_4CYC    = 1u,
+    CY_DMA_RETRIG_16CYC   = 2u,
+    CY_DMA_WAIT_FOR_REACT = 3u
+} cy_en_dma_retrigger_t;
+
+typedef enum
+{
+    CY_DMA_1ELEMENT    = 0u,
+    CY_DMA_X_LOOP      = 1u,
+    CY_DMA_DESCR       = 2u,
+    CY_DMA_DESCR_CHAIN = 3u
+} cy_en_dma_trigger_type_t;
+
+typedef enum
+{
+    CY_DMA_CHANNEL_ENABLED  = 0u,
+    CY_DMA_CHANNEL_DISABLED = 1u
+} cy_en_dma_channel_state_t;
+
+typedef enum
+{
+    CY_DMA_BYTE     = 0u,
+    CY_DMA_HALFWORD = 1u,
+    CY_DMA_WORD     = 2u
+} cy_en_dma_data_size_t;
+
+typedef enum
+{
+    CY_DMA_TRANSFER_SIZE_DATA = 0u,
+    CY_DMA_TRANSFER_SIZE_WORD = 1u
+} cy_en_dma_transfer_size_t;
+
+typedef enum
+{
+    CY_DMA_SINGLE_TRANSFER = 0u,
+    CY_DMA_1D_TRANSFER     = 1u,
+    CY_DMA_2D_TRANSFER     = 2u,
+    CY_DMA_CRC_TRANSFER    = 3u
+} cy_en_dma_descriptor_type_t;
+
+typedef enum
+{
+    CY_DMA_SUCCESS       = 0u,
+    CY_DMA_BAD_PARAM     = 1u,
+    CY_DMA_INVALID_STATE = 2u
+} cy_en_dma_status_t;
+
+typedef enum
+{
+    CY_DMA_INTR_CAUSE_NO_INTR       = 0u,
+    CY_DMA_INTR_CAUSE_COMPLETION    = 1u,
+    CY_DMA_INTR_CAUSE_CURR_PTR_NULL = 5u
+} cy_en_dma_intr_cause_t;
+
+#define CY_DMA_INTR_MASK            (0x01uL)
+
+/* Descriptor in SRAM. The host keeps the configuration as it is. */
+typedef struct cy_stc_dma_descriptor
+{
+    cy_en_dma_retrigger_t retrigger;
+    cy_en_dma_trigger_type_t interruptType;
+    cy_en_dma_trigger_type_t triggerOutType;
+    cy_en_dma_channel_state_t channelState;
+    cy_en_dma_trigger_type_t triggerInType;
+    cy_en_dma_data_size_t dataSize;
+    cy_en_dma_transfer_size_t srcTransferSize;
+    cy_en_dma_transfer_size_t dstTransferSize;
+    cy_en_dma_descriptor_type_t descriptorType;
+    void *srcAddress;
+    void *dstAddress;
+    int32_t srcXincrement;
+    int32_t dstXincrement;
+    uint32_t xCount;
+    int32_t srcYincrement;
+    int32_t dstYincrement;
+    uint32_t yCount;
+    struct cy_stc_dma_descriptor *nextDescriptor;
+} cy_stc_dma_descriptor_t;
+
+typedef struct
+{
+    cy_en_dma_retrigger_t retrigger;
+    cy_en_dma_trigger_type_t interruptType;
+    cy_en_dma_trigger_type_t triggerOutType;
+    cy_en_dma_channel_state_t channelState;
+    cy_en_dma_trigger_type_t triggerInType;
+    cy_en_dma_data_size_t dataSize;
+    cy_en_dma_transfer_size_t srcTransferSize;
+    cy_en_dma_transfer_size_t dstTransferSize;
+    cy_en_dma_descriptor_type_t descriptorType;
+    void *srcAddress;
+    void *dstAddress;
+    int32_t srcXincrement;
+    int32_t dstXincrement;
+    uint32_t xCount;
+    int32_t srcYincrement;
+    int32_t dstYincrement;
+    uint32_t yCount;
+    cy_stc_dma_descriptor_t *nextDescriptor;
+} cy_stc_dma_descriptor_config_t;
+
+typedef struct
+{
+    cy_stc_dma_descriptor_t *descriptor;
+    bool preemptable;
+    uint32_t priority;
+    bool enable;
+    bool bufferable;
+} cy_stc_dma_channel_config_t;
+
+/* State of a simulated channel */
+typedef struct
+{
+    bool enabled;
+    uint32_t priority;
+    cy_stc_dma_descriptor_t *current;
+    uint32_t xIndex;
+    uint32_t yIndex;
+    uint32_t interruptMask;
+    cy_en_dma_intr_cause_t cause;
+    void *triggerOutHw;                 /* Connected block, NULL if none */
+    uint32_t triggerOutChannel;
+    uint32_t triggers;                  /* Triggers received */
+} dma_host_channel_t;
+
+/* A DataWire block */
+typedef struct
+{
+    bool enabled;
+    dma_host_channel_t channel[DMA_HOST_CHANNELS];
+} DW_Type;
+
+extern DW_Type DmaHost_Dw[DMA_HOST_BLOCKS];
+#define DW0                         (&DmaHost_Dw[0])
+#define DW1                         (&DmaHost_Dw[1])
+
+/* PDL functions used by the modules */
+cy_en_dma_status_t Cy_DMA_Descriptor_Init(cy_stc_dma_descriptor_t *descriptor,
+    const cy_stc_dma_descriptor_config_t *config);
+void Cy_DMA_Descriptor_SetNextDescriptor(cy_stc_dma_descriptor_t *descriptor,
+    const cy_stc_dma_descriptor_t *nextDescriptor);
+void Cy_DMA_Descriptor_SetSrcAddress(cy_stc_dma_descriptor_t *descriptor, const void *srcAddress);
+void Cy_DMA_Descriptor_SetDstAddress(cy_stc_dma_descriptor_t *descriptor, const void *dstAddress);
+void * Cy_DMA_Descriptor_GetSrcAddress(const cy_stc_dma_descriptor_t *descriptor);
+void * Cy_DMA_Descriptor_GetDstAddress(const cy_stc_dma_descriptor_t *descriptor);
+void Cy_DMA_Descriptor_SetXloopDataCount(cy_stc_dma_descriptor_t *descriptor, uint32_t xCount);
+void Cy_DMA_Descriptor_SetYloopDataCount(cy_stc_dma_descriptor_t *descriptor, uint32_t yCount);
+cy_en_dma_status_t Cy_DMA_Channel_Init(DW_Type *base, uint32_t channel,
+    const cy_stc_dma_channel_config_t *channelConfig);
+void Cy_DMA_Channel_SetDescriptor(DW_Type *base, uint32_t channel, const cy_stc_dma_descriptor_t *descriptor);
+cy_stc_dma_descriptor_t * Cy_DMA_Channel_GetCurrentDescriptor(DW_Type const *base, uint32_t channel);
+void Cy_DMA_Channel_Enable(DW_Type *base, uint32_t channel);
+void Cy_DMA_Channel_Disable(DW_Type *base, uint32_t channel);
+void Cy_DMA_Channel_SetInterruptMask(DW_Type *base, uint32_t channel, uint32_t interrupt);
+uint32_t Cy_DMA_Channel_GetInterruptStatus(DW_Type const *base, uint32_t channel);
+cy_en_dma_intr_cause_t Cy_DMA_Channel_GetStatus(DW_Type const *base, uint32_t channel);
+void Cy_DMA_Channel_ClearInterrupt(DW_Type *base, uint32_t channel);
+void Cy_DMA_Enable(DW_Type *base);
+void Cy_DMA_Disable(DW_Type *base);
+
+/* Controls of the simulation */
+void DmaHost_Reset(void);
+void DmaHost_Connect(DW_Type *srcHw, uint32_t srcChannel, DW_Type *dstHw, uint32_t dstChannel);
+void DmaHost_Trigger(DW_Type *base, uint32_t channel);
+uint32_t DmaHost_GetTriggers(DW_Type const *base, uint32_t channel);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* DMAHOST_H */
+
+/* [] END OF FILE */
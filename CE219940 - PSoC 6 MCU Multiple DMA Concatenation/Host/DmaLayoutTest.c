@@ -0,0 +1,243 @@
+/*******************************************************************************
+* File Name: DmaLayoutTest.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains a host test of DmaLayout_Compute(). It checks the
+*  descriptor parameters of the default layout against the values the
+*  firmware used before the layout could be changed, the rejection of every
+*  size limit including the 256 X/Y count of a DataWire descriptor, and that
+*  a rejected layout leaves the previous one untouched.
+*  Build and run:
+*   cc -I../CE219940_DMA_Concatenation.cydsn DmaLayoutTest.c
+*      ../CE219940_DMA_Concatenation.cydsn/DmaLayout.c -o DmaLayoutTest
+*   ./DmaLayoutTest
+*  The exit status is the number of failed checks.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "DmaLayout.h"
+
+/* Limits of the firmware build, see main_cm4.c and PacketFramer.h */
+#define HEADER_SIZE             (12u)
+#define STAMP_SIZE              (4u)
+#define PACKET_MAX_SIZE         (64u)
+#define RTC_BUFFER_SIZE         (20u)
+#define MAX_LOG                 (4u)
+#define MAX_LOG_LIMIT           (16u)
+#define MEMORY_ARRAY_SIZE       (MAX_LOG * (HEADER_SIZE + RTC_BUFFER_SIZE + PACKET_MAX_SIZE))
+
+/* Limits large enough that only the DataWire counts reject a layout */
+#define WIDE_SIZE               (1024u)
+
+static const dma_layout_limits_t FirmwareLimits =
+{
+    HEADER_SIZE, STAMP_SIZE, PACKET_MAX_SIZE, RTC_BUFFER_SIZE, MAX_LOG_LIMIT, MEMORY_ARRAY_SIZE
+};
+
+static unsigned Failures = 0u;
+
+#define CHECK_EQUAL(actual, expected) \
+    CheckEqual(__LINE__, #actual, (unsigned long)(actual), (unsigned long)(expected))
+
+static void CheckEqual(int line, const char *name, unsigned long actual, unsigned long expected)
+{
+    if (actual != expected)
+    {
+        printf("line %d: %s is %lu, expected %lu\n", line, name, actual, expected);
+        Failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Compute
+********************************************************************************
+*
+* Runs DmaLayout_Compute() on a layout filled with a pattern and checks that
+* the pattern is kept when the result is not DMA_LAYOUT_SUCCESS.
+*
+*******************************************************************************/
+static dma_layout_status_t Compute(uint32_t packetSize, uint32_t textSize, uint32_t batchSize,
+    const dma_layout_limits_t *limits, dma_layout_t *layout)
+{
+    const dma_layout_config_t config = { packetSize, textSize, batchSize };
+    dma_layout_t untouched;
+    dma_layout_status_t status;
+
+    memset(layout, 0xA5, sizeof(*layout));
+    memset(&untouched, 0xA5, sizeof(untouched));
+    status = DmaLayout_Compute(&config, limits, layout);
+    if ((DMA_LAYOUT_SUCCESS != status) && (0 != memcmp(layout, &untouched, sizeof(untouched))))
+    {
+        printf("layout %u/%u/%u: rejected layout was written\n",
+            (unsigned) packetSize, (unsigned) textSize, (unsigned) batchSize);
+        Failures++;
+    }
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: TestDefaultLayout
+********************************************************************************
+*
+* The default layout of 16 packet bytes, a 20 byte date string and 4 records
+* per batch, as hard-coded by the firmware before DmaLayout existed.
+*
+*******************************************************************************/
+static void TestDefaultLayout(void)
+{
+    dma_layout_t layout;
+
+    CHECK_EQUAL(Compute(16u, RTC_BUFFER_SIZE, MAX_LOG, &FirmwareLimits, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.recordSize, 48u);
+    CHECK_EQUAL(layout.textOffset, 12u);
+    CHECK_EQUAL(layout.packetOffset, 32u);
+    CHECK_EQUAL(layout.rxStampXCount, 24u);
+    CHECK_EQUAL(layout.rxPacketXCount, 16u);
+    CHECK_EQUAL(layout.memXCount, 48u);
+    CHECK_EQUAL(layout.memYCount, 4u);
+    CHECK_EQUAL(layout.memDstYIncrement, 48u);
+    CHECK_EQUAL(layout.txRecordCount, 4u);
+    CHECK_EQUAL(layout.txTextXCount, 20u);
+    CHECK_EQUAL(layout.txMaxXCount, 36u);
+    CHECK_EQUAL(layout.batchBytes, 192u);
+    CHECK_EQUAL(DmaLayout_RecordOffset(&layout, 0u), 0u);
+    CHECK_EQUAL(DmaLayout_RecordOffset(&layout, 3u), 144u);
+}
+
+/*******************************************************************************
+* Function Name: TestRecordSizes
+********************************************************************************
+*
+* Record sizes at the limits of the build: the smallest record, the largest
+* record and the largest batch that still fits the memory array.
+*
+*******************************************************************************/
+static void TestRecordSizes(void)
+{
+    dma_layout_t layout;
+
+    CHECK_EQUAL(Compute(1u, 1u, 1u, &FirmwareLimits, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.recordSize, 14u);
+    CHECK_EQUAL(layout.packetOffset, 13u);
+    CHECK_EQUAL(layout.rxStampXCount, 5u);
+    CHECK_EQUAL(layout.txMaxXCount, 2u);
+    CHECK_EQUAL(layout.batchBytes, 14u);
+
+    CHECK_EQUAL(Compute(PACKET_MAX_SIZE, RTC_BUFFER_SIZE, MAX_LOG, &FirmwareLimits, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.recordSize, 96u);
+    CHECK_EQUAL(layout.txMaxXCount, 84u);
+    CHECK_EQUAL(layout.batchBytes, MEMORY_ARRAY_SIZE);
+
+    /* 16 records of 24 bytes fill the memory array of 384 bytes */
+    CHECK_EQUAL(Compute(8u, 4u, MAX_LOG_LIMIT, &FirmwareLimits, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.recordSize, 24u);
+    CHECK_EQUAL(layout.memYCount, 16u);
+    CHECK_EQUAL(layout.txRecordCount, 16u);
+    CHECK_EQUAL(DmaLayout_RecordOffset(&layout, 15u), 360u);
+    CHECK_EQUAL(layout.batchBytes, 384u);
+}
+
+/*******************************************************************************
+* Function Name: TestBuildLimits
+********************************************************************************
+*
+* Sizes rejected by the buffers and descriptors of the build.
+*
+*******************************************************************************/
+static void TestBuildLimits(void)
+{
+    dma_layout_t layout;
+
+    CHECK_EQUAL(Compute(0u, RTC_BUFFER_SIZE, MAX_LOG, &FirmwareLimits, &layout), DMA_LAYOUT_BAD_PACKET_SIZE);
+    CHECK_EQUAL(Compute(PACKET_MAX_SIZE + 1u, RTC_BUFFER_SIZE, MAX_LOG, &FirmwareLimits, &layout),
+        DMA_LAYOUT_BAD_PACKET_SIZE);
+    CHECK_EQUAL(Compute(16u, 0u, MAX_LOG, &FirmwareLimits, &layout), DMA_LAYOUT_BAD_TEXT_SIZE);
+    CHECK_EQUAL(Compute(16u, RTC_BUFFER_SIZE + 1u, MAX_LOG, &FirmwareLimits, &layout), DMA_LAYOUT_BAD_TEXT_SIZE);
+    CHECK_EQUAL(Compute(16u, RTC_BUFFER_SIZE, 0u, &FirmwareLimits, &layout), DMA_LAYOUT_BAD_BATCH_SIZE);
+    CHECK_EQUAL(Compute(1u, 1u, MAX_LOG_LIMIT + 1u, &FirmwareLimits, &layout), DMA_LAYOUT_BAD_BATCH_SIZE);
+    /* 5 records of 96 bytes do not fit the memory array */
+    CHECK_EQUAL(Compute(PACKET_MAX_SIZE, RTC_BUFFER_SIZE, MAX_LOG + 1u, &FirmwareLimits, &layout),
+        DMA_LAYOUT_NO_MEMORY);
+    CHECK_EQUAL(Compute(9u, 4u, MAX_LOG_LIMIT, &FirmwareLimits, &layout), DMA_LAYOUT_NO_MEMORY);
+}
+
+/*******************************************************************************
+* Function Name: TestDataWireLimits
+********************************************************************************
+*
+* With wide build limits only the X/Y count of 256 rejects a layout: the
+* record copied by the MemoryDma, the alarm tick and date string copied by
+* RxDma_Descriptor_1, and the number of records of a batch.
+*
+*******************************************************************************/
+static void TestDataWireLimits(void)
+{
+    const dma_layout_limits_t wide = { HEADER_SIZE, STAMP_SIZE, WIDE_SIZE, WIDE_SIZE, WIDE_SIZE, 1024u * WIDE_SIZE };
+    /* A header smaller than the stamp lets the date string reach the limit first */
+    const dma_layout_limits_t smallHeader = { 2u, STAMP_SIZE, WIDE_SIZE, WIDE_SIZE, WIDE_SIZE, 1024u * WIDE_SIZE };
+    dma_layout_t layout;
+
+    /* MemoryDma X count: header + date string + packet */
+    CHECK_EQUAL(Compute(224u, 20u, 1u, &wide, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.memXCount, DMA_LAYOUT_MAX_COUNT);
+    CHECK_EQUAL(Compute(225u, 20u, 1u, &wide, &layout), DMA_LAYOUT_BAD_RECORD_SIZE);
+
+    /* RxDma_Descriptor_1 X count: alarm tick + date string */
+    CHECK_EQUAL(Compute(1u, 252u, 1u, &smallHeader, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.rxStampXCount, DMA_LAYOUT_MAX_COUNT);
+    CHECK_EQUAL(layout.recordSize, 255u);
+    CHECK_EQUAL(Compute(1u, 253u, 1u, &smallHeader, &layout), DMA_LAYOUT_BAD_RECORD_SIZE);
+
+    /* MemoryDma Y count: records per batch */
+    CHECK_EQUAL(Compute(1u, 1u, DMA_LAYOUT_MAX_COUNT, &wide, &layout), DMA_LAYOUT_SUCCESS);
+    CHECK_EQUAL(layout.memYCount, DMA_LAYOUT_MAX_COUNT);
+    CHECK_EQUAL(Compute(1u, 1u, DMA_LAYOUT_MAX_COUNT + 1u, &wide, &layout), DMA_LAYOUT_BAD_BATCH_SIZE);
+}
+
+int main(void)
+{
+    TestDefaultLayout();
+    TestRecordSizes();
+    TestBuildLimits();
+    TestDataWireLimits();
+    printf("DmaLayoutTest: %u failed\n", Failures);
+    return (int) Failures;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,202 @@
+/*******************************************************************************
+* File Name: FlashLogFile.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains a file-backed stand-in of the flash port of the batch
+*  log. It keeps an erase count per row so that the wear levelling of the log
+*  can be checked on a host.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "FlashLogFile.h"
+
+static FILE *FlashFile = NULL;
+static uint32_t *EraseCount = NULL;
+static uint32_t TearBytes = FLASH_LOG_ROW_SIZE;
+static uint32_t FailWrite = 0u;
+
+static int32_t FlashLogFile_WriteRow(uint32_t row, const uint32_t data[FLASH_LOG_ROW_WORDS]);
+static void FlashLogFile_ReadRow(uint32_t row, uint32_t data[FLASH_LOG_ROW_WORDS]);
+
+static flash_log_port_t FlashLogFilePort =
+{
+    .numRows  = 0u,
+    .writeRow = &FlashLogFile_WriteRow,
+    .readRow  = &FlashLogFile_ReadRow
+};
+
+/*******************************************************************************
+* Function Name: FlashLogFile_Open
+********************************************************************************
+*
+* Opens the flash file, or creates it with numRows erased rows. Returns the
+* port to pass to FlashLog_Mount, or NULL if the file cannot be used.
+*
+*******************************************************************************/
+const flash_log_port_t * FlashLogFile_Open(const char *path, uint32_t numRows)
+{
+    static const uint8_t erased[FLASH_LOG_ROW_SIZE] = {0u};
+    uint32_t row;
+
+    FlashLogFile_Close();
+    FlashFile = fopen(path, "r+b");
+    if (NULL == FlashFile)
+    {
+        FlashFile = fopen(path, "w+b");
+        for (row = 0u; (NULL != FlashFile) && (row < numRows); row++)
+        {
+            (void) fwrite(erased, 1u, FLASH_LOG_ROW_SIZE, FlashFile);
+        }
+    }
+    EraseCount = calloc(numRows, sizeof(uint32_t));
+    if ((NULL == FlashFile) || (NULL == EraseCount))
+    {
+        FlashLogFile_Close();
+        return NULL;
+    }
+    (void) fflush(FlashFile);
+    FlashLogFilePort.numRows = numRows;
+    return &FlashLogFilePort;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogFile_Close
+********************************************************************************
+*
+* Closes the flash file.
+*
+*******************************************************************************/
+void FlashLogFile_Close(void)
+{
+    if (NULL != FlashFile)
+    {
+        (void) fclose(FlashFile);
+        FlashFile = NULL;
+    }
+    free(EraseCount);
+    EraseCount = NULL;
+    FlashLogFilePort.numRows = 0u;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogFile_TearNextWrite
+********************************************************************************
+*
+* Makes the next row write stop after the given number of bytes, leaving the
+* rest of the row erased, and report success as a power loss would.
+*
+*******************************************************************************/
+void FlashLogFile_TearNextWrite(uint32_t bytes)
+{
+    TearBytes = (bytes < FLASH_LOG_ROW_SIZE) ? bytes : FLASH_LOG_ROW_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogFile_FailNextWrite
+********************************************************************************
+*
+* Makes the next row write erase the row and report an error, as a row that
+* does not program would.
+*
+*******************************************************************************/
+void FlashLogFile_FailNextWrite(void)
+{
+    FailWrite = 1u;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogFile_GetEraseCount
+********************************************************************************
+*
+* Returns the number of times a row was erased since the file was opened.
+*
+*******************************************************************************/
+uint32_t FlashLogFile_GetEraseCount(uint32_t row)
+{
+    return (row < FlashLogFilePort.numRows) ? EraseCount[row] : 0u;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogFile_WriteRow
+********************************************************************************
+*
+* Erases and programs one row of the file.
+*
+*******************************************************************************/
+static int32_t FlashLogFile_WriteRow(uint32_t row, const uint32_t data[FLASH_LOG_ROW_WORDS])
+{
+    uint8_t image[FLASH_LOG_ROW_SIZE] = {0u};
+
+    if (row >= FlashLogFilePort.numRows)
+    {
+        return -1;
+    }
+    EraseCount[row]++;
+    (void) memcpy(image, data, (0u != FailWrite) ? 0u : TearBytes);
+    TearBytes = FLASH_LOG_ROW_SIZE;
+
+    if ((0 != fseek(FlashFile, (long)(row * FLASH_LOG_ROW_SIZE), SEEK_SET)) ||
+        (FLASH_LOG_ROW_SIZE != fwrite(image, 1u, FLASH_LOG_ROW_SIZE, FlashFile)) ||
+        (0 != fflush(FlashFile)) || (0u != FailWrite))
+    {
+        FailWrite = 0u;
+        return -1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: FlashLogFile_ReadRow
+********************************************************************************
+*
+* Copies one row of the file. Rows that cannot be read are returned erased.
+*
+*******************************************************************************/
+static void FlashLogFile_ReadRow(uint32_t row, uint32_t data[FLASH_LOG_ROW_WORDS])
+{
+    (void) memset(data, 0, FLASH_LOG_ROW_SIZE);
+    if ((row < FlashLogFilePort.numRows) &&
+        (0 == fseek(FlashFile, (long)(row * FLASH_LOG_ROW_SIZE), SEEK_SET)))
+    {
+        (void) fread(data, 1u, FLASH_LOG_ROW_SIZE, FlashFile);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,64 @@
+/*******************************************************************************
+* File Name: FlashLogFile.h
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains the definitions for a file-backed stand-in of the flash
+*  port of the batch log, used to run FlashLog.c on a host. Rows are stored
+*  back to back in a file that reads as erased (zero) when it is created.
+*  A write can be cut short after a number of bytes to emulate a power loss
+*  while a row is programmed, or fail to emulate a row that does not program.
+*  Build with the project folder on the include
+*  path, for example:
+*   cc -I../CE219940_DMA_Concatenation.cydsn app.c FlashLogFile.c
+*      ../CE219940_DMA_Concatenation.cydsn/FlashLog.c
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#ifndef FLASHLOGFILE_H
+#define FLASHLOGFILE_H
+
+#include "FlashLog.h"
+
+const flash_log_port_t * FlashLogFile_Open(const char *path, uint32_t numRows);
+void FlashLogFile_Close(void);
+void FlashLogFile_TearNextWrite(uint32_t bytes);
+void FlashLogFile_FailNextWrite(void);
+uint32_t FlashLogFile_GetEraseCount(uint32_t row);
+
+#endif /* FLASHLOGFILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* File Name: FlashLogTest.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains a host test of the batch log on the file-backed flash
+*  port. It checks that a row that fails to program is skipped without losing
+*  a committed page, both before and after the log is mounted again and when
+*  the log wraps over the skipped row.
+*  Build and run:
+*   cc -I../CE219940_DMA_Concatenation.cydsn FlashLogTest.c FlashLogFile.c
+*      ../CE219940_DMA_Concatenation.cydsn/FlashLog.c -o FlashLogTest
+*   ./FlashLogTest
+*  The exit status is the number of failed checks.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "FlashLogFile.h"
+
+#define TEST_FILE               "FlashLogTest.bin"
+#define TEST_ROWS               (8u)
+
+static flash_log_t Log;
+static unsigned Failures = 0u;
+
+#define CHECK_EQUAL(actual, expected) \
+    CheckEqual(__LINE__, #actual, (unsigned long)(actual), (unsigned long)(expected))
+
+static void CheckEqual(int line, const char *name, unsigned long actual, unsigned long expected)
+{
+    if (actual != expected)
+    {
+        printf("line %d: %s is %lu, expected %lu\n", line, name, actual, expected);
+        Failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: WritePage
+********************************************************************************
+*
+* Logs a page holding one batch with the value and writes it.
+*
+*******************************************************************************/
+static flash_log_status_t WritePage(uint32_t value)
+{
+    (void) FlashLog_Append(&Log, &value, sizeof(value));
+    (void) FlashLog_Flush(&Log);
+    return FlashLog_Process(&Log);
+}
+
+/*******************************************************************************
+* Function Name: CheckPages
+********************************************************************************
+*
+* Checks that the log holds the pages first..first+count-1 in order.
+*
+*******************************************************************************/
+static void CheckPages(int line, uint32_t first, uint32_t count)
+{
+    uint32_t data[FLASH_LOG_ROW_WORDS];
+    const uint8_t *batch;
+    uint32_t size = 0u;
+    uint32_t value;
+    uint32_t page;
+
+    CheckEqual(line, "FlashLog_GetPageCount", FlashLog_GetPageCount(&Log), count);
+    for (page = 0u; page < count; page++)
+    {
+        value = 0u;
+        if (FLASH_LOG_SUCCESS == FlashLog_ReadPage(&Log, page, data))
+        {
+            batch = FlashLog_GetBatch(data, 0u, &size);
+            if ((NULL != batch) && (sizeof(value) == size))
+            {
+                (void) memcpy(&value, batch, sizeof(value));
+            }
+        }
+        CheckEqual(line, "page value", value, first + page);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Remount
+********************************************************************************
+*
+* Mounts the log again from the file, as after a reset.
+*
+*******************************************************************************/
+static void Remount(void)
+{
+    FlashLogFile_Close();
+    CHECK_EQUAL(FlashLog_Mount(&Log, FlashLogFile_Open(TEST_FILE, TEST_ROWS)), FLASH_LOG_SUCCESS);
+}
+
+int main(void)
+{
+    uint32_t value;
+
+    (void) remove(TEST_FILE);
+    CHECK_EQUAL(FlashLog_Mount(&Log, FlashLogFile_Open(TEST_FILE, TEST_ROWS)), FLASH_LOG_SUCCESS);
+    CHECK_EQUAL(FlashLog_Mount(&Log, NULL), FLASH_LOG_BAD_PARAM);
+    Remount();
+
+    /* Rows 0 to 2 hold pages 0 to 2, row 3 fails, page 3 goes to row 4 */
+    for (value = 0u; value < 3u; value++)
+    {
+        CHECK_EQUAL(WritePage(value), FLASH_LOG_SUCCESS);
+    }
+    FlashLogFile_FailNextWrite();
+    CHECK_EQUAL(WritePage(3u), FLASH_LOG_WRITE_ERROR);
+    CHECK_EQUAL(Log.writeErrors, 1u);
+    CHECK_EQUAL(FlashLog_Process(&Log), FLASH_LOG_SUCCESS);
+    CHECK_EQUAL(Log.head, 5u);
+    CheckPages(__LINE__, 0u, 4u);
+    Remount();
+    CHECK_EQUAL(Log.head, 5u);
+    CheckPages(__LINE__, 0u, 4u);
+
+    /* Wrap: rows 5 to 7 fill the region, rows 0 and 1 replace pages 0 and 1 */
+    for (value = 4u; value < 9u; value++)
+    {
+        CHECK_EQUAL(WritePage(value), FLASH_LOG_SUCCESS);
+    }
+    CheckPages(__LINE__, 2u, 7u);
+    Remount();
+    CheckPages(__LINE__, 2u, 7u);
+
+    /* Row 2 replaces page 2, the skipped row 3 leaves the log without a page */
+    CHECK_EQUAL(WritePage(9u), FLASH_LOG_SUCCESS);
+    CheckPages(__LINE__, 3u, 7u);
+    CHECK_EQUAL(WritePage(10u), FLASH_LOG_SUCCESS);
+    CheckPages(__LINE__, 3u, 8u);
+    Remount();
+    CHECK_EQUAL(Log.head, 4u);
+    CheckPages(__LINE__, 3u, 8u);
+
+    /* A torn page is not committed: page 3 is erased and row 4 is the head */
+    FlashLogFile_TearNextWrite(FLASH_LOG_ROW_SIZE / 2u);
+    CHECK_EQUAL(WritePage(11u), FLASH_LOG_SUCCESS);
+    Remount();
+    CHECK_EQUAL(Log.head, 4u);
+    CheckPages(__LINE__, 4u, 7u);
+
+    FlashLogFile_Close();
+    (void) remove(TEST_FILE);
+    printf("FlashLogTest: %u failed\n", Failures);
+    return (int) Failures;
+}
+
+/* [] END OF FILE */
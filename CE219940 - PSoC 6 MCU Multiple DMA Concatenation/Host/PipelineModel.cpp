@@ -0,0 +1,837 @@
+/*******************************************************************************
+* File Name: PipelineModel.cpp
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains a host discrete-event timing model of the CE219940
+*  pipeline: UART RX FIFO -> RxDma -> MemoryDma -> TxDma -> UART TX FIFO.
+*  The descriptor X/Y counts come from DmaLayout_Compute(), the same code the
+*  firmware runs, and the packet framing follows PacketFramer.c. The three
+*  channels share one DataWire engine that executes one trigger at a time,
+*  with RxDma before MemoryDma before TxDma. Every trigger costs a descriptor
+*  fetch plus one element per byte. The ISRs share one CPU. The packet
+*  framer is busy from the first byte of a packet until the chain is
+*  re-armed, which includes up to one PACKET_CHECK_US of close latency.
+*  TX windows are modelled with a period of 0: a batch is echoed as soon as
+*  the TxDma is idle, and waits in a free batch slot meanwhile. Like the
+*  firmware, the TxDma chain has a record and a stamp descriptor per record
+*  plus the prompt, and only its end interrupts. The periodic sleep report
+*  is not modelled.
+*  The model reports the utilisation of every stage, the queueing delays and
+*  the losses, and with --sweep the highest sustainable packet rate.
+*  Build:
+*   cc -c ../CE219940_DMA_Concatenation.cydsn/DmaLayout.c
+*   c++ -std=c++11 -I../CE219940_DMA_Concatenation.cydsn PipelineModel.cpp
+*       DmaLayout.o -o PipelineModel
+*  Run "PipelineModel --help" for the parameters.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <queue>
+#include <vector>
+
+extern "C"
+{
+#include "DmaLayout.h"
+}
+
+/* Limits of the firmware build, see main_cm4.c and PacketFramer.h */
+#define HEADER_SIZE             (12u)
+#define STAMP_SIZE              (4u)
+#define PACKET_MAX_SIZE         (64u)
+#define RTC_BUFFER_SIZE         (20u)
+#define MAX_LOG                 (4u)
+#define MAX_LOG_LIMIT           (16u)
+#define MEMORY_ARRAY_SIZE       (MAX_LOG * (HEADER_SIZE + RTC_BUFFER_SIZE + PACKET_MAX_SIZE))
+#define TX_WINDOW_SLOTS         (4u)    /* TxWindow.h, one slot is being filled */
+
+/* Channels of the shared DataWire engine, in priority order */
+enum Channel { RX_DMA = 0, MEMORY_DMA = 1, TX_DMA = 2, CHANNEL_NR = 3 };
+
+/* Model parameters */
+struct Config
+{
+    double baud = 115200.0;         /* UART baud rate */
+    double frameBits = 10.0;        /* Start + 8 data + stop */
+    unsigned fifoDepth = 128u;      /* SCB RX and TX FIFO entries */
+    unsigned packetSize = 16u;      /* Layout: packet bytes per record */
+    unsigned textSize = RTC_BUFFER_SIZE; /* Layout: date string bytes */
+    unsigned batchSize = MAX_LOG;   /* Layout: records per batch */
+    unsigned length = 16u;          /* Bytes of every packet, delimiter included */
+    double rate = 10.0;             /* Packets per second offered */
+    unsigned packets = 2000u;       /* Packets simulated */
+    double dwClockHz = 50e6;        /* DataWire clock (clk_slow) */
+    double descrCycles = 24.0;      /* Descriptor fetch per trigger */
+    double elementCycles = 6.0;     /* Per element transferred */
+    double cpuClockHz = 100e6;      /* CM4 clock */
+    double isrCycles = 400.0;       /* Entry, body and exit of one ISR */
+    double checkUs = 1000.0;        /* PACKET_CHECK_US */
+    unsigned stampBytes = 28u;      /* Stamp text chained after every record */
+    unsigned promptBytes = 31u;     /* Prompt chained after the records */
+    bool sweep = false;
+};
+
+/* Results of one run */
+struct Result
+{
+    double simTime = 0.0;
+    double dwBusy[CHANNEL_NR] = {0.0, 0.0, 0.0};
+    double cpuBusy = 0.0;
+    double framerBusy = 0.0;
+    double rxLineBusy = 0.0;
+    double txLineBusy = 0.0;
+    double rxWaitSum = 0.0, rxWaitMax = 0.0;
+    double recordDelaySum = 0.0, recordDelayMax = 0.0;
+    double txQueueSum = 0.0, txQueueMax = 0.0;
+    double echoSum = 0.0, echoMax = 0.0;
+    unsigned long rxBytes = 0u, records = 0u, batches = 0u, echoed = 0u;
+    unsigned rxFifoMax = 0u, txFifoMax = 0u;
+    unsigned long rxOverflow = 0u, overruns = 0u;
+    bool sustainable = false;
+};
+
+/* Discrete-event model */
+class PipelineModel
+{
+public:
+    PipelineModel(const Config &config, const dma_layout_t &layout);
+    Result Run();
+
+private:
+    enum EventType { RX_BYTE, DW_DONE, CPU_DONE, UART_TX_DONE, GAP_CHECK };
+    enum IsrType { ISR_PACKET_START, ISR_CLOSE, ISR_RX_DONE, ISR_MEMORY_DONE, ISR_TX_DONE };
+    enum RxState { RX_HEADER, RX_DATA, RX_CLOSING, RX_REARM };
+
+    struct Event
+    {
+        double time;
+        unsigned long order;
+        EventType type;
+        int arg;
+        bool operator<(const Event &other) const
+        {
+            return (time != other.time) ? (time > other.time) : (order > other.order);
+        }
+    };
+
+    void Schedule(double time, EventType type, int arg = 0);
+    void RequestIsr(IsrType isr);
+    void StartCpu();
+    void StartDw();
+    bool DwReady(Channel channel) const;
+    void OnRxByte();
+    void OnDwDone(Channel channel);
+    void OnCpuDone(IsrType isr);
+    void OnGapCheck();
+    void OnUartTxDone();
+    void PushTxByte();
+
+    const Config cfg;
+    const dma_layout_t layout;
+    const double byteTime;
+    const double dwElement;
+    const double dwDescr;
+    const double isrTime;
+
+    std::priority_queue<Event> events;
+    unsigned long order = 0u;
+    double now = 0.0;
+    Result result;
+
+    /* UART RX FIFO: arrival time of every byte */
+    std::deque<double> rxFifo;
+    unsigned rxArrived = 0u;
+    double nextPacketStart = 0.0;
+    unsigned packetsSent = 0u;
+
+    /* RxDma chain */
+    RxState rxState = RX_HEADER;
+    unsigned received = 0u;
+    unsigned lastReceived = 0u;
+    unsigned idleChecks = 0u;
+    bool gapTimer = false;
+    double lastByteTime = 0.0;
+    double framerStart = 0.0;
+    bool closeRequest = false;
+
+    /* MemoryDma: closed records waiting for their copy */
+    std::deque<double> memQueue;
+    unsigned batchRecords = 0u;
+    std::vector<double> batchEnds;
+
+    /* TxDma and the UART TX FIFO */
+    std::deque<std::vector<double> > txBatches;
+    std::deque<double> txReady;
+    bool txActive = false;
+    std::deque<unsigned> txDescr;   /* Bytes left in every descriptor of the chain */
+    unsigned txFifo = 0u;
+    bool txShifting = false;
+    std::vector<double> txPackets;
+
+    /* Shared DataWire engine and CPU */
+    bool dwBusy = false;
+    Channel dwChannel = RX_DMA;
+    std::deque<IsrType> cpuQueue;
+    bool cpuBusy = false;
+};
+
+/*******************************************************************************
+* Function Name: PipelineModel
+********************************************************************************
+*
+* Derives the time of a UART byte, a DataWire element and descriptor fetch
+* and an ISR from the parameters.
+*
+*******************************************************************************/
+PipelineModel::PipelineModel(const Config &config, const dma_layout_t &dmaLayout) :
+    cfg(config), layout(dmaLayout),
+    byteTime(config.frameBits / config.baud),
+    dwElement(config.elementCycles / config.dwClockHz),
+    dwDescr(config.descrCycles / config.dwClockHz),
+    isrTime(config.isrCycles / config.cpuClockHz)
+{
+}
+
+/*******************************************************************************
+* Function Name: Run
+********************************************************************************
+*
+* Feeds the packets to the RX line and processes the events until every
+* byte has been echoed or dropped.
+*
+*******************************************************************************/
+Result PipelineModel::Run()
+{
+    Schedule(0.0, RX_BYTE);
+    while (!events.empty())
+    {
+        Event event = events.top();
+        events.pop();
+        now = event.time;
+        switch (event.type)
+        {
+        case RX_BYTE:       OnRxByte(); break;
+        case DW_DONE:       OnDwDone(static_cast<Channel>(event.arg)); break;
+        case CPU_DONE:      OnCpuDone(static_cast<IsrType>(event.arg)); break;
+        case UART_TX_DONE:  OnUartTxDone(); break;
+        case GAP_CHECK:     OnGapCheck(); break;
+        }
+    }
+    result.simTime = now;
+    return result;
+}
+
+void PipelineModel::Schedule(double time, EventType type, int arg)
+{
+    events.push(Event{time, order++, type, arg});
+}
+
+/*******************************************************************************
+* Function Name: OnRxByte
+********************************************************************************
+*
+* A byte of the offered packets reaches the RX FIFO. Packets start every
+* 1/rate seconds, or back to back when the line is saturated.
+*
+*******************************************************************************/
+void PipelineModel::OnRxByte()
+{
+    result.rxLineBusy += byteTime;
+    if (rxFifo.size() >= cfg.fifoDepth)
+    {
+        result.rxOverflow++;
+    }
+    else
+    {
+        rxFifo.push_back(now);
+        result.rxFifoMax = std::max(result.rxFifoMax, static_cast<unsigned>(rxFifo.size()));
+    }
+
+    if (++rxArrived == cfg.length)
+    {
+        rxArrived = 0u;
+        packetsSent++;
+        nextPacketStart = std::max(nextPacketStart + (1.0 / cfg.rate), now + byteTime);
+        if (packetsSent < cfg.packets)
+        {
+            Schedule(nextPacketStart, RX_BYTE);
+        }
+    }
+    else
+    {
+        Schedule(now + byteTime, RX_BYTE);
+    }
+    StartDw();
+}
+
+/*******************************************************************************
+* Function Name: DwReady
+********************************************************************************
+*
+* Returns true when the channel has a pending trigger.
+*
+*******************************************************************************/
+bool PipelineModel::DwReady(Channel channel) const
+{
+    switch (channel)
+    {
+    case RX_DMA:
+        return closeRequest ||
+            (!rxFifo.empty() && ((RX_HEADER == rxState) ||
+            ((RX_DATA == rxState) && (received < layout.rxPacketXCount))));
+    case MEMORY_DMA:
+        return !memQueue.empty();
+    case TX_DMA:
+        return txActive && !txDescr.empty() && (txFifo < cfg.fifoDepth);
+    default:
+        return false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartDw
+********************************************************************************
+*
+* Starts the highest priority pending trigger on the DataWire engine. A
+* trigger costs a descriptor fetch and its elements:
+*  RxDma header: tick descriptor (1) and descriptor 1 (alarm tick + date)
+*  RxDma data:   descriptor 2, one byte
+*  RxDma close:  close descriptor, one word
+*  MemoryDma:    one X loop, one record
+*  TxDma:        one byte of a record or of the prompt into the TX FIFO
+*
+*******************************************************************************/
+void PipelineModel::StartDw()
+{
+    int channel;
+    double cost = 0.0;
+
+    if (dwBusy)
+    {
+        return;
+    }
+    for (channel = RX_DMA; channel < CHANNEL_NR; channel++)
+    {
+        if (DwReady(static_cast<Channel>(channel)))
+        {
+            break;
+        }
+    }
+    if (CHANNEL_NR == channel)
+    {
+        return;
+    }
+
+    switch (channel)
+    {
+    case RX_DMA:
+        if (closeRequest)
+        {
+            cost = dwDescr + dwElement;
+        }
+        else if (RX_HEADER == rxState)
+        {
+            cost = (2.0 * dwDescr) + ((1.0 + layout.rxStampXCount) * dwElement);
+        }
+        else
+        {
+            cost = dwDescr + dwElement;
+        }
+        break;
+    case MEMORY_DMA:
+        cost = dwDescr + (layout.memXCount * dwElement);
+        break;
+    default:
+        cost = dwDescr + dwElement;
+        txDescr.front()--;
+        txFifo++;
+        result.txFifoMax = std::max(result.txFifoMax, txFifo);
+        break;
+    }
+    dwBusy = true;
+    dwChannel = static_cast<Channel>(channel);
+    result.dwBusy[channel] += cost;
+    Schedule(now + cost, DW_DONE, channel);
+}
+
+/*******************************************************************************
+* Function Name: OnDwDone
+********************************************************************************
+*
+* Completes the trigger that was running on the DataWire engine and raises
+* the interrupts and output triggers of the channel.
+*
+*******************************************************************************/
+void PipelineModel::OnDwDone(Channel channel)
+{
+    dwBusy = false;
+    switch (channel)
+    {
+    case RX_DMA:
+        if (closeRequest)
+        {
+            /* End of the chain: triggers the MemoryDma, interrupt re-arms */
+            closeRequest = false;
+            rxState = RX_REARM;
+            memQueue.push_back(lastByteTime);
+            RequestIsr(ISR_RX_DONE);
+        }
+        else if (RX_HEADER == rxState)
+        {
+            /* Tick descriptor interrupt starts the gap timer */
+            rxState = RX_DATA;
+            received = 0u;
+            framerStart = now;
+            RequestIsr(ISR_PACKET_START);
+        }
+        else
+        {
+            double arrival = rxFifo.front();
+            rxFifo.pop_front();
+            double wait = now - arrival;
+            result.rxWaitSum += wait;
+            result.rxWaitMax = std::max(result.rxWaitMax, wait);
+            result.rxBytes++;
+            received++;
+            lastByteTime = arrival;
+        }
+        break;
+
+    case MEMORY_DMA:
+    {
+        double end = memQueue.front();
+        memQueue.pop_front();
+        double delay = now - end;
+        result.recordDelaySum += delay;
+        result.recordDelayMax = std::max(result.recordDelayMax, delay);
+        result.records++;
+        batchEnds.push_back(end);
+        if (++batchRecords == layout.memYCount)
+        {
+            batchRecords = 0u;
+            txBatches.push_back(batchEnds);
+            txReady.push_back(now);
+            batchEnds.clear();
+            RequestIsr(ISR_MEMORY_DONE);
+        }
+        break;
+    }
+
+    default:
+        if (!txShifting)
+        {
+            txShifting = true;
+            Schedule(now + byteTime, UART_TX_DONE);
+        }
+        if (0u == txDescr.front())
+        {
+            /* Descriptor done, only the end of the chain interrupts */
+            txDescr.pop_front();
+            if (txDescr.empty())
+            {
+                RequestIsr(ISR_TX_DONE);
+            }
+        }
+        break;
+    }
+    StartDw();
+}
+
+/*******************************************************************************
+* Function Name: RequestIsr
+********************************************************************************
+*
+* Queues an interrupt on the CPU. Interrupts are served in order.
+*
+*******************************************************************************/
+void PipelineModel::RequestIsr(IsrType isr)
+{
+    cpuQueue.push_back(isr);
+    StartCpu();
+}
+
+void PipelineModel::StartCpu()
+{
+    double duration = isrTime;
+
+    if (cpuBusy || cpuQueue.empty())
+    {
+        return;
+    }
+    cpuBusy = true;
+    result.cpuBusy += duration;
+    Schedule(now + duration, CPU_DONE, cpuQueue.front());
+}
+
+/*******************************************************************************
+* Function Name: OnCpuDone
+********************************************************************************
+*
+* Applies the effect of an ISR at its end:
+*  ISR_PACKET_START: starts the gap timer (PacketFramer_PacketStarted)
+*  ISR_CLOSE:        software trigger of the close descriptor
+*  ISR_RX_DONE:      re-arms the RxDma chain at the tick descriptor
+*  ISR_MEMORY_DONE:  enables the TxDma chain of the batch
+*  ISR_TX_DONE:      disables the TxDma at the end of the chain, starts the next batch
+*
+*******************************************************************************/
+void PipelineModel::OnCpuDone(IsrType isr)
+{
+    cpuBusy = false;
+    cpuQueue.pop_front();
+    switch (isr)
+    {
+    case ISR_PACKET_START:
+        lastReceived = 0u;
+        idleChecks = 0u;
+        gapTimer = true;
+        Schedule(now + (cfg.checkUs * 1e-6), GAP_CHECK);
+        break;
+    case ISR_CLOSE:
+        closeRequest = true;
+        break;
+    case ISR_RX_DONE:
+        rxState = RX_HEADER;
+        result.framerBusy += now - framerStart;
+        break;
+    case ISR_MEMORY_DONE:
+        if (txActive)
+        {
+            /* Held in a batch slot, dropped when no slot is free */
+            if (txBatches.size() > (TX_WINDOW_SLOTS - 2u))
+            {
+                txBatches.pop_back();
+                txReady.pop_back();
+                result.overruns++;
+            }
+        }
+        else
+        {
+            PushTxByte();
+        }
+        break;
+    default:
+        txActive = false;
+        if (!txBatches.empty())
+        {
+            PushTxByte();
+        }
+        break;
+    }
+    StartCpu();
+    StartDw();
+}
+
+/*******************************************************************************
+* Function Name: PushTxByte
+********************************************************************************
+*
+* Enables the TxDma chain for the oldest waiting batch.
+*
+*******************************************************************************/
+void PipelineModel::PushTxByte()
+{
+    double wait = now - txReady.front();
+    unsigned record;
+
+    txReady.pop_front();
+    txPackets = txBatches.front();
+    txBatches.pop_front();
+    result.txQueueSum += wait;
+    result.txQueueMax = std::max(result.txQueueMax, wait);
+
+    for (record = 0u; record < txPackets.size(); record++)
+    {
+        txDescr.push_back(layout.txTextXCount + std::min(cfg.length, layout.rxPacketXCount));
+        txDescr.push_back(cfg.stampBytes);
+    }
+    txDescr.push_back(cfg.promptBytes);
+    txActive = true;
+    result.batches++;
+}
+
+/*******************************************************************************
+* Function Name: OnGapCheck
+********************************************************************************
+*
+* Gap timer ISR of the packet framer, see PacketFramer_GapCheck(). The
+* delimiter is the last byte of every offered packet.
+*
+*******************************************************************************/
+void PipelineModel::OnGapCheck()
+{
+    bool close = false;
+
+    if (!gapTimer)
+    {
+        return;
+    }
+    result.cpuBusy += isrTime;
+    if (received != lastReceived)
+    {
+        lastReceived = received;
+        idleChecks = 0u;
+        close = (received >= std::min(cfg.length, layout.rxPacketXCount)) && (cfg.length <= layout.rxPacketXCount);
+    }
+    else if (0u != received)
+    {
+        idleChecks++;
+        close = (idleChecks >= 500u) || (received == layout.rxPacketXCount);
+    }
+
+    if (close)
+    {
+        gapTimer = false;
+        rxState = RX_CLOSING;
+        RequestIsr(ISR_CLOSE);
+    }
+    else
+    {
+        Schedule(now + (cfg.checkUs * 1e-6), GAP_CHECK);
+    }
+}
+
+/*******************************************************************************
+* Function Name: OnUartTxDone
+********************************************************************************
+*
+* A byte left the TX shift register. When the last echo byte of a batch
+* leaves, the echo latency of its packets is recorded.
+*
+*******************************************************************************/
+void PipelineModel::OnUartTxDone()
+{
+    result.txLineBusy += byteTime;
+    txFifo--;
+    if (!txActive && (0u == txFifo) && !txPackets.empty())
+    {
+        for (double end : txPackets)
+        {
+            result.echoSum += now - end;
+            result.echoMax = std::max(result.echoMax, now - end);
+            result.echoed++;
+        }
+        txPackets.clear();
+    }
+    if (txFifo > 0u)
+    {
+        Schedule(now + byteTime, UART_TX_DONE);
+    }
+    else
+    {
+        txShifting = false;
+    }
+    StartDw();
+}
+
+/*******************************************************************************
+* Function Name: Simulate
+********************************************************************************
+*
+* Runs the model and decides whether the offered rate is sustainable: no
+* byte or batch is lost and the TX line keeps up with the offered packets.
+*
+*******************************************************************************/
+static Result Simulate(const Config &cfg, const dma_layout_t &layout)
+{
+    PipelineModel model(cfg, layout);
+    Result result = model.Run();
+    double offered = cfg.packets / cfg.rate;
+
+    result.sustainable = (0u == result.rxOverflow) && (0u == result.overruns) &&
+        (result.simTime < (offered + 1.0));
+    return result;
+}
+
+static void Report(const Config &cfg, const dma_layout_t &layout, const Result &r)
+{
+    const double t = r.simTime;
+    double util[7];
+    const char *name[7] = { "UART RX line", "RxDma", "MemoryDma", "TxDma", "CPU (ISRs)", "UART TX line",
+        "Packet framer" };
+    int worst = 0;
+    int index;
+
+    util[0] = r.rxLineBusy / t;
+    for (index = 0; index < CHANNEL_NR; index++)
+    {
+        util[1 + index] = r.dwBusy[index] / t;
+    }
+    util[4] = r.cpuBusy / t;
+    util[5] = r.txLineBusy / t;
+    util[6] = r.framerBusy / t;
+    for (index = 1; index < 7; index++)
+    {
+        worst = (util[index] > util[worst]) ? index : worst;
+    }
+
+    printf("Layout: record %u bytes, rx stamp %u, rx packet %u, memory %ux%u, tx %u records\n",
+        layout.recordSize, layout.rxStampXCount, layout.rxPacketXCount,
+        layout.memXCount, layout.memYCount, layout.txRecordCount);
+    printf("Offered: %.2f packets/s of %u bytes at %.0f baud, %u packets, %.3f s simulated\n",
+        cfg.rate, cfg.length, cfg.baud, cfg.packets, t);
+    printf("\nStage utilisation\n");
+    for (index = 0; index < 7; index++)
+    {
+        printf("  %-14s %6.2f %%%s\n", name[index], 100.0 * util[index], (index == worst) ? "  <- highest" : "");
+    }
+    printf("  %-14s %6.2f %%\n", "DataWire total", 100.0 * (util[1] + util[2] + util[3]));
+    printf("\nQueueing delay (average / max)\n");
+    printf("  RX FIFO wait         %9.1f / %9.1f us  (max %u bytes queued)\n",
+        1e6 * r.rxWaitSum / std::max(1ul, r.rxBytes), 1e6 * r.rxWaitMax, r.rxFifoMax);
+    printf("  packet end -> memory %9.1f / %9.1f us\n",
+        1e6 * r.recordDelaySum / std::max(1ul, r.records), 1e6 * r.recordDelayMax);
+    printf("  batch -> TX start    %9.1f / %9.1f us\n",
+        1e6 * r.txQueueSum / std::max(1ul, r.batches), 1e6 * r.txQueueMax);
+    printf("  packet end -> echoed %9.1f / %9.1f ms\n",
+        1e3 * r.echoSum / std::max(1ul, r.echoed), 1e3 * r.echoMax);
+    printf("\nLosses: %lu RX FIFO overflow bytes, %lu batches dropped without a free slot\n",
+        r.rxOverflow, r.overruns);
+    printf("Sustainable: %s\n", r.sustainable ? "yes" : "no");
+}
+
+static void Usage(void)
+{
+    printf("PipelineModel [options]\n"
+           "  --baud N          UART baud rate (115200)\n"
+           "  --packet-size N   layout packet size (16)\n"
+           "  --text-size N     layout date string size (20)\n"
+           "  --batch-size N    layout records per batch (4)\n"
+           "  --length N        bytes per offered packet, delimiter included (16)\n"
+           "  --rate R          offered packets per second (10)\n"
+           "  --packets N       packets simulated (2000)\n"
+           "  --dw-clock HZ     DataWire clock (50e6)\n"
+           "  --descr-cycles N  cycles per descriptor fetch (24)\n"
+           "  --elem-cycles N   cycles per element (6)\n"
+           "  --cpu-clock HZ    CPU clock (100e6)\n"
+           "  --isr-cycles N    cycles per ISR (400)\n"
+           "  --stamp N         stamp bytes sent after every record (28)\n"
+           "  --prompt N        prompt bytes sent after every batch (31)\n"
+           "  --sweep           search the highest sustainable rate\n");
+}
+
+int main(int argc, char *argv[])
+{
+    Config cfg;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        const char *opt = argv[arg];
+        const char *val = (arg + 1 < argc) ? argv[arg + 1] : "0";
+        bool used = true;
+
+        if (0 == strcmp(opt, "--baud"))              cfg.baud = atof(val);
+        else if (0 == strcmp(opt, "--packet-size"))  cfg.packetSize = (unsigned) atoi(val);
+        else if (0 == strcmp(opt, "--text-size"))    cfg.textSize = (unsigned) atoi(val);
+        else if (0 == strcmp(opt, "--batch-size"))   cfg.batchSize = (unsigned) atoi(val);
+        else if (0 == strcmp(opt, "--length"))       cfg.length = (unsigned) atoi(val);
+        else if (0 == strcmp(opt, "--rate"))         cfg.rate = atof(val);
+        else if (0 == strcmp(opt, "--packets"))      cfg.packets = (unsigned) atoi(val);
+        else if (0 == strcmp(opt, "--dw-clock"))     cfg.dwClockHz = atof(val);
+        else if (0 == strcmp(opt, "--descr-cycles")) cfg.descrCycles = atof(val);
+        else if (0 == strcmp(opt, "--elem-cycles"))  cfg.elementCycles = atof(val);
+        else if (0 == strcmp(opt, "--cpu-clock"))    cfg.cpuClockHz = atof(val);
+        else if (0 == strcmp(opt, "--isr-cycles"))   cfg.isrCycles = atof(val);
+        else if (0 == strcmp(opt, "--stamp"))        cfg.stampBytes = (unsigned) atoi(val);
+        else if (0 == strcmp(opt, "--prompt"))       cfg.promptBytes = (unsigned) atoi(val);
+        else
+        {
+            used = false;
+            if (0 == strcmp(opt, "--sweep"))
+            {
+                cfg.sweep = true;
+            }
+            else
+            {
+                Usage();
+                return (0 == strcmp(opt, "--help")) ? 0 : 1;
+            }
+        }
+        arg += used ? 1 : 0;
+    }
+
+    const dma_layout_limits_t limits =
+    {
+        HEADER_SIZE, STAMP_SIZE, PACKET_MAX_SIZE, RTC_BUFFER_SIZE, MAX_LOG_LIMIT, MEMORY_ARRAY_SIZE
+    };
+    const dma_layout_config_t config = { cfg.packetSize, cfg.textSize, cfg.batchSize };
+    dma_layout_t layout;
+    dma_layout_status_t status = DmaLayout_Compute(&config, &limits, &layout);
+
+    if (DMA_LAYOUT_SUCCESS != status)
+    {
+        fprintf(stderr, "Layout rejected by DmaLayout_Compute, status %d\n", (int) status);
+        return 1;
+    }
+    if ((0u == cfg.length) || (cfg.rate <= 0.0) || (0u == cfg.packets))
+    {
+        Usage();
+        return 1;
+    }
+
+    if (cfg.sweep)
+    {
+        /* Bisect between an idle line and a saturated RX line */
+        double low = 0.0;
+        double high = cfg.baud / (cfg.frameBits * cfg.length);
+        int step;
+
+        for (step = 0; step < 30; step++)
+        {
+            cfg.rate = 0.5 * (low + high);
+            if (Simulate(cfg, layout).sustainable)
+            {
+                low = cfg.rate;
+            }
+            else
+            {
+                high = cfg.rate;
+            }
+        }
+        cfg.rate = (low > 0.0) ? low : high;
+        printf("Highest sustainable rate: %.2f packets/s\n\n", low);
+    }
+    Report(cfg, layout, Simulate(cfg, layout));
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,351 @@
+/*******************************************************************************
+* File Name: RecordAssemblerTest.c
+*
+* Version: 1.0
+*
+* Description:
+*  This file contains a host test of the record assembler on the DataWire
+*  stand-in (DmaHost.c). It gathers records of a counter register, a constant
+*  sync word, a byte-wide status register and a slice of ADC results, and
+*  checks the field placement, that one trigger runs the whole gather chain,
+*  that the end of the chain stores the record in the 2D ring which wraps
+*  after ringDepth records, and the rejected parameters.
+*  Build and run:
+*   cc -I. -I../CE219940_DMA_Concatenation.cydsn DmaHost.c RecordAssemblerTest.c
+*      ../CE219940_DMA_Concatenation.cydsn/RecordAssembler.c -o RecordAssemblerTest
+*   ./RecordAssemblerTest
+*  The exit status is the number of failed checks.
+*******************************************************************************
+* Related Document: CE219940.pdf
+*
+* Hardware Dependency: None (host)
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress Source Code and derivative works for the sole purpose of creating
+* custom software in support of licensee product to be used only in conjunction
+* with a Cypress integrated circuit as specified in the applicable agreement.
+* Any reproduction, modification, translation, compilation, or representation of
+* this software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: CYPRESS MAKES NO WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, WITH
+* REGARD TO THIS MATERIAL, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes without further notice to the
+* materials described herein. Cypress does not assume any liability arising out
+* of the application or use of any product or circuit described herein. Cypress
+* does not authorize its products for use as critical components in life-support
+* systems where a malfunction or failure may reasonably be expected to result in
+* significant injury to the user. The inclusion of Cypress' product in a life-
+* support systems application implies that the manufacturer assumes all risk of
+* such use and in doing so indemnifies Cypress against all charges. Use may be
+* limited by and subject to the applicable Cypress software license agreement.
+*****************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "RecordAssembler.h"
+
+/* Channels of the test, the store channel is triggered by the gather channel */
+#define GATHER_CHANNEL          (4u)
+#define STORE_CHANNEL           (5u)
+
+/* Fields of a record */
+#define SOURCES                 (4u)
+#define ADC_RESULTS             (8u)
+#define STATUS_BYTES            (3u)
+#define RECORD_SIZE             (28u)   /* 4 + 2 + 3, pad 1, + 16, pad 2 */
+#define RING_DEPTH              (3u)
+#define RECORDS                 (5u)    /* More than the ring holds */
+
+/* Simulated peripheral registers and memory */
+static uint32_t CounterRegister;
+static uint32_t StatusRegister;
+static uint16_t AdcResults[ADC_RESULTS];
+static const uint16_t SyncWord = 0xA55Au;
+
+static const record_source_t Sources[SOURCES] =
+{
+    { RECORD_SRC_REGISTER, &CounterRegister, 1u,           CY_DMA_WORD },
+    { RECORD_SRC_CONSTANT, &SyncWord,        1u,           CY_DMA_HALFWORD },
+    { RECORD_SRC_REGISTER, &StatusRegister,  STATUS_BYTES, CY_DMA_BYTE },
+    { RECORD_SRC_MEMORY,   AdcResults,       ADC_RESULTS,  CY_DMA_HALFWORD },
+};
+
+static cy_stc_dma_descriptor_t Descriptors[SOURCES];
+static uint32_t Staging[RECORD_SIZE / 4u];
+static uint32_t Ring[RING_DEPTH * (RECORD_SIZE / 4u)];
+
+static unsigned Failures = 0u;
+
+#define CHECK_EQUAL(actual, expected) \
+    CheckEqual(__LINE__, #actual, (unsigned long)(actual), (unsigned long)(expected))
+
+static void CheckEqual(int line, const char *name, unsigned long actual, unsigned long expected)
+{
+    if (actual != expected)
+    {
+        printf("line %d: %s is %lu, expected %lu\n", line, name, actual, expected);
+        Failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: NewAssembler
+********************************************************************************
+*
+* Resets the DataWire stand-in and returns an assembler on the test buffers,
+* with the store channel when ring is set.
+*
+*******************************************************************************/
+static record_assembler_t NewAssembler(bool ring)
+{
+    record_assembler_t assembler;
+
+    DmaHost_Reset();
+    (void) memset(&assembler, 0, sizeof(assembler));
+    (void) memset(Staging, 0, sizeof(Staging));
+    (void) memset(Ring, 0, sizeof(Ring));
+    assembler.gatherHw = DW0;
+    assembler.gatherChannel = GATHER_CHANNEL;
+    assembler.storeHw = ring ? DW0 : NULL;
+    assembler.storeChannel = STORE_CHANNEL;
+    assembler.retrigger = CY_DMA_RETRIG_IM;
+    assembler.descriptors = Descriptors;
+    assembler.staging = (uint8_t *) Staging;
+    assembler.stagingSize = sizeof(Staging);
+    assembler.ring = (uint8_t *) Ring;
+    assembler.ringDepth = RING_DEPTH;
+    return assembler;
+}
+
+/*******************************************************************************
+* Function Name: SetSources / CheckRecord
+********************************************************************************
+*
+* Sets the registers and ADC results of record number k, and checks that a
+* gathered record holds them at the expected offsets.
+*
+*******************************************************************************/
+static void SetSources(uint32_t k)
+{
+    uint32_t index;
+
+    CounterRegister = 1000u + k;
+    /* Only the low byte of the register is read per element */
+    StatusRegister = 0x12345600u + (0x10u * k);
+    for (index = 0u; index < ADC_RESULTS; index++)
+    {
+        AdcResults[index] = (uint16_t)((100u * k) + index);
+    }
+}
+
+static void CheckRecord(const uint8_t *record, uint32_t k, int line)
+{
+    uint32_t counter;
+    uint16_t word;
+    uint32_t index;
+    unsigned before = Failures;
+
+    (void) memcpy(&counter, &record[0], sizeof(counter));
+    CHECK_EQUAL(counter, 1000u + k);
+    (void) memcpy(&word, &record[4], sizeof(word));
+    CHECK_EQUAL(word, 0xA55Au);
+    for (index = 0u; index < STATUS_BYTES; index++)
+    {
+        CHECK_EQUAL(record[6u + index], 0x10u * k);
+    }
+    for (index = 0u; index < ADC_RESULTS; index++)
+    {
+        (void) memcpy(&word, &record[10u + (2u * index)], sizeof(word));
+        CHECK_EQUAL(word, (100u * k) + index);
+    }
+    if (Failures != before)
+    {
+        printf("  in record %u checked at line %d\n", (unsigned) k, line);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestLayout
+********************************************************************************
+*
+* Fields are placed in order, aligned to their element size, and the record
+* is rounded up to a word.
+*
+*******************************************************************************/
+static void TestLayout(void)
+{
+    record_assembler_t assembler = NewAssembler(true);
+
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_SUCCESS);
+    CHECK_EQUAL(assembler.recordSize, RECORD_SIZE);
+    CHECK_EQUAL(assembler.numSources, SOURCES);
+    CHECK_EQUAL(RecordAssembler_GetFieldOffset(&assembler, 0u), 0u);
+    CHECK_EQUAL(RecordAssembler_GetFieldOffset(&assembler, 1u), 4u);
+    CHECK_EQUAL(RecordAssembler_GetFieldOffset(&assembler, 2u), 6u);
+    CHECK_EQUAL(RecordAssembler_GetFieldOffset(&assembler, 3u), 10u);
+    /* Both channels wait for RecordAssembler_Start */
+    CHECK_EQUAL(DW0->channel[GATHER_CHANNEL].enabled, false);
+    CHECK_EQUAL(DW0->channel[STORE_CHANNEL].enabled, false);
+}
+
+/*******************************************************************************
+* Function Name: TestGatherAndRing
+********************************************************************************
+*
+* Every trigger of the gather channel runs the whole chain and interrupts at
+* its end, the end of the chain triggers one store of the record into the
+* ring. The ring wraps, so after 5 records slot 0 holds record 3.
+*
+*******************************************************************************/
+static void TestGatherAndRing(void)
+{
+    record_assembler_t assembler = NewAssembler(true);
+    uint32_t k;
+
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_SUCCESS);
+    DmaHost_Connect(DW0, GATHER_CHANNEL, DW0, STORE_CHANNEL);
+    RecordAssembler_Start(&assembler);
+
+    for (k = 0u; k < RECORDS; k++)
+    {
+        SetSources(k);
+        DmaHost_Trigger(DW0, GATHER_CHANNEL);
+
+        /* One trigger, the whole chain, one interrupt at the end */
+        CHECK_EQUAL(Cy_DMA_Channel_GetStatus(DW0, GATHER_CHANNEL), CY_DMA_INTR_CAUSE_COMPLETION);
+        CHECK_EQUAL(Cy_DMA_Channel_GetCurrentDescriptor(DW0, GATHER_CHANNEL), NULL);
+        CheckRecord((const uint8_t *) Staging, k, __LINE__);
+        CheckRecord(RecordAssembler_GetRecord(&assembler, k % RING_DEPTH), k, __LINE__);
+        CHECK_EQUAL(DmaHost_GetTriggers(DW0, STORE_CHANNEL), k + 1u);
+
+        RecordAssembler_Rearm(&assembler);
+        CHECK_EQUAL(Cy_DMA_Channel_GetStatus(DW0, GATHER_CHANNEL), CY_DMA_INTR_CAUSE_NO_INTR);
+        CHECK_EQUAL(Cy_DMA_Channel_GetCurrentDescriptor(DW0, GATHER_CHANNEL), &Descriptors[0]);
+    }
+
+    /* Slots after the wrap: records 3, 4 and 2 */
+    CheckRecord(RecordAssembler_GetRecord(&assembler, 0u), 3u, __LINE__);
+    CheckRecord(RecordAssembler_GetRecord(&assembler, 1u), 4u, __LINE__);
+    CheckRecord(RecordAssembler_GetRecord(&assembler, 2u), 2u, __LINE__);
+
+    /* Without a rearm the next trigger finds no descriptor, nothing is stored */
+    SetSources(8u);
+    DmaHost_Trigger(DW0, GATHER_CHANNEL);
+    DmaHost_Trigger(DW0, GATHER_CHANNEL);
+    CHECK_EQUAL(Cy_DMA_Channel_GetStatus(DW0, GATHER_CHANNEL), CY_DMA_INTR_CAUSE_CURR_PTR_NULL);
+    CHECK_EQUAL(DmaHost_GetTriggers(DW0, STORE_CHANNEL), RECORDS + 1u);
+    CheckRecord((const uint8_t *) Staging, 8u, __LINE__);
+
+    /* A stopped assembler ignores triggers */
+    RecordAssembler_Rearm(&assembler);
+    RecordAssembler_Stop(&assembler);
+    SetSources(7u);
+    DmaHost_Trigger(DW0, GATHER_CHANNEL);
+    CHECK_EQUAL(Cy_DMA_Channel_GetStatus(DW0, GATHER_CHANNEL), CY_DMA_INTR_CAUSE_NO_INTR);
+    CheckRecord((const uint8_t *) Staging, 8u, __LINE__);
+}
+
+/*******************************************************************************
+* Function Name: TestStagingOnly
+********************************************************************************
+*
+* Without a store channel the record stays in the staging buffer.
+*
+*******************************************************************************/
+static void TestStagingOnly(void)
+{
+    record_assembler_t assembler = NewAssembler(false);
+
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_SUCCESS);
+    RecordAssembler_Start(&assembler);
+    SetSources(2u);
+    DmaHost_Trigger(DW0, GATHER_CHANNEL);
+    CHECK_EQUAL(RecordAssembler_GetRecord(&assembler, 1u), (uint8_t *) Staging);
+    CheckRecord(RecordAssembler_GetRecord(&assembler, 0u), 2u, __LINE__);
+    CHECK_EQUAL(DmaHost_GetTriggers(DW0, STORE_CHANNEL), 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestRejections
+********************************************************************************
+*
+* Missing buffers, sources and counts, and records that do not fit.
+*
+*******************************************************************************/
+static void TestRejections(void)
+{
+    record_source_t sources[SOURCES];
+    record_source_t wide[2] =
+    {
+        { RECORD_SRC_MEMORY, AdcResults, 128u, CY_DMA_HALFWORD },
+        { RECORD_SRC_MEMORY, AdcResults, 1u,   CY_DMA_HALFWORD },
+    };
+    static uint32_t largeStaging[128];
+    record_assembler_t assembler;
+
+    assembler = NewAssembler(true);
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, 0u), RECORD_ASSEMBLER_BAD_PARAM);
+    assembler.descriptors = NULL;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+    assembler = NewAssembler(true);
+    assembler.staging = NULL;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+    assembler = NewAssembler(true);
+    assembler.ringDepth = 0u;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+    assembler.ringDepth = 257u;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+    assembler = NewAssembler(true);
+    assembler.ring = NULL;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+
+    /* The ring is not needed without a store channel */
+    assembler = NewAssembler(false);
+    assembler.ring = NULL;
+    assembler.ringDepth = 0u;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_SUCCESS);
+
+    assembler = NewAssembler(true);
+    (void) memcpy(sources, Sources, sizeof(sources));
+    sources[3].count = 0u;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+    sources[3].count = 257u;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+    sources[3].count = ADC_RESULTS;
+    sources[1].address = NULL;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, sources, SOURCES), RECORD_ASSEMBLER_BAD_PARAM);
+
+    /* One word short of the record */
+    assembler.stagingSize = RECORD_SIZE - 4u;
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, Sources, SOURCES), RECORD_ASSEMBLER_TOO_LARGE);
+
+    /* 256 bytes fit the store X count, 258 do not */
+    assembler = NewAssembler(false);
+    assembler.staging = (uint8_t *) largeStaging;
+    assembler.stagingSize = sizeof(largeStaging);
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, wide, 1u), RECORD_ASSEMBLER_SUCCESS);
+    CHECK_EQUAL(assembler.recordSize, 256u);
+    CHECK_EQUAL(RecordAssembler_Init(&assembler, wide, 2u), RECORD_ASSEMBLER_TOO_LARGE);
+}
+
+int main(void)
+{
+    TestLayout();
+    TestGatherAndRing();
+    TestStagingOnly();
+    TestRejections();
+    printf("RecordAssemblerTest: %u failed\n", Failures);
+    return (int) Failures;
+}
+
+/* [] END OF FILE */
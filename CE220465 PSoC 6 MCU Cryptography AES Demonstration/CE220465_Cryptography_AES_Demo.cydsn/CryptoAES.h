@@ -44,7 +44,7 @@
 #include "cy_crypto_config.h"
 
 #define AES128_KEY_LENGTH  (uint32_t)(16u)
-#define MAX_MESSAGE_SIZE   (uint32_t)(16u)
+#define MAX_MESSAGE_SIZE   (uint32_t)(128u)
 #define AES128_ENCRYPTION_LENGTH (uint32_t)(16u)
 #define CRYPTO_BLOCKING             true
 
@@ -56,10 +56,8 @@ cy_stc_crypto_context_aes_t cryptoAES;
 uint8_t AES_Key[AES128_KEY_LENGTH]={0xAA,0xBB,0xCC,0xDD,0xEE,0xFF,0xFF,0xEE,\
                                      0xDD,0xCC,0xBB,0xAA,0xAA,0xBB,0xCC,0xDD,};
 
-/* Data type definition to store the data in text format as well as in hexadecimal
-   format*/
-typedef union datablock
-{
-    char text[16];
-    uint32_t packedtext[4];
-}datablock_t;
+/* Initialization vector of CBC and initial counter block of CTR. A fixed value
+   keeps the demonstration repeatable; a real application must use a fresh
+   random IV for every message (see the TRNG example CE221295) */
+uint8_t AES_IV[CY_CRYPTO_AES_BLOCK_SIZE]={0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,\
+                                          0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,};
@@ -0,0 +1,374 @@
+/*****************************************************************************
+* File Name: CryptoAesStream.c
+* 
+* Version 1.20
+*
+* Description: This file contains the AES CBC and CTR streams. CBC keeps the
+* bytes of an incomplete block until the next piece and pads the last block
+* with PKCS#7; decryption holds the last block back until
+* CryptoAesStream_Final() removes and checks the padding. CTR sends the whole
+* blocks of a piece to the crypto server and XORs the bytes of a partial block
+* with a key stream block of its own, the ECB encryption of the counter, which
+* is kept for the next piece. The server only gets word-aligned buffers of
+* whole blocks; buffers of any other alignment go through the stream one block
+* at a time. The buffers of a call must not overlap.
+*
+* Related Document: CE220465.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+* 
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (Software), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (Cypress) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (EULA).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypresss integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (High Risk Product). By 
+* including Cypresss product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+#include "CryptoAesStream.h"
+#include "CryptoProfile.h"
+#include <string.h>
+
+/* The crypto server takes its buffers as words */
+#define CRYPTO_AES_STREAM_ALIGNED(ptr)  (0u == ((uintptr_t)(ptr) & 3u))
+
+static cy_en_crypto_status_t CryptoAesStream_CbcRun(crypto_aes_stream_t *stream, uint8_t *dst,
+                                                    const uint8_t *src, uint32_t size);
+static cy_en_crypto_status_t CryptoAesStream_CtrUpdate(crypto_aes_stream_t *stream, uint8_t *dst,
+                                                       const uint8_t *src, uint32_t srcSize);
+static cy_en_crypto_status_t CryptoAesStream_CtrKey(crypto_aes_stream_t *stream);
+static void CryptoAesStream_CtrAdd(uint32_t *counter, uint32_t blocks);
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_Init
+***********************************************************************************
+* Summary: Starts a stream. The key is set before with Cy_Crypto_Aes_Init on
+* aesContext
+*
+* Parameters:
+*  crypto_aes_stream_t *stream - stream to start
+*  crypto_aes_stream_mode_t mode - CRYPTO_AES_STREAM_CBC or CRYPTO_AES_STREAM_CTR
+*  cy_en_crypto_dir_mode_t dirMode - CY_CRYPTO_ENCRYPT or CY_CRYPTO_DECRYPT
+*  const uint8_t *iv - CBC initialization vector or CTR initial counter, one block
+*  cy_stc_crypto_context_aes_t *aesContext - AES context of the key
+*
+* Return:
+*  void
+*
+***********************************************************************************/
+void CryptoAesStream_Init(crypto_aes_stream_t *stream, crypto_aes_stream_mode_t mode,
+                          cy_en_crypto_dir_mode_t dirMode, const uint8_t *iv,
+                          cy_stc_crypto_context_aes_t *aesContext)
+{
+    stream->aes = aesContext;
+    stream->mode = mode;
+    stream->dirMode = dirMode;
+    memcpy(stream->iv, iv, CY_CRYPTO_AES_BLOCK_SIZE);
+    memset(stream->streamBlock, 0, CY_CRYPTO_AES_BLOCK_SIZE);
+    stream->streamOffset = CY_CRYPTO_AES_BLOCK_SIZE;
+    stream->blockSize = 0u;
+}
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_Update
+***********************************************************************************
+* Summary: Encrypts or decrypts the next piece of a message. CTR writes
+* srcSize bytes, with one request for the whole blocks of the piece and one
+* for a partial block. CBC writes the whole blocks that are complete, at most
+* srcSize + 15 bytes, with one request for the piece and one more when it
+* completes a block kept from the previous piece.
+*
+* Parameters:
+*  crypto_aes_stream_t *stream - started stream
+*  uint8_t *dst - output
+*  const uint8_t *src - next piece of the message
+*  uint32_t srcSize - size of the piece, any value
+*  uint32_t *dstSize - returns the bytes written to dst
+*
+* Return:
+*  cy_en_crypto_status_t - status of the crypto server
+*
+***********************************************************************************/
+cy_en_crypto_status_t CryptoAesStream_Update(crypto_aes_stream_t *stream, uint8_t *dst, const uint8_t *src,
+                                             uint32_t srcSize, uint32_t *dstSize)
+{
+    cy_en_crypto_status_t status = CY_CRYPTO_SUCCESS;
+    uint8_t *block = (uint8_t *)stream->block;
+    bool holdLast = (CY_CRYPTO_DECRYPT == stream->dirMode);
+    uint32_t size;
+
+    *dstSize = 0u;
+    if(CRYPTO_AES_STREAM_CTR == stream->mode)
+    {
+        status = CryptoAesStream_CtrUpdate(stream, dst, src, srcSize);
+        *dstSize = srcSize;
+        return status;
+    }
+
+    /* Complete the block kept from the previous piece */
+    if(0u != stream->blockSize)
+    {
+        size = CY_CRYPTO_AES_BLOCK_SIZE - stream->blockSize;
+        size = (srcSize < size) ? srcSize : size;
+        memcpy(&block[stream->blockSize], src, size);
+        stream->blockSize += size;
+        src += size;
+        srcSize -= size;
+        if((CY_CRYPTO_AES_BLOCK_SIZE == stream->blockSize) && ((!holdLast) || (0u != srcSize)))
+        {
+            status = CryptoAesStream_CbcRun(stream, dst, block, CY_CRYPTO_AES_BLOCK_SIZE);
+            stream->blockSize = 0u;
+            *dstSize = CY_CRYPTO_AES_BLOCK_SIZE;
+        }
+        if((CY_CRYPTO_SUCCESS != status) || (0u != stream->blockSize))
+        {
+            return status;
+        }
+    }
+
+    /* All whole blocks of the piece in one request, decryption keeps the last one */
+    size = srcSize - (srcSize % CY_CRYPTO_AES_BLOCK_SIZE);
+    if(holdLast && (0u != size) && (size == srcSize))
+    {
+        size -= CY_CRYPTO_AES_BLOCK_SIZE;
+    }
+    if(0u != size)
+    {
+        status = CryptoAesStream_CbcRun(stream, &dst[*dstSize], src, size);
+        *dstSize += size;
+    }
+    memcpy(block, &src[size], srcSize - size);
+    stream->blockSize = srcSize - size;
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_Final
+***********************************************************************************
+* Summary: Ends the message. CBC encryption pads the kept bytes with PKCS#7
+* and writes the last block, 16 bytes. CBC decryption decrypts the last block
+* and writes it without its padding, 0 to 15 bytes. CTR writes nothing.
+*
+* Parameters:
+*  crypto_aes_stream_t *stream - started stream
+*  uint8_t *dst - output, room for one block
+*  uint32_t *dstSize - returns the bytes written to dst
+*
+* Return:
+*  cy_en_crypto_status_t - CY_CRYPTO_SIZE_NOT_X16 when the ciphertext was not
+*  whole blocks, CY_CRYPTO_BAD_PARAMS when the padding is wrong
+*
+***********************************************************************************/
+cy_en_crypto_status_t CryptoAesStream_Final(crypto_aes_stream_t *stream, uint8_t *dst, uint32_t *dstSize)
+{
+    cy_en_crypto_status_t status;
+    uint8_t *block = (uint8_t *)stream->block;
+    uint32_t plain[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint8_t *last = (uint8_t *)plain;
+    uint32_t pad;
+    uint32_t index;
+    uint32_t error;
+
+    *dstSize = 0u;
+    if(CRYPTO_AES_STREAM_CTR == stream->mode)
+    {
+        return CY_CRYPTO_SUCCESS;
+    }
+
+    if(CY_CRYPTO_ENCRYPT == stream->dirMode)
+    {
+        pad = CY_CRYPTO_AES_BLOCK_SIZE - stream->blockSize;
+        memset(&block[stream->blockSize], (int)pad, pad);
+        status = CryptoAesStream_CbcRun(stream, dst, block, CY_CRYPTO_AES_BLOCK_SIZE);
+        stream->blockSize = 0u;
+        *dstSize = CY_CRYPTO_AES_BLOCK_SIZE;
+        return status;
+    }
+
+    if(CY_CRYPTO_AES_BLOCK_SIZE != stream->blockSize)
+    {
+        return CY_CRYPTO_SIZE_NOT_X16;
+    }
+    status = CryptoAesStream_CbcRun(stream, last, block, CY_CRYPTO_AES_BLOCK_SIZE);
+    stream->blockSize = 0u;
+    if(CY_CRYPTO_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* Every padding byte is checked, a wrong one is not found faster than others */
+    pad = last[CY_CRYPTO_AES_BLOCK_SIZE - 1u];
+    error = ((0u == pad) || (pad > CY_CRYPTO_AES_BLOCK_SIZE)) ? 1u : 0u;
+    for(index = 0u; index < CY_CRYPTO_AES_BLOCK_SIZE; index++)
+    {
+        if(index >= (CY_CRYPTO_AES_BLOCK_SIZE - pad))
+        {
+            error |= (uint32_t)(last[index] ^ (uint8_t)pad);
+        }
+    }
+    if(0u != error)
+    {
+        return CY_CRYPTO_BAD_PARAMS;
+    }
+    memcpy(dst, last, CY_CRYPTO_AES_BLOCK_SIZE - pad);
+    *dstSize = CY_CRYPTO_AES_BLOCK_SIZE - pad;
+    return CY_CRYPTO_SUCCESS;
+}
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_CbcRun
+***********************************************************************************
+* Summary: Runs CBC on whole blocks in one request and chains the stream to
+* the last ciphertext block
+*
+***********************************************************************************/
+static cy_en_crypto_status_t CryptoAesStream_CbcRun(crypto_aes_stream_t *stream, uint8_t *dst,
+                                                    const uint8_t *src, uint32_t size)
+{
+    cy_en_crypto_status_t status = CY_CRYPTO_SUCCESS;
+    uint32_t chain[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint32_t in[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint32_t out[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint32_t offset;
+
+    /* Decryption chains to its input, taken before the request */
+    memcpy(chain, &src[size - CY_CRYPTO_AES_BLOCK_SIZE], CY_CRYPTO_AES_BLOCK_SIZE);
+    if(CRYPTO_AES_STREAM_ALIGNED(dst) && CRYPTO_AES_STREAM_ALIGNED(src))
+    {
+        status = CryptoProfile_Aes_Cbc_Run(stream->dirMode, size, stream->iv, (uint32_t *)dst,
+                                           (uint32_t *)src, stream->aes);
+    }
+    else
+    {
+        /* The server chains stream->iv from block to block */
+        for(offset = 0u; (offset < size) && (CY_CRYPTO_SUCCESS == status); offset += CY_CRYPTO_AES_BLOCK_SIZE)
+        {
+            memcpy(in, &src[offset], CY_CRYPTO_AES_BLOCK_SIZE);
+            status = CryptoProfile_Aes_Cbc_Run(stream->dirMode, CY_CRYPTO_AES_BLOCK_SIZE, stream->iv, out, in,
+                                               stream->aes);
+            memcpy(&dst[offset], out, CY_CRYPTO_AES_BLOCK_SIZE);
+            memcpy(stream->iv, (CY_CRYPTO_ENCRYPT == stream->dirMode) ? out : in, CY_CRYPTO_AES_BLOCK_SIZE);
+        }
+    }
+    if(CY_CRYPTO_ENCRYPT == stream->dirMode)
+    {
+        memcpy(chain, &dst[size - CY_CRYPTO_AES_BLOCK_SIZE], CY_CRYPTO_AES_BLOCK_SIZE);
+    }
+    memcpy(stream->iv, chain, CY_CRYPTO_AES_BLOCK_SIZE);
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_CtrUpdate
+***********************************************************************************
+* Summary: Runs CTR on a piece. The key stream left from the previous piece
+* comes first, then the whole blocks in one request, then a partial block or
+* the blocks of unaligned buffers with a key stream block at a time. The
+* server only runs whole blocks from the start of its key stream, the stream
+* keeps and advances the counter itself.
+*
+***********************************************************************************/
+static cy_en_crypto_status_t CryptoAesStream_CtrUpdate(crypto_aes_stream_t *stream, uint8_t *dst,
+                                                       const uint8_t *src, uint32_t srcSize)
+{
+    cy_en_crypto_status_t status = CY_CRYPTO_SUCCESS;
+    const uint8_t *key = (const uint8_t *)stream->streamBlock;
+    uint32_t counter[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint32_t offset;
+    uint32_t size;
+
+    while((CY_CRYPTO_AES_BLOCK_SIZE != stream->streamOffset) && (0u != srcSize))
+    {
+        *dst++ = *src++ ^ key[stream->streamOffset++];
+        srcSize--;
+    }
+
+    size = srcSize - (srcSize % CY_CRYPTO_AES_BLOCK_SIZE);
+    if((0u != size) && CRYPTO_AES_STREAM_ALIGNED(dst) && CRYPTO_AES_STREAM_ALIGNED(src))
+    {
+        /* The server gets a copy of the counter, whether it updates it or not */
+        memcpy(counter, stream->iv, CY_CRYPTO_AES_BLOCK_SIZE);
+        offset = 0u;
+        status = CryptoProfile_Aes_Ctr_Run(stream->dirMode, size, &offset, counter, stream->streamBlock,
+                                           (uint32_t *)dst, (uint32_t *)src, stream->aes);
+        CryptoAesStream_CtrAdd(stream->iv, size / CY_CRYPTO_AES_BLOCK_SIZE);
+        dst += size;
+        src += size;
+        srcSize -= size;
+    }
+
+    while((CY_CRYPTO_SUCCESS == status) && (0u != srcSize))
+    {
+        if(CY_CRYPTO_AES_BLOCK_SIZE == stream->streamOffset)
+        {
+            status = CryptoAesStream_CtrKey(stream);
+        }
+        *dst++ = *src++ ^ key[stream->streamOffset++];
+        srcSize--;
+    }
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_CtrKey
+***********************************************************************************
+* Summary: Makes the key stream block of the counter with an ECB encryption,
+* for both directions, and advances the counter by one block
+*
+***********************************************************************************/
+static cy_en_crypto_status_t CryptoAesStream_CtrKey(crypto_aes_stream_t *stream)
+{
+    cy_en_crypto_status_t status;
+
+    status = CryptoProfile_Aes_Ecb_Run(CY_CRYPTO_ENCRYPT, stream->streamBlock, stream->iv, stream->aes);
+    CryptoAesStream_CtrAdd(stream->iv, 1u);
+    stream->streamOffset = 0u;
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoAesStream_CtrAdd
+***********************************************************************************
+* Summary: Adds blocks to the counter, a 128-bit big-endian number as in
+* NIST SP 800-38A
+*
+***********************************************************************************/
+static void CryptoAesStream_CtrAdd(uint32_t *counter, uint32_t blocks)
+{
+    uint8_t *bytes = (uint8_t *)counter;
+    uint32_t carry = blocks;
+    uint32_t index = CY_CRYPTO_AES_BLOCK_SIZE;
+
+    while((0u != carry) && (0u != index))
+    {
+        index--;
+        carry += bytes[index];
+        bytes[index] = (uint8_t)carry;
+        carry >>= 8u;
+    }
+}
+
+/* [] END OF FILE */
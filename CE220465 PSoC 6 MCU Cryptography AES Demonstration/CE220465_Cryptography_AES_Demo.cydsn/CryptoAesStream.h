@@ -0,0 +1,83 @@
+/*****************************************************************************
+* File Name: CryptoAesStream.h
+* 
+* Version 1.20
+*
+* Description: This file contains the definitions of the AES CBC and CTR
+* streams used in main_cm4.c. A stream takes a message of any length in one or
+* more pieces; every piece is one request to the crypto server for all of its
+* whole blocks, not one request per block, when its buffers are word-aligned.
+*
+* Related Document: CE220465.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+* 
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (Software), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (Cypress) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (EULA).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypresss integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (High Risk Product). By 
+* including Cypresss product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef CRYPTOAESSTREAM_H
+#define CRYPTOAESSTREAM_H
+
+#include "project.h"
+
+/* Words of one AES block */
+#define CRYPTO_AES_STREAM_BLOCK_WORDS   (CY_CRYPTO_AES_BLOCK_SIZE / 4u)
+
+/* Modes of a stream */
+typedef enum
+{
+    CRYPTO_AES_STREAM_CBC,      /* Whole blocks, PKCS#7 padding added and removed */
+    CRYPTO_AES_STREAM_CTR       /* Any length, the output is as long as the input */
+} crypto_aes_stream_mode_t;
+
+/* State of a stream between two pieces */
+typedef struct
+{
+    cy_stc_crypto_context_aes_t *aes;
+    crypto_aes_stream_mode_t mode;
+    cy_en_crypto_dir_mode_t dirMode;
+    uint32_t iv[CRYPTO_AES_STREAM_BLOCK_WORDS];            /* CBC chaining block or CTR counter */
+    uint32_t streamBlock[CRYPTO_AES_STREAM_BLOCK_WORDS];   /* CTR key stream of a partial block */
+    uint32_t streamOffset;                                  /* CTR key stream bytes used, 16 when none left */
+    uint32_t block[CRYPTO_AES_STREAM_BLOCK_WORDS];         /* CBC bytes of an incomplete block */
+    uint32_t blockSize;
+} crypto_aes_stream_t;
+
+void CryptoAesStream_Init(crypto_aes_stream_t *stream, crypto_aes_stream_mode_t mode,
+                          cy_en_crypto_dir_mode_t dirMode, const uint8_t *iv,
+                          cy_stc_crypto_context_aes_t *aesContext);
+cy_en_crypto_status_t CryptoAesStream_Update(crypto_aes_stream_t *stream, uint8_t *dst, const uint8_t *src,
+                                             uint32_t srcSize, uint32_t *dstSize);
+cy_en_crypto_status_t CryptoAesStream_Final(crypto_aes_stream_t *stream, uint8_t *dst, uint32_t *dstSize);
+
+#endif /* CRYPTOAESSTREAM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,345 @@
+/*****************************************************************************
+* File Name: CryptoProfile.c
+* 
+* Version 1.20
+*
+* Description: This file contains the profiled variants of the
+* crypto calls. The client on the CM4 sends every request to the crypto
+* server on the CM0+ through the IPC, so a call is measured up to the end of
+* Cy_Crypto_Sync(). Every operation is a region of ProfileRegion, which
+* attributes to it:
+*   Crypto access - bus reads and writes of the crypto block
+*   CM4 active    - HF cycles of the CM4, including the wait for the server
+*   CM4 cycles    - CPU cycles of the whole call, IPC round trip included
+* The profiler runs from CryptoProfile_Init() on, the regions take the
+* count deltas of the two profile counters.
+* CM4 cycles per byte are the figure to weigh against a software
+* implementation on the CM4.
+*
+* Related Document: CE220465.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+* 
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (Software), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (Cypress) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (EULA).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypresss integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (High Risk Product). By 
+* including Cypresss product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+#include "CryptoProfile.h"
+#include "ProfileRegion.h"
+#include "ProfileCycles.h"
+#include <stdio.h>
+
+#define CRYPTO_PROFILE_BLOCKING     true
+
+/* Monitor configuration of the profile counters */
+typedef struct
+{
+    const char *label;
+    en_ep_mon_sel_t monitor;
+    cy_en_profile_duration_t duration;
+} crypto_profile_monitor_t;
+
+static const crypto_profile_monitor_t profileMonitors[CRYPTO_PROFILE_COUNTERS] =
+{
+    { "Crypto access", CPUSS_MONITOR_CRYPTO, CY_PROFILE_EVENT },
+    { "CM4 active",    CPUSS_MONITOR_CM4,    CY_PROFILE_DURATION }
+};
+
+static cy_stc_profile_ctr_ptr_t profileCounters[CRYPTO_PROFILE_COUNTERS];
+
+/* Region of every operation, in the order of profileOps */
+static profile_region_t *profileRegions[CRYPTO_PROFILE_OPS];
+
+static crypto_profile_op_t profileOps[CRYPTO_PROFILE_OPS] =
+{
+    { "AES-128 ECB encrypt", 0u, 0u, { 0u } },
+    { "AES-128 ECB decrypt", 0u, 0u, { 0u } },
+    { "AES-128 CBC encrypt", 0u, 0u, { 0u } },
+    { "AES-128 CBC decrypt", 0u, 0u, { 0u } },
+    { "AES-128 CTR",         0u, 0u, { 0u } }
+};
+
+static void CryptoProfile_Begin(uint32_t op, profile_region_scope_t *scope);
+static void CryptoProfile_End(uint32_t op, profile_region_scope_t *scope, uint32_t bytes);
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Init
+***********************************************************************************
+* Summary: Initializes the Energy Profiler, assigns one counter to every
+* monitor of profileMonitors and attributes the counters to the regions.
+* The profiler runs from now on
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+***********************************************************************************/
+void CryptoProfile_Init(void)
+{
+    uint32_t index;
+
+    Cy_Profile_Init();
+    Cy_Profile_ClearConfiguration();
+    for(index = 0u; index < CRYPTO_PROFILE_COUNTERS; index++)
+    {
+        profileCounters[index] = Cy_Profile_ConfigureCounter(profileMonitors[index].monitor,
+                                     profileMonitors[index].duration, CY_PROFILE_CLK_HF, 1u);
+        (void)Cy_Profile_EnableCounter(profileCounters[index]);
+    }
+    ProfileCycles_Init();
+    ProfileRegion_Init();
+    ProfileRegion_SetCounters(profileCounters, CRYPTO_PROFILE_COUNTERS);
+    Cy_Profile_ClearCounters();
+    Cy_Profile_StartProfiling();
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Aes_Ecb_Run
+***********************************************************************************
+* Summary: Profiled variant of Cy_Crypto_Aes_Ecb_Run. Runs the operation,
+* waits for the crypto server and adds the counts to the operation
+*
+* Parameters:
+*  Same as Cy_Crypto_Aes_Ecb_Run
+*
+* Return:
+*  cy_en_crypto_status_t - status of the operation
+*
+***********************************************************************************/
+cy_en_crypto_status_t CryptoProfile_Aes_Ecb_Run(cy_en_crypto_dir_mode_t dirMode, uint32_t *dstBlock,
+                                                uint32_t *srcBlock, cy_stc_crypto_context_aes_t *cfContext)
+{
+    uint32_t op = (CY_CRYPTO_ENCRYPT == dirMode) ? CRYPTO_PROFILE_AES_ENCRYPT : CRYPTO_PROFILE_AES_DECRYPT;
+    profile_region_scope_t scope;
+    cy_en_crypto_status_t status;
+
+    CryptoProfile_Begin(op, &scope);
+    status = Cy_Crypto_Aes_Ecb_Run(dirMode, dstBlock, srcBlock, cfContext);
+    if(CY_CRYPTO_SUCCESS == status)
+    {
+        status = Cy_Crypto_Sync(CRYPTO_PROFILE_BLOCKING);
+    }
+    CryptoProfile_End(op, &scope, CY_CRYPTO_AES_BLOCK_SIZE);
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Aes_Cbc_Run
+***********************************************************************************
+* Summary: Profiled variant of Cy_Crypto_Aes_Cbc_Run. The whole buffer is one
+* request to the crypto server
+*
+* Parameters:
+*  Same as Cy_Crypto_Aes_Cbc_Run, srcSize is a multiple of the block size
+*
+* Return:
+*  cy_en_crypto_status_t - status of the operation
+*
+***********************************************************************************/
+cy_en_crypto_status_t CryptoProfile_Aes_Cbc_Run(cy_en_crypto_dir_mode_t dirMode, uint32_t srcSize, uint32_t *ivPtr,
+                                                uint32_t *dstPtr, uint32_t *srcPtr,
+                                                cy_stc_crypto_context_aes_t *cfContext)
+{
+    uint32_t op = (CY_CRYPTO_ENCRYPT == dirMode) ? CRYPTO_PROFILE_CBC_ENCRYPT : CRYPTO_PROFILE_CBC_DECRYPT;
+    profile_region_scope_t scope;
+    cy_en_crypto_status_t status;
+
+    CryptoProfile_Begin(op, &scope);
+    status = Cy_Crypto_Aes_Cbc_Run(dirMode, srcSize, ivPtr, dstPtr, srcPtr, cfContext);
+    if(CY_CRYPTO_SUCCESS == status)
+    {
+        status = Cy_Crypto_Sync(CRYPTO_PROFILE_BLOCKING);
+    }
+    CryptoProfile_End(op, &scope, srcSize);
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Aes_Ctr_Run
+***********************************************************************************
+* Summary: Profiled variant of Cy_Crypto_Aes_Ctr_Run. The whole buffer is one
+* request to the crypto server, encryption and decryption are the same
+* operation
+*
+* Parameters:
+*  Same as Cy_Crypto_Aes_Ctr_Run
+*
+* Return:
+*  cy_en_crypto_status_t - status of the operation
+*
+***********************************************************************************/
+cy_en_crypto_status_t CryptoProfile_Aes_Ctr_Run(cy_en_crypto_dir_mode_t dirMode, uint32_t srcSize, uint32_t *srcOffset,
+                                                uint32_t *ivPtr, uint32_t *streamBlock, uint32_t *dstPtr,
+                                                uint32_t *srcPtr, cy_stc_crypto_context_aes_t *cfContext)
+{
+    uint32_t op = CRYPTO_PROFILE_CTR;
+    profile_region_scope_t scope;
+    cy_en_crypto_status_t status;
+
+    CryptoProfile_Begin(op, &scope);
+    status = Cy_Crypto_Aes_Ctr_Run(dirMode, srcSize, srcOffset, ivPtr, streamBlock, dstPtr, srcPtr, cfContext);
+    if(CY_CRYPTO_SUCCESS == status)
+    {
+        status = Cy_Crypto_Sync(CRYPTO_PROFILE_BLOCKING);
+    }
+    CryptoProfile_End(op, &scope, srcSize);
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Clear
+***********************************************************************************
+* Summary: Clears the accumulated counts of every operation
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+***********************************************************************************/
+void CryptoProfile_Clear(void)
+{
+    uint32_t op;
+    uint32_t index;
+
+    ProfileRegion_Reset();
+    for(op = 0u; op < CRYPTO_PROFILE_OPS; op++)
+    {
+        profileOps[op].calls = 0u;
+        profileOps[op].bytes = 0u;
+        for(index = 0u; index < CRYPTO_PROFILE_MONITORS; index++)
+        {
+            profileOps[op].count[index] = 0u;
+        }
+    }
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_GetOp
+***********************************************************************************
+* Summary: Returns the accumulated counts of an operation
+*
+* Parameters:
+*  uint32_t op - one of the CRYPTO_PROFILE_ operations, e.g. CRYPTO_PROFILE_CTR
+*
+* Return:
+*  const crypto_profile_op_t* - counts of the operation, NULL if unknown
+*
+***********************************************************************************/
+const crypto_profile_op_t * CryptoProfile_GetOp(uint32_t op)
+{
+    return (op < CRYPTO_PROFILE_OPS) ? &profileOps[op] : NULL;
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Print
+***********************************************************************************
+* Summary: Displays the counts of every operation called so far per call and
+* per byte, with two decimals
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+***********************************************************************************/
+void CryptoProfile_Print(void)
+{
+    char print[80];
+    uint32_t op;
+    uint32_t index;
+    uint64_t perCall;
+    uint64_t perByte;
+
+    for(op = 0u; op < CRYPTO_PROFILE_OPS; op++)
+    {
+        if(0u == profileOps[op].calls)
+        {
+            continue;
+        }
+        sprintf(print, "\r\n%s: %lu calls, %lu bytes\r\n", profileOps[op].name,
+                (unsigned long)profileOps[op].calls, (unsigned long)profileOps[op].bytes);
+        Cy_SCB_UART_PutString(UART_HW, print);
+        sprintf(print, "  %-14s %14s %14s\r\n", "Monitor", "Per call", "Per byte");
+        Cy_SCB_UART_PutString(UART_HW, print);
+        for(index = 0u; index < CRYPTO_PROFILE_MONITORS; index++)
+        {
+            perCall = (profileOps[op].count[index] * 100u) / profileOps[op].calls;
+            perByte = (0u != profileOps[op].bytes) ? ((profileOps[op].count[index] * 100u) / profileOps[op].bytes) : 0u;
+            sprintf(print, "  %-14s %11lu.%02lu %11lu.%02lu\r\n", (index < CRYPTO_PROFILE_COUNTERS) ?
+                    profileMonitors[index].label : "CM4 cycles",
+                    (unsigned long)(perCall / 100u), (unsigned long)(perCall % 100u),
+                    (unsigned long)(perByte / 100u), (unsigned long)(perByte % 100u));
+            Cy_SCB_UART_PutString(UART_HW, print);
+        }
+    }
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Begin
+***********************************************************************************
+* Summary: Enters the region of op just before a call
+*
+***********************************************************************************/
+static void CryptoProfile_Begin(uint32_t op, profile_region_scope_t *scope)
+{
+    ProfileRegion_Enter(&profileRegions[op], profileOps[op].name, scope);
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_End
+***********************************************************************************
+* Summary: Exits the region of op just after a call and copies its counts
+* and cycles to op
+*
+***********************************************************************************/
+static void CryptoProfile_End(uint32_t op, profile_region_scope_t *scope, uint32_t bytes)
+{
+    const profile_region_t *region = profileRegions[op];
+    uint32_t index;
+
+    ProfileRegion_Exit(scope);
+    profileOps[op].bytes += bytes;
+    if(NULL != region)
+    {
+        profileOps[op].calls = region->calls;
+        for(index = 0u; index < CRYPTO_PROFILE_COUNTERS; index++)
+        {
+            profileOps[op].count[index] = region->events[index];
+        }
+        profileOps[op].count[CRYPTO_PROFILE_MON_CALL] = region->sumCycles;
+    }
+}
+
+/* [] END OF FILE */
@@ -8,8 +8,15 @@
 * and requests the crypto server (cm0p core) to run the cryptographic operation
 *
 * This example prompts the user to enter a message. The message is encrypted 
-* using AES-128 algorithm. The encryption result, key used for the encryption and
-* the decrypted message are displayed on the UART terminal.
+* using AES-128 algorithm in CBC mode with PKCS#7 padding and in CTR mode, so it
+* can have any length up to MAX_MESSAGE_SIZE. The encryption results, key used
+* for the encryption and the decrypted messages are displayed on the UART terminal.
+* Each mode encrypts the whole message with a single request to the crypto server.
+*
+* Every AES call is profiled with the Energy Profiler (see CryptoProfile.c).
+* The crypto accesses and cycles per call and per byte are displayed after
+* each message. At startup a throughput table compares ECB with one request
+* per block against CBC and CTR with one request per buffer.
 *
 * Related Document: CE220465.pdf
 *
@@ -49,6 +56,8 @@
 #include "project.h"
 #include "cy_crypto_config.h"
 #include "CryptoAES.h"
+#include "CryptoProfile.h"
+#include "CryptoAesStream.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -63,13 +72,31 @@
 #define SCREEN_HEADER1 "\r\n__________________________________________________"\
                   "____________________________\r\n" 
 
+/* Received ciphertext is fed to the decryption in pieces of this size to show
+   messages that arrive in parts, e.g. over a serial link */
+#define DECRYPT_PIECE_SIZE  (7u)
+
+/* Largest buffer of the throughput table */
+#define THROUGHPUT_MAX_SIZE (1024u)
+#define THROUGHPUT_SIZES    (4u)
+
 void DisplayMenu(void);
-void PrintData(uint8_t*);
+void PrintData(uint8_t*, uint32_t);
+void RunMode(crypto_aes_stream_mode_t, const char*);
+void PrintThroughput(void);
 
-datablock_t ciphertext;
-char message[MAX_MESSAGE_SIZE+1],Decoded_Message[MAX_MESSAGE_SIZE+1],temp;
+/* Ciphertext holds the padding block of CBC, the decoded message also the
+   end of string character */
+CY_ALIGN(4) uint8_t ciphertext[MAX_MESSAGE_SIZE+CY_CRYPTO_AES_BLOCK_SIZE];
+CY_ALIGN(4) char message[MAX_MESSAGE_SIZE+1];
+CY_ALIGN(4) char Decoded_Message[MAX_MESSAGE_SIZE+CY_CRYPTO_AES_BLOCK_SIZE+1];
+char temp;
 uint32_t message_size;
 
+/* Buffers of the throughput table */
+CY_ALIGN(4) uint8_t throughputIn[THROUGHPUT_MAX_SIZE];
+CY_ALIGN(4) uint8_t throughputOut[THROUGHPUT_MAX_SIZE];
+
 /**********************************************************************************
 * Function Name: int main()
 ***********************************************************************************
@@ -104,59 +131,63 @@ int main(void)
     /* Enable Crypto Hardware */
     Cy_Crypto_Enable();
     Cy_Crypto_Sync(CRYPTO_BLOCKING);
+    
+    /* Assign the profile counters of the crypto calls */
+    CryptoProfile_Init();
         
     DisplayMenu();
 
+    /* Initializes the AES operation by setting key and key length */
+    Cy_Crypto_Aes_Init((uint32_t*)AES_Key,CY_CRYPTO_KEY_AES_128,&cryptoAES);
+    Cy_Crypto_Sync(CRYPTO_BLOCKING);
+
+    /* Show the cost of a request per block against a request per buffer */
+    PrintThroughput();
+
     for(;;)
     {
         message_size=0;
         Cy_SCB_UART_PutString(UART_HW,"\r\n\nEnter the message( not"\
-                                      " more than 16 characters):\r\n\n");
+                                      " more than 128 characters):\r\n\n");
         
         /* Read the user input message till the user press the "ENTER" Key
-        (ASCII value ='0x0D')*/
+        (ASCII value ='0x0D'). Characters beyond the buffer are counted but
+        not stored */
         Cy_SCB_UART_GetArrayBlocking(UART_HW,&temp,1);
         while(temp!=0x0D)
         { 
-            message[message_size]=temp;
+            if(message_size < MAX_MESSAGE_SIZE)
+            {
+                message[message_size]=temp;
+            }
             message_size++;
             UART_GetArrayBlocking(&temp,1);
         }
-        message[message_size]='\0';
         
-        /*Check whether message length exceeds 16 characters*/
+        /*Check whether message length exceeds 128 characters*/
         if(message_size > MAX_MESSAGE_SIZE)
         {
             Cy_SCB_UART_PutString(UART_HW,"\r\n\nMessage size exceeds"\
-            " 16 characters! Please enter a message of not more "\
-            "\r\nthan 16 characters \r\n");
+            " 128 characters! Please enter a message of not more "\
+            "\r\nthan 128 characters \r\n");
         }
         
         else
         {
-            /* Initializes the AES opeeration by setting key and key length */
-            Cy_Crypto_Aes_Init((uint32_t*)AES_Key,CY_CRYPTO_KEY_AES_128,&cryptoAES);
-                
-            /* Wait for Crypto Block to be available */                
-            Cy_Crypto_Sync(CRYPTO_BLOCKING);
-                
-            /* Perform AES ECB Encryption mode of operation */
-            Cy_Crypto_Aes_Ecb_Run(CY_CRYPTO_ENCRYPT,ciphertext.packedtext,\
-                                     (uint32_t*)message,&cryptoAES);
-            Cy_Crypto_Sync(CRYPTO_BLOCKING);
+            message[message_size]='\0';
+            
             Cy_SCB_UART_PutString(UART_HW,"\r\n\nKey used for Encryption:\r\n");
-            PrintData(AES_Key);            
-            Cy_SCB_UART_PutString(UART_HW,"\r\nResult of Encryption:\r\n");
-            PrintData((uint8_t*)ciphertext.text);
+            PrintData(AES_Key,AES128_KEY_LENGTH);
+            Cy_SCB_UART_PutString(UART_HW,"\r\nInitialization vector:\r\n");
+            PrintData(AES_IV,CY_CRYPTO_AES_BLOCK_SIZE);
             
-             /* Perform AES ECB Decryption mode of operation */
-            Cy_Crypto_Aes_Ecb_Run(CY_CRYPTO_DECRYPT,(uint32_t*)Decoded_Message\
-                                     ,ciphertext.packedtext,&cryptoAES);
-            Cy_Crypto_Sync(CRYPTO_BLOCKING);
-            Decoded_Message[message_size]='\0';               
-            /* Print the decrypted message on the UART terminal */
-            Cy_SCB_UART_PutString(UART_HW,"\r\nResult of Decryption:\r\n\n");
-            Cy_SCB_UART_PutString(UART_HW,Decoded_Message);
+            /* Encrypt and decrypt the message in both modes */
+            RunMode(CRYPTO_AES_STREAM_CBC,"CBC");
+            RunMode(CRYPTO_AES_STREAM_CTR,"CTR");
+            
+            /* Print the cost of the AES calls made so far */
+            Cy_SCB_UART_PutString(UART_HW,"\r\n\nProfile of the AES calls:\r\n");
+            CryptoProfile_Print();
             Cy_SCB_UART_PutString(UART_HW,SCREEN_HEADER1);
             
             
@@ -164,6 +195,163 @@ int main(void)
     }
 }
 
+/***********************************************************************************
+* Function Name: RunMode()
+************************************************************************************
+* Summary: Function used to encrypt the message in one piece, print the
+* ciphertext, decrypt it in pieces of DECRYPT_PIECE_SIZE bytes and print the
+* decrypted message
+*
+* Parameters:
+*  crypto_aes_stream_mode_t mode - block cipher mode of operation
+*  const char* name - name of the mode printed with the results
+*
+* Return:
+*  void
+*
+************************************************************************************/
+void RunMode(crypto_aes_stream_mode_t mode, const char* name)
+{
+    crypto_aes_stream_t stream;
+    cy_en_crypto_status_t status;
+    uint32_t cipherSize;
+    uint32_t decodedSize;
+    uint32_t offset;
+    uint32_t piece;
+    uint32_t size;
+    char print[64];
+    
+    /* Perform AES encryption of the whole message */
+    CryptoAesStream_Init(&stream,mode,CY_CRYPTO_ENCRYPT,AES_IV,&cryptoAES);
+    (void) CryptoAesStream_Update(&stream,ciphertext,(uint8_t*)message,\
+                                  message_size,&cipherSize);
+    (void) CryptoAesStream_Final(&stream,&ciphertext[cipherSize],&size);
+    cipherSize += size;
+    sprintf(print,"\r\nResult of %s Encryption (%lu bytes):\r\n",name,\
+            (unsigned long)cipherSize);
+    Cy_SCB_UART_PutString(UART_HW,print);
+    PrintData(ciphertext,cipherSize);
+    
+    /* Perform AES decryption of the ciphertext as it arrives in pieces */
+    CryptoAesStream_Init(&stream,mode,CY_CRYPTO_DECRYPT,AES_IV,&cryptoAES);
+    status = CY_CRYPTO_SUCCESS;
+    decodedSize = 0u;
+    for(offset = 0u; (offset < cipherSize) && (status == CY_CRYPTO_SUCCESS); offset += piece)
+    {
+        piece = cipherSize - offset;
+        if(piece > DECRYPT_PIECE_SIZE)
+        {
+            piece = DECRYPT_PIECE_SIZE;
+        }
+        status = CryptoAesStream_Update(&stream,(uint8_t*)&Decoded_Message[decodedSize],\
+                                        &ciphertext[offset],piece,&size);
+        decodedSize += size;
+    }
+    if(status == CY_CRYPTO_SUCCESS)
+    {
+        status = CryptoAesStream_Final(&stream,(uint8_t*)&Decoded_Message[decodedSize],&size);
+        decodedSize += size;
+    }
+    
+    /* Print the decrypted message on the UART terminal */
+    sprintf(print,"\r\nResult of %s Decryption:\r\n\n",name);
+    Cy_SCB_UART_PutString(UART_HW,print);
+    if(status == CY_CRYPTO_SUCCESS)
+    {
+        Decoded_Message[decodedSize]='\0';
+        Cy_SCB_UART_PutString(UART_HW,Decoded_Message);
+    }
+    else
+    {
+        Cy_SCB_UART_PutString(UART_HW,"Decryption failed, bad padding or length");
+    }
+    Cy_SCB_UART_PutString(UART_HW,"\r\n");
+}
+
+/***********************************************************************************
+* Function Name: PrintThroughput()
+************************************************************************************
+* Summary: Function used to measure and display the encryption throughput of
+* ECB with one request per block and of CBC and CTR with one request per
+* buffer. The cycles are the CM4 cycles of the profiled calls, including the
+* IPC round trip to the crypto server. The profile is cleared afterwards so
+* the message profile starts from zero
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+************************************************************************************/
+void PrintThroughput(void)
+{
+    static const char * const modeName[3] = { "ECB", "CBC", "CTR" };
+    static const uint32_t modeOp[3] = { CRYPTO_PROFILE_AES_ENCRYPT,\
+                                        CRYPTO_PROFILE_CBC_ENCRYPT, CRYPTO_PROFILE_CTR };
+    static const uint32_t sizes[THROUGHPUT_SIZES] = { 16u, 64u, 256u, THROUGHPUT_MAX_SIZE };
+    const crypto_profile_op_t *op;
+    uint32_t iv[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint32_t streamBlock[CRYPTO_AES_STREAM_BLOCK_WORDS];
+    uint32_t offset;
+    uint32_t mode;
+    uint32_t index;
+    uint32_t block;
+    uint64_t cycles;
+    char print[80];
+    
+    for(index = 0u; index < THROUGHPUT_MAX_SIZE; index++)
+    {
+        throughputIn[index] = (uint8_t)index;
+    }
+    
+    Cy_SCB_UART_PutString(UART_HW,"\r\nAES-128 encryption throughput:\r\n"\
+                                  "\r\n  mode   bytes  requests      cycles  cycles/B      KB/s\r\n");
+    for(mode = 0u; mode < 3u; mode++)
+    {
+        for(index = 0u; index < THROUGHPUT_SIZES; index++)
+        {
+            CryptoProfile_Clear();
+            memcpy(iv,AES_IV,CY_CRYPTO_AES_BLOCK_SIZE);
+            offset = 0u;
+            switch(mode)
+            {
+                case 0u:
+                    /* One request per block as the ECB call takes one block */
+                    for(block = 0u; block < sizes[index]; block += CY_CRYPTO_AES_BLOCK_SIZE)
+                    {
+                        (void) CryptoProfile_Aes_Ecb_Run(CY_CRYPTO_ENCRYPT,(uint32_t*)&throughputOut[block],\
+                                                         (uint32_t*)&throughputIn[block],&cryptoAES);
+                    }
+                    break;
+                case 1u:
+                    (void) CryptoProfile_Aes_Cbc_Run(CY_CRYPTO_ENCRYPT,sizes[index],iv,\
+                                                     (uint32_t*)throughputOut,(uint32_t*)throughputIn,&cryptoAES);
+                    break;
+                default:
+                    (void) CryptoProfile_Aes_Ctr_Run(CY_CRYPTO_ENCRYPT,sizes[index],&offset,iv,streamBlock,\
+                                                     (uint32_t*)throughputOut,(uint32_t*)throughputIn,&cryptoAES);
+                    break;
+            }
+            
+            op = CryptoProfile_GetOp(modeOp[mode]);
+            cycles = op->count[CRYPTO_PROFILE_MON_CALL];
+            if(cycles == 0u)
+            {
+                cycles = 1u;
+            }
+            sprintf(print,"  %-4s %7lu %9lu %11lu %9lu %9lu\r\n",modeName[mode],\
+                    (unsigned long)sizes[index],(unsigned long)op->calls,(unsigned long)cycles,\
+                    (unsigned long)(cycles / sizes[index]),\
+                    (unsigned long)(((uint64_t)sizes[index] * cy_Hfclk0FreqHz) / cycles / 1024u));
+            Cy_SCB_UART_PutString(UART_HW,print);
+        }
+    }
+    
+    /* Start the message profile from zero */
+    CryptoProfile_Clear();
+}
+
 /***********************************************************************************
 * Function Name: DisplayMenu()
 ************************************************************************************
@@ -192,25 +380,30 @@ void DisplayMenu()
 * Parameters:
 *  uint8_t*
 *  Pointer to location of data to be printed
+*  uint32_t
+*  Number of bytes to print, 16 bytes are printed per line
 *
 * Return:
 *  void
 *
 ************************************************************************************/
-void PrintData(uint8_t* text)
+void PrintData(uint8_t* text, uint32_t size)
 {
-    datablock_t printdata;
-    
-    memcpy(printdata.text,text,AES128_ENCRYPTION_LENGTH);
     Cy_SCB_UART_PutString(UART_HW,"\r\n");
     char print[10];
-    for(uint32 i=0;i<AES128_ENCRYPTION_LENGTH;i++)
+    for(uint32 i=0;i<size;i++)
     {
-        sprintf(print,"0x%2X ",printdata.text[i]);
+        sprintf(print,"0x%02X ",text[i]);
         Cy_SCB_UART_PutString(UART_HW,print);   
-        
+        if(((i+1u) % AES128_ENCRYPTION_LENGTH) == 0u)
+        {
+            Cy_SCB_UART_PutString(UART_HW,"\r\n");
+        }
+    }
+    if((size % AES128_ENCRYPTION_LENGTH) != 0u)
+    {
+        Cy_SCB_UART_PutString(UART_HW,"\r\n");
     }
-    Cy_SCB_UART_PutString(UART_HW,"\r\n");
     
 }
 
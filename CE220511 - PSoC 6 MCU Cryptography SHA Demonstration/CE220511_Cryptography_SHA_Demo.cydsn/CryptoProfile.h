@@ -0,0 +1,76 @@
+/*****************************************************************************
+* File Name: CryptoProfile.h
+* 
+* Version 1.10
+*
+* Description: This file contains the definitions of the profiled
+* variant of the SHA call used in main_cm4.c. Every call is measured with the
+* Energy Profiler and ProfileRegion, see CryptoProfile.c, and the counts are
+* accumulated, to report the cost of a hash per call and per message byte.
+*
+* Related Document: CE220511.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+* 
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (Software), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (Cypress) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (EULA).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypresss integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (High Risk Product). By 
+* including Cypresss product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+#ifndef CRYPTOPROFILE_H
+#define CRYPTOPROFILE_H
+
+#include "project.h"
+
+/* Monitors counted during every call: the profile counters, then the cycles */
+#define CRYPTO_PROFILE_MONITORS     (3u)
+#define CRYPTO_PROFILE_COUNTERS     (2u)
+
+/* Profiled operations */
+#define CRYPTO_PROFILE_SHA          (0u)
+#define CRYPTO_PROFILE_OPS          (1u)
+
+/* Accumulated counts of one operation */
+typedef struct
+{
+    const char *name;
+    uint32_t calls;
+    uint64_t bytes;
+    uint64_t count[CRYPTO_PROFILE_MONITORS];
+} crypto_profile_op_t;
+
+void CryptoProfile_Init(void);
+cy_en_crypto_status_t CryptoProfile_Sha_Run(uint32_t *message, uint32_t messageSize, uint32_t *digest,
+                                            cy_en_crypto_sha_mode_t mode, cy_stc_crypto_context_sha_t *cfContext);
+const crypto_profile_op_t * CryptoProfile_GetOp(uint32_t op);
+void CryptoProfile_Print(void);
+
+#endif /* CRYPTOPROFILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,185 @@
+/*****************************************************************************
+* File Name: ProfileCycles.c
+*
+* Version 1.10
+*
+* Description: CPU cycle counter of the profile sessions, DWT CYCCNT
+* on the CM4 and SysTick on the CM0+.
+*
+* Related Document: CE220511.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+* 
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (Software), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (Cypress) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (EULA).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypresss integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (High Risk Product). By 
+* including Cypresss product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ProfileCycles.h"
+
+#define PROFILE_CYCLES_SYSTICK_RANGE    (SysTick_LOAD_RELOAD_Msk + 1uL)
+
+static uint32_t cyclesOverhead;
+#if (!CY_CPU_CORTEX_M4)
+    static volatile uint32_t cyclesHigh;    /* SysTick wraps counted in software */
+    static void ProfileCycles_SysTick(void);
+#endif /* (!CY_CPU_CORTEX_M4) */
+
+/**
+********************************************************************************
+* Function Name: ProfileCycles_Init
+********************************************************************************
+*
+*  Starts the cycle counter of the core
+*  Calibrates the overhead as the smallest difference of two reads in a row
+*******************************************************************************/
+void ProfileCycles_Init(void)
+{
+    uint32_t index;
+    uint32_t start;
+    uint32_t cycles;
+
+#if (CY_CPU_CORTEX_M4)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#else
+    /* The whole 24-bit range, clocked with the CPU clock, every wrap interrupts */
+    cyclesHigh = 0u;
+    (void) Cy_SysInt_SetVector(SysTick_IRQn, &ProfileCycles_SysTick);
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif /* (CY_CPU_CORTEX_M4) */
+
+    cyclesOverhead = UINT32_MAX;
+    for (index = 0u; index < PROFILE_CYCLES_CALIBRATION; index++)
+    {
+        start = ProfileCycles_Read();
+        cycles = ProfileCycles_Read() - start;
+        if (cycles < cyclesOverhead)
+        {
+            cyclesOverhead = cycles;
+        }
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileCycles_Read
+********************************************************************************
+*
+*  Returns the cycle count, it wraps at 2^32
+*******************************************************************************/
+uint32_t ProfileCycles_Read(void)
+{
+#if (CY_CPU_CORTEX_M4)
+    return DWT->CYCCNT;
+#else
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+    uint32_t value = SysTick->VAL;
+
+    /* COUNTFLAG is set by a wrap and cleared by this read: a wrap whose
+    * interrupt is held off by the critical section is counted here, and
+    * ProfileCycles_SysTick then finds the flag clear
+    */
+    if (0u != (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk))
+    {
+        cyclesHigh += PROFILE_CYCLES_SYSTICK_RANGE;
+        value = SysTick->VAL;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    /* SysTick counts down */
+    return cyclesHigh + (SysTick_LOAD_RELOAD_Msk - value);
+#endif /* (CY_CPU_CORTEX_M4) */
+}
+
+#if (!CY_CPU_CORTEX_M4)
+/**
+********************************************************************************
+* Function Name: ProfileCycles_SysTick
+********************************************************************************
+*
+*  SysTick interrupt, counts the wrap unless ProfileCycles_Read() did
+*******************************************************************************/
+static void ProfileCycles_SysTick(void)
+{
+    if (0u != (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk))
+    {
+        cyclesHigh += PROFILE_CYCLES_SYSTICK_RANGE;
+    }
+}
+#endif /* (!CY_CPU_CORTEX_M4) */
+
+/**
+********************************************************************************
+* Function Name: ProfileCycles_Elapsed
+********************************************************************************
+*
+*  Returns the cycles since start, a value of ProfileCycles_Read()
+*  The calibrated overhead of the two reads is removed
+*******************************************************************************/
+uint32_t ProfileCycles_Elapsed(uint32_t start)
+{
+    uint32_t cycles = ProfileCycles_Read() - start;
+
+    return (cycles > cyclesOverhead) ? (cycles - cyclesOverhead) : 0u;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileCycles_GetOverhead
+********************************************************************************
+*
+*  Returns the calibrated cycles of one measurement
+*******************************************************************************/
+uint32_t ProfileCycles_GetOverhead(void)
+{
+    return cyclesOverhead;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileCycles_GetSource
+********************************************************************************
+*
+*  Returns the name of the counter used for printing
+*******************************************************************************/
+const char * ProfileCycles_GetSource(void)
+{
+#if (CY_CPU_CORTEX_M4)
+    return "DWT CYCCNT";
+#else
+    return "SysTick";
+#endif /* (CY_CPU_CORTEX_M4) */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,247 @@
+/*****************************************************************************
+* File Name: ProfileRegion.c
+*
+* Version 1.10
+*
+* Description: Scoped profiling of named code regions. A region gets
+* its table entry the first time it is entered; when the table is full the
+* region is not measured. Cycles come from ProfileCycles (DWT CYCCNT on the
+* CM4, SysTick on the CM0+), call ProfileCycles_Init() first. The
+* calibrated overhead of the measurement is removed from every region.
+*
+* Related Document: CE220511.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer Kit
+* 
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (Software), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (Cypress) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (EULA).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypresss integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (High Risk Product). By 
+* including Cypresss product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "ProfileRegion.h"
+#include "ProfileCycles.h"
+
+static profile_region_t regionTable[PROFILE_REGION_MAX];
+static uint32_t regionCount;
+static profile_region_scope_t *regionCurrent;
+static cy_stc_profile_ctr_ptr_t regionCounters[PROFILE_REGION_COUNTERS];
+static uint32_t regionCounterCount;
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_Init
+********************************************************************************
+*
+*  Empties the region table
+*******************************************************************************/
+void ProfileRegion_Init(void)
+{
+    regionCount = 0u;
+    regionCurrent = NULL;
+    regionCounterCount = 0u;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_SetCounters
+********************************************************************************
+*
+*  Selects the profile counters whose deltas are added to the regions
+*  events[i] of every region belongs to counters[i]
+*  Call it outside of any region
+*******************************************************************************/
+void ProfileRegion_SetCounters(const cy_stc_profile_ctr_ptr_t counters[], uint32_t count)
+{
+    uint32_t index;
+
+    regionCounterCount = (count < PROFILE_REGION_COUNTERS) ? count : PROFILE_REGION_COUNTERS;
+    for (index = 0u; index < regionCounterCount; index++)
+    {
+        regionCounters[index] = counters[index];
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_Enter
+********************************************************************************
+*
+*  Starts a region, used by PROFILE_REGION_BEGIN and PROFILE_SCOPE
+*  *region is the static table pointer of the call site, NULL until the
+*  first call
+*******************************************************************************/
+void ProfileRegion_Enter(profile_region_t **region, const char *name, profile_region_scope_t *scope)
+{
+    uint32_t index;
+
+    if ((NULL == *region) && (regionCount < PROFILE_REGION_MAX))
+    {
+        *region = &regionTable[regionCount++];
+        (*region)->name = name;
+        (*region)->calls = 0u;
+        (*region)->minCycles = UINT32_MAX;
+        (*region)->maxCycles = 0u;
+        (*region)->sumCycles = 0u;
+        (*region)->selfCycles = 0u;
+        for (index = 0u; index < PROFILE_REGION_COUNTERS; index++)
+        {
+            (*region)->events[index] = 0u;
+        }
+    }
+
+    scope->region = *region;
+    scope->parent = regionCurrent;
+    scope->childCycles = 0u;
+    regionCurrent = scope;
+
+    for (index = 0u; index < regionCounterCount; index++)
+    {
+        scope->startCount[index] = regionCounters[index]->cntAddr->CNT;
+    }
+    scope->startCycles = ProfileCycles_Read();
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_Exit
+********************************************************************************
+*
+*  Ends a region and adds its cycles and count deltas to its table entry
+*  The cycles of the region are also added to the enclosing region as
+*  nested cycles
+*******************************************************************************/
+void ProfileRegion_Exit(profile_region_scope_t *scope)
+{
+    uint32_t cycles = ProfileCycles_Elapsed(scope->startCycles);
+    profile_region_t *region = scope->region;
+    uint32_t index;
+
+    regionCurrent = scope->parent;
+    if (NULL != scope->parent)
+    {
+        scope->parent->childCycles += cycles;
+    }
+    if (NULL == region)
+    {
+        return;
+    }
+
+    for (index = 0u; index < regionCounterCount; index++)
+    {
+        region->events[index] += regionCounters[index]->cntAddr->CNT - scope->startCount[index];
+    }
+    region->calls++;
+    region->sumCycles += cycles;
+    region->selfCycles += cycles - scope->childCycles;
+    if (cycles < region->minCycles)
+    {
+        region->minCycles = cycles;
+    }
+    if (cycles > region->maxCycles)
+    {
+        region->maxCycles = cycles;
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_GetTable
+********************************************************************************
+*
+*  Returns the region table and the number of regions in count
+*******************************************************************************/
+const profile_region_t * ProfileRegion_GetTable(uint32_t *count)
+{
+    *count = regionCount;
+    return regionTable;
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_Reset
+********************************************************************************
+*
+*  Clears the figures of all regions, the regions keep their entries
+*******************************************************************************/
+void ProfileRegion_Reset(void)
+{
+    uint32_t region;
+    uint32_t index;
+
+    for (region = 0u; region < regionCount; region++)
+    {
+        regionTable[region].calls = 0u;
+        regionTable[region].minCycles = UINT32_MAX;
+        regionTable[region].maxCycles = 0u;
+        regionTable[region].sumCycles = 0u;
+        regionTable[region].selfCycles = 0u;
+        for (index = 0u; index < PROFILE_REGION_COUNTERS; index++)
+        {
+            regionTable[region].events[index] = 0u;
+        }
+    }
+}
+
+/**
+********************************************************************************
+* Function Name: ProfileRegion_Print
+********************************************************************************
+*
+*  Prints the region table on stdout, one line per region
+*******************************************************************************/
+void ProfileRegion_Print(void)
+{
+    uint32_t region;
+    uint32_t index;
+    const profile_region_t *entry;
+
+    printf ("    %-16s %6s %10s %10s %12s %12s", "Region", "Calls", "Min", "Max", "Sum", "Self");
+    for (index = 0u; index < regionCounterCount; index++)
+    {
+        printf (" %9s%lu", "Counter", index);
+    }
+    printf ("\n\r");
+
+    for (region = 0u; region < regionCount; region++)
+    {
+        entry = &regionTable[region];
+        printf ("    %-16s %6lu %10lu %10lu %12lu %12lu", entry->name, entry->calls,
+                (0u != entry->calls) ? entry->minCycles : 0u, entry->maxCycles,
+                (uint32_t)entry->sumCycles, (uint32_t)entry->selfCycles);
+        for (index = 0u; index < regionCounterCount; index++)
+        {
+            printf (" %10lu", (uint32_t)entry->events[index]);
+        }
+        printf ("\n\r");
+    }
+}
+
+/* [] END OF FILE */
@@ -9,6 +9,8 @@
 * cryptographic operation
 * This example prompts the user to enter a message. The message digest is generated 
 * using SHA-1 algorithm. The message digest is displayed on the UART terminal.
+* Every hash is profiled with the Energy Profiler (see CryptoProfile.c), the
+* crypto accesses and cycles per call and per byte are displayed after it.
 *
 * Related Document: CE220511.pdf
 *
@@ -48,6 +50,7 @@
 #include "project.h"
 #include "cy_crypto_config.h"
 #include "CryptoSHA.h"
+#include "CryptoProfile.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -102,6 +105,9 @@ int main(void)
     Cy_Crypto_Enable();
     Cy_Crypto_Sync(CRYPTO_BLOCKING);
     
+    /* Assign the profile counters of the crypto calls */
+    CryptoProfile_Init();
+    
     char message[MAX_MESSAGE_SIZE],temp;
     uint32_t messagesize;
     
@@ -134,10 +140,11 @@ int main(void)
             memcpy(data.text,message,messagesize);
         
             /* Perform SHA Hash function*/
-            Cy_Crypto_Sha_Run(data.packedtext,messagesize,hash.packedtext,\
+            CryptoProfile_Sha_Run(data.packedtext,messagesize,hash.packedtext,\
                           CY_CRYPTO_MODE_SHA256,&contextSHA);
         
-            Cy_Crypto_Sync(CRYPTO_BLOCKING);
+            Cy_SCB_UART_PutString(UART_HW,"\r\n\nProfile of the SHA calls:\r\n");
+            CryptoProfile_Print();
             Cy_SCB_UART_PutString(UART_HW,"\r\n\nHash Value for the message:\r\n\n");
             PrintData();
         }
@@ -0,0 +1,248 @@
+/*********************************************************************************
+* File Name: CryptoProfile.c
+*
+* Version: 1.00
+*
+* Description: This file contains the profiled variant of the TRNG
+* call. The client on the CM4 sends every request to the crypto server on the
+* CM0+ through the IPC, so a call is measured up to the end of
+* Cy_Crypto_Sync(). Every operation is a region of ProfileRegion, which
+* attributes to it:
+*   Crypto access - bus reads and writes of the crypto block
+*   CM4 active    - HF cycles of the CM4, including the wait for the server
+*   CM4 cycles    - CPU cycles of the whole call, IPC round trip included
+* The profiler runs from CryptoProfile_Init() on, the regions take the
+* count deltas of the two profile counters.
+* A password character needs one call, so the cost per call is the figure to
+* compare with one call of a software generator seeded once from the TRNG.
+*
+* Related Document: 
+*           CE221295_PSoC_6_MCU_Cryptography_True_Random_Number_Generation.pdf
+*
+* Hardware Dependency: 
+*           See CE221295_PSoC_6_MCU_Cryptography_True_Random_Number_Generation.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+#include "CryptoProfile.h"
+#include "ProfileRegion.h"
+#include "ProfileCycles.h"
+#include <stdio.h>
+
+#define CRYPTO_PROFILE_BLOCKING     CY_CRYPTO_SYNC_BLOCKING
+
+/* Monitor configuration of the profile counters */
+typedef struct
+{
+    const char *label;
+    en_ep_mon_sel_t monitor;
+    cy_en_profile_duration_t duration;
+} crypto_profile_monitor_t;
+
+static const crypto_profile_monitor_t profileMonitors[CRYPTO_PROFILE_COUNTERS] =
+{
+    { "Crypto access", CPUSS_MONITOR_CRYPTO, CY_PROFILE_EVENT },
+    { "CM4 active",    CPUSS_MONITOR_CM4,    CY_PROFILE_DURATION }
+};
+
+static cy_stc_profile_ctr_ptr_t profileCounters[CRYPTO_PROFILE_COUNTERS];
+
+/* Region of every operation, in the order of profileOps */
+static profile_region_t *profileRegions[CRYPTO_PROFILE_OPS];
+
+static crypto_profile_op_t profileOps[CRYPTO_PROFILE_OPS] =
+{
+    { "TRNG generate", 0u, 0u, { 0u } }
+};
+
+static void CryptoProfile_Begin(uint32_t op, profile_region_scope_t *scope);
+static void CryptoProfile_End(uint32_t op, profile_region_scope_t *scope, uint32_t bytes);
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Init
+***********************************************************************************
+* Summary: Initializes the Energy Profiler, assigns one counter to every
+* monitor of profileMonitors and attributes the counters to the regions.
+* The profiler runs from now on
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+***********************************************************************************/
+void CryptoProfile_Init(void)
+{
+    uint32_t index;
+
+    Cy_Profile_Init();
+    Cy_Profile_ClearConfiguration();
+    for(index = 0u; index < CRYPTO_PROFILE_COUNTERS; index++)
+    {
+        profileCounters[index] = Cy_Profile_ConfigureCounter(profileMonitors[index].monitor,
+                                     profileMonitors[index].duration, CY_PROFILE_CLK_HF, 1u);
+        (void)Cy_Profile_EnableCounter(profileCounters[index]);
+    }
+    ProfileCycles_Init();
+    ProfileRegion_Init();
+    ProfileRegion_SetCounters(profileCounters, CRYPTO_PROFILE_COUNTERS);
+    Cy_Profile_ClearCounters();
+    Cy_Profile_StartProfiling();
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Trng_Generate
+***********************************************************************************
+* Summary: Profiled variant of Cy_Crypto_Trng_Generate. Generates the number,
+* waits for the crypto server and adds the counts to the operation. A number
+* of max bits counts as (max + 7) / 8 bytes
+*
+* Parameters:
+*  Same as Cy_Crypto_Trng_Generate
+*
+* Return:
+*  cy_en_crypto_status_t - status of the operation
+*
+***********************************************************************************/
+cy_en_crypto_status_t CryptoProfile_Trng_Generate(uint32_t GAROPol, uint32_t FIROPol, uint32_t max,
+                                                  uint32_t *randomNum, cy_stc_crypto_context_trng_t *cfContext)
+{
+    uint32_t op = CRYPTO_PROFILE_TRNG;
+    profile_region_scope_t scope;
+    cy_en_crypto_status_t status;
+
+    CryptoProfile_Begin(op, &scope);
+    status = Cy_Crypto_Trng_Generate(GAROPol, FIROPol, max, randomNum, cfContext);
+    if(CY_CRYPTO_SUCCESS == status)
+    {
+        status = Cy_Crypto_Sync(CRYPTO_PROFILE_BLOCKING);
+    }
+    CryptoProfile_End(op, &scope, (max + 7u) / 8u);
+    return status;
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_GetOp
+***********************************************************************************
+* Summary: Returns the accumulated counts of an operation
+*
+* Parameters:
+*  uint32_t op - CRYPTO_PROFILE_TRNG
+*
+* Return:
+*  const crypto_profile_op_t* - counts of the operation, NULL if unknown
+*
+***********************************************************************************/
+const crypto_profile_op_t * CryptoProfile_GetOp(uint32_t op)
+{
+    return (op < CRYPTO_PROFILE_OPS) ? &profileOps[op] : NULL;
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Print
+***********************************************************************************
+* Summary: Displays the counts of every operation called so far per call and
+* per byte, with two decimals
+*
+* Parameters:
+*  None
+*
+* Return:
+*  void
+*
+***********************************************************************************/
+void CryptoProfile_Print(void)
+{
+    uint32_t op;
+    uint32_t index;
+    uint64_t perCall;
+    uint64_t perByte;
+
+    for(op = 0u; op < CRYPTO_PROFILE_OPS; op++)
+    {
+        if(0u == profileOps[op].calls)
+        {
+            continue;
+        }
+        printf("\r\n%s: %lu calls, %lu bytes\r\n", profileOps[op].name,
+               (unsigned long)profileOps[op].calls, (unsigned long)profileOps[op].bytes);
+        printf("  %-14s %14s %14s\r\n", "Monitor", "Per call", "Per byte");
+        for(index = 0u; index < CRYPTO_PROFILE_MONITORS; index++)
+        {
+            perCall = (profileOps[op].count[index] * 100u) / profileOps[op].calls;
+            perByte = (0u != profileOps[op].bytes) ? ((profileOps[op].count[index] * 100u) / profileOps[op].bytes) : 0u;
+            printf("  %-14s %11lu.%02lu %11lu.%02lu\r\n", (index < CRYPTO_PROFILE_COUNTERS) ?
+                    profileMonitors[index].label : "CM4 cycles",
+                   (unsigned long)(perCall / 100u), (unsigned long)(perCall % 100u),
+                   (unsigned long)(perByte / 100u), (unsigned long)(perByte % 100u));
+        }
+    }
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_Begin
+***********************************************************************************
+* Summary: Enters the region of op just before a call
+*
+***********************************************************************************/
+static void CryptoProfile_Begin(uint32_t op, profile_region_scope_t *scope)
+{
+    ProfileRegion_Enter(&profileRegions[op], profileOps[op].name, scope);
+}
+
+/**********************************************************************************
+* Function Name: CryptoProfile_End
+***********************************************************************************
+* Summary: Exits the region of op just after a call and copies its counts
+* and cycles to op
+*
+***********************************************************************************/
+static void CryptoProfile_End(uint32_t op, profile_region_scope_t *scope, uint32_t bytes)
+{
+    const profile_region_t *region = profileRegions[op];
+    uint32_t index;
+
+    ProfileRegion_Exit(scope);
+    profileOps[op].bytes += bytes;
+    if(NULL != region)
+    {
+        profileOps[op].calls = region->calls;
+        for(index = 0u; index < CRYPTO_PROFILE_COUNTERS; index++)
+        {
+            profileOps[op].count[index] = region->events[index];
+        }
+        profileOps[op].count[CRYPTO_PROFILE_COUNTERS] = region->sumCycles;
+    }
+}
+
+/* [] END OF FILE */
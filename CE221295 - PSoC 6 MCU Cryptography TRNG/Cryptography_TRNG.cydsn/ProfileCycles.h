@@ -0,0 +1,68 @@
+/*********************************************************************************
+* File Name: ProfileCycles.h
+*
+* Version: 1.00
+*
+* Description: Definitions of the CPU cycle counter of the profile
+* sessions. The CM4 reads the DWT cycle counter (CYCCNT). The CM0+ has no
+* DWT cycle counter and uses SysTick, free running from the CPU clock; its
+* 24-bit count is extended by the SysTick interrupt, which ProfileCycles_Init()
+* installs, so interrupts must not stay masked for 2^24 cycles or more.
+* ProfileCycles_Init() also measures the cost of one measurement, which
+* ProfileCycles_Elapsed() removes.
+*
+* Related Document: 
+*           CE221295_PSoC_6_MCU_Cryptography_True_Random_Number_Generation.pdf
+*
+* Hardware Dependency: 
+*           See CE221295_PSoC_6_MCU_Cryptography_True_Random_Number_Generation.pdf
+*
+*******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* (“Software”), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries (“Cypress”) and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software (“EULA”).
+*
+* If no EULA applies, Cypress hereby grants you a personal, nonexclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress’s integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress 
+* reserves the right to make changes to the Software without notice. Cypress 
+* does not assume any liability arising out of the application or use of the 
+* Software or any product or circuit described in the Software. Cypress does 
+* not authorize its products for use in any products where a malfunction or 
+* failure of the Cypress product may reasonably be expected to result in 
+* significant property damage, injury or death (“High Risk Product”). By 
+* including Cypress’s product in a High Risk Product, the manufacturer of such 
+* system or application assumes all risk of such use and in doing so agrees to 
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILECYCLES_H
+#define PROFILECYCLES_H
+
+#include <project.h>
+
+/* Back-to-back reads used to calibrate the overhead */
+#define PROFILE_CYCLES_CALIBRATION  (16u)
+
+void ProfileCycles_Init(void);
+uint32_t ProfileCycles_Read(void);
+uint32_t ProfileCycles_Elapsed(uint32_t start);
+uint32_t ProfileCycles_GetOverhead(void);
+const char * ProfileCycles_GetSource(void);
+
+#endif /* PROFILECYCLES_H */
+
+/* [] END OF FILE */
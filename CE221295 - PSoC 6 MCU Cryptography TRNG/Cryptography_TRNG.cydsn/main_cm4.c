@@ -14,6 +14,8 @@
 * The generated random number is such that it corresponds to alpha-numeric 
 * and special characters of the ASCII code. The generated OTP is then displayed
 * on a UART terminal emulator.
+* Every random number is profiled with the Energy Profiler (see CryptoProfile.c),
+* the crypto accesses and cycles per call and per byte are displayed with the OTP.
 *
 * Related Document: 
 *           CE221295_PSoC_6_MCU_Cryptography_True_Random_Number_Generation.pdf
@@ -55,6 +57,7 @@
 #include "project.h"
 #include "stdio_user.h"
 #include "cy_crypto_config.h"
+#include "CryptoProfile.h"
 #include <stdio.h>
 
 /* Macros for the polynomial to configure the programmable Galois and Fibonacci
@@ -107,6 +110,9 @@ int main(void)
     Cy_Crypto_Enable();
     Cy_Crypto_Sync(CY_CRYPTO_SYNC_BLOCKING);
     
+    /* Assign the profile counters of the crypto calls */
+    CryptoProfile_Init();
+    
     /* ANSI ESC sequence for clear screen */
     printf("\x1b[2J\x1b[;H");
     printf(SCREEN_HEADER);
@@ -121,6 +127,9 @@ int main(void)
         
         /* Display the generated password on the UART Terminal */
         printf("One-Time Password: %s\r\n",TRNGData);
+        
+        /* Display the cost of the TRNG calls made so far */
+        CryptoProfile_Print();
         printf(SCREEN_HEADER1);
         
     }
@@ -146,12 +155,10 @@ void GeneratePassword(int32_t size, uint8_t* buffer)
        
     for(index = 0; index < (size-1); index++)
     {
-        /* Generate a random number */
-        Cy_Crypto_Trng_Generate(CRYPTO_TRNG_GARO_POL, CRYPTO_TRNG_FIRO_POL,\
+        /* Generate a random number, the profiled call waits until crypto
+           completes operation */
+        CryptoProfile_Trng_Generate(CRYPTO_TRNG_GARO_POL, CRYPTO_TRNG_FIRO_POL,\
                                 MAX_TRND_VAL, &temp, &TRNGContext);
-           
-        /* Wait until crypto completes operation */
-        Cy_Crypto_Sync(CY_CRYPTO_SYNC_BLOCKING);
         
         /* Check if the generated random number is in the range of alpha-numeric, 
         special characters ASCII codes. If not, convert to that range */